@@ -4,7 +4,9 @@
 #include "MessageLogModule.h"
 #endif
 
+#include "Misc/CoreDelegates.h"
 #include "Utility/AlsLog.h"
+#include "Utility/AlsTrace.h"
 
 IMPLEMENT_MODULE(FALSModule, ALS)
 
@@ -24,10 +26,16 @@ void FALSModule::StartupModule()
 
 	MessageLog.RegisterLogListing(AlsLog::MessageLogName, LOCTEXT("MessageLogLabel", "ALS"), Options);
 #endif
+
+#if ALS_TRACE_ENABLED
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&AlsTrace::PublishCounters);
+#endif
 }
 
 void FALSModule::ShutdownModule()
 {
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
 	FDefaultModuleImpl::ShutdownModule();
 }
 
@@ -4,6 +4,9 @@
 
 class ALS_API FALSModule : public FDefaultModuleImpl
 {
+private:
+	FDelegateHandle EndFrameHandle;
+
 public:
 	virtual void StartupModule() override;
 
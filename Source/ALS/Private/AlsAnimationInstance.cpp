@@ -7,8 +7,12 @@
 #include "Curves/CurveFloat.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Settings/AlsAnimationInstanceSettings.h"
+#include "Utility/AlsBenchmark.h"
 #include "Utility/AlsConstants.h"
+#include "Utility/AlsCsvProfiler.h"
 #include "Utility/AlsMacros.h"
+#include "Utility/AlsProfiling.h"
+#include "Utility/AlsTrace.h"
 #include "Utility/AlsUtility.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimationInstance)
@@ -46,14 +50,21 @@ void UAlsAnimationInstance::NativeUpdateAnimation(const float DeltaTime)
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsAnimationInstance::NativeUpdateAnimation()"),
 	                            STAT_UAlsAnimationInstance_NativeUpdateAnimation, STATGROUP_Als)
+	ALS_BENCHMARK_SCOPE(NativeUpdateAnimation)
 
 	Super::NativeUpdateAnimation(DeltaTime);
 
+	// The previous frame is complete, since the linked animation layers have already been updated.
+
+	RecordingFrame = nullptr;
+
 	if (!IsValid(Settings) || !IsValid(Character))
 	{
 		return;
 	}
 
+	ALS_COST_SCOPE(Character->GetCostTracker(), AnimationUpdate)
+
 	// AAlsCharacter::FinalizeRagdolling() should only be called from here, not from AAlsCharacter::StopRagdollingImplementation(),
 	// otherwise the character mesh can sometimes take a strange pose when transitioning from ragdoll states to animation states.
 
@@ -110,6 +121,7 @@ void UAlsAnimationInstance::NativeThreadSafeUpdateAnimation(const float DeltaTim
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsAnimationInstance::NativeThreadSafeUpdateAnimation()"),
 	                            STAT_UAlsAnimationInstance_NativeThreadSafeUpdateAnimation, STATGROUP_Als)
+	ALS_BENCHMARK_SCOPE(NativeThreadSafeUpdateAnimation)
 
 	Super::NativeThreadSafeUpdateAnimation(DeltaTime);
 
@@ -118,6 +130,13 @@ void UAlsAnimationInstance::NativeThreadSafeUpdateAnimation(const float DeltaTim
 		return;
 	}
 
+	ALS_COST_SCOPE(Character->GetCostTracker(), AnimationThreadSafeUpdate)
+
+	if (Recording.IsValid())
+	{
+		BeginRecordingFrame(DeltaTime);
+	}
+
 	RefreshLayering();
 	RefreshPose();
 
@@ -130,6 +149,11 @@ void UAlsAnimationInstance::NativeThreadSafeUpdateAnimation(const float DeltaTim
 	RefreshTransitions();
 	RefreshRotateInPlace(DeltaTime);
 	RefreshTurnInPlace(DeltaTime);
+
+	if (RecordingFrame != nullptr)
+	{
+		EndRecordingFrame();
+	}
 }
 
 void UAlsAnimationInstance::NativePostEvaluateAnimation()
@@ -162,6 +186,28 @@ void UAlsAnimationInstance::NativePostEvaluateAnimation()
 	bPendingUpdate = false;
 }
 
+void UAlsAnimationInstance::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	// The proxy and the recording are not visible to serialization, so they are counted here.
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(sizeof(FAlsAnimationInstanceProxy));
+
+	if (Recording.IsValid())
+	{
+		auto RecordingBytes{sizeof(FAlsAnimationInstanceRecording) + Recording->Frames.GetAllocatedSize()};
+
+		for (const auto& Frame : Recording->Frames)
+		{
+			RecordingBytes += Frame.Curves.GetAllocatedSize() + Frame.SceneQueryHits.GetAllocatedSize() +
+				Frame.InputState.GetAllocatedSize() + Frame.OutputState.GetAllocatedSize();
+		}
+
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(RecordingBytes);
+	}
+}
+
 FAnimInstanceProxy* UAlsAnimationInstance::CreateAnimInstanceProxy()
 {
 	return new FAlsAnimationInstanceProxy{this};
@@ -187,6 +233,8 @@ FAlsControlRigInput UAlsAnimationInstance::GetControlRigInput() const
 
 void UAlsAnimationInstance::RefreshMovementBaseOnGameThread()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshMovementBaseOnGameThread")
+
 	const auto& BasedMovement{Character->GetBasedMovement()};
 
 	if (BasedMovement.MovementBase != MovementBase.Primitive || BasedMovement.BoneName != MovementBase.BoneName)
@@ -215,6 +263,9 @@ void UAlsAnimationInstance::RefreshMovementBaseOnGameThread()
 
 void UAlsAnimationInstance::RefreshLayering()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshLayering")
+	ALS_COST_SCOPE(Character->GetCostTracker(), Layering)
+
 	const auto& Curves{GetProxyOnAnyThread<FAlsAnimationInstanceProxy>().GetAnimationCurves(EAnimCurveType::AttributeCurve)};
 
 	static const auto GetCurveValue{
@@ -262,6 +313,9 @@ void UAlsAnimationInstance::RefreshLayering()
 
 void UAlsAnimationInstance::RefreshPose()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshPose")
+	ALS_COST_SCOPE(Character->GetCostTracker(), Pose)
+
 	const auto& Curves{GetProxyOnAnyThread<FAlsAnimationInstanceProxy>().GetAnimationCurves(EAnimCurveType::AttributeCurve)};
 
 	static const auto GetCurveValue{
@@ -300,6 +354,8 @@ void UAlsAnimationInstance::RefreshPose()
 
 void UAlsAnimationInstance::RefreshViewOnGameThread()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshViewOnGameThread")
+
 	check(IsInGameThread())
 
 	const auto& View{Character->GetViewState()};
@@ -315,6 +371,9 @@ bool UAlsAnimationInstance::IsSpineRotationAllowed()
 
 void UAlsAnimationInstance::RefreshView(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshView")
+	ALS_COST_SCOPE(Character->GetCostTracker(), View)
+
 	if (!LocomotionAction.IsValid())
 	{
 		ViewState.YawAngle = FRotator3f::NormalizeAxis(UE_REAL_TO_FLOAT(ViewState.Rotation.Yaw - LocomotionState.Rotation.Yaw));
@@ -335,6 +394,8 @@ void UAlsAnimationInstance::RefreshView(const float DeltaTime)
 
 void UAlsAnimationInstance::RefreshSpineRotation(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshSpineRotation")
+
 	auto& SpineRotation{ViewState.SpineRotation};
 
 	if (SpineRotation.bSpineRotationAllowed != IsSpineRotationAllowed())
@@ -376,6 +437,7 @@ void UAlsAnimationInstance::ReinitializeLook()
 void UAlsAnimationInstance::RefreshLook()
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsAnimationInstance::RefreshLook()"), STAT_UAlsAnimationInstance_RefreshLook, STATGROUP_Als)
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshLook")
 
 	if (!IsValid(Settings))
 	{
@@ -440,7 +502,7 @@ void UAlsAnimationInstance::RefreshLook()
 			DeltaYawAngle = LocomotionState.YawSpeed > 0.0f ? FMath::Abs(DeltaYawAngle) : -FMath::Abs(DeltaYawAngle);
 		}
 
-		const auto InterpolationAmount{UAlsMath::ExponentialDecay(GetDeltaSeconds(), InterpolationSpeed)};
+		const auto InterpolationAmount{UAlsMath::ExponentialDecay(GetDeltaTimeSeconds(), InterpolationSpeed)};
 
 		Look.YawAngle = FRotator3f::NormalizeAxis(YawAngle + DeltaYawAngle * InterpolationAmount);
 		Look.PitchAngle = UAlsMath::LerpAngle(Look.PitchAngle, TargetPitchAngle, InterpolationAmount);
@@ -457,10 +519,20 @@ void UAlsAnimationInstance::RefreshLook()
 	Look.YawRightAmount = 0.5f + FMath::Abs(Look.YawForwardAmount - 0.5f);
 
 	Look.bReinitializationRequired = false;
+
+	if (RecordingFrame != nullptr)
+	{
+		// Called by the linked animation layers after the thread safe update, so the output state must be saved again.
+
+		RecordingFrame->LookRefreshesCount += 1;
+		EndRecordingFrame();
+	}
 }
 
 void UAlsAnimationInstance::RefreshLocomotionOnGameThread()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshLocomotionOnGameThread")
+
 	check(IsInGameThread())
 
 	const auto& Locomotion{Character->GetLocomotionState()};
@@ -500,6 +572,8 @@ void UAlsAnimationInstance::RefreshLocomotionOnGameThread()
 
 void UAlsAnimationInstance::RefreshGroundedOnGameThread()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshGroundedOnGameThread")
+
 	check(IsInGameThread())
 
 	GroundedState.bPivotActive = GroundedState.bPivotActivationRequested && !bPendingUpdate &&
@@ -510,6 +584,9 @@ void UAlsAnimationInstance::RefreshGroundedOnGameThread()
 
 void UAlsAnimationInstance::RefreshGrounded(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshGrounded")
+	ALS_COST_SCOPE(Character->GetCostTracker(), Grounded)
+
 	// Always sample sprint block curve, otherwise issues with inertial blending may occur.
 
 	GroundedState.SprintBlockAmount = GetCurveValueClamped01(UAlsConstants::SprintBlockCurveName());
@@ -564,6 +641,8 @@ void UAlsAnimationInstance::RefreshGrounded(const float DeltaTime)
 
 void UAlsAnimationInstance::RefreshMovementDirection()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshMovementDirection")
+
 	// Calculate the movement direction. This value represents the direction the character is moving relative
 	// to the camera and is used in the cycle blending to blend to the appropriate directional states.
 
@@ -582,6 +661,8 @@ void UAlsAnimationInstance::RefreshMovementDirection()
 
 void UAlsAnimationInstance::RefreshVelocityBlend(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshVelocityBlend")
+
 	GroundedState.VelocityBlend.bReinitializationRequired |= bPendingUpdate;
 
 	// Calculate and interpolate the velocity blend amounts. This value represents the velocity amount of
@@ -628,6 +709,8 @@ void UAlsAnimationInstance::RefreshVelocityBlend(const float DeltaTime)
 
 void UAlsAnimationInstance::RefreshRotationYawOffsets()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshRotationYawOffsets")
+
 	// Set the rotation yaw offsets. These values influence the rotation yaw offset curve in the
 	// animation graph and are used to offset the character's rotation for more natural movement.
 	// The curves allow for fine control over how the offset behaves for each movement direction.
@@ -642,6 +725,8 @@ void UAlsAnimationInstance::RefreshRotationYawOffsets()
 
 void UAlsAnimationInstance::RefreshSprint(const FVector3f& RelativeAccelerationAmount, const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshSprint")
+
 	if (Gait != AlsGaitTags::Sprinting)
 	{
 		GroundedState.SprintTime = 0.0f;
@@ -666,6 +751,8 @@ void UAlsAnimationInstance::RefreshSprint(const FVector3f& RelativeAccelerationA
 
 void UAlsAnimationInstance::RefreshStrideBlendAmount()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshStrideBlendAmount")
+
 	// Calculate the stride blend amount. This value is used within the blend spaces to scale the stride (distance feet travel)
 	// so that the character can walk or run at different movement speeds. It also allows the walk or run gait animations to
 	// blend independently while still matching the animation speed to the movement speed, preventing the character from needing
@@ -688,6 +775,8 @@ void UAlsAnimationInstance::RefreshStrideBlendAmount()
 
 void UAlsAnimationInstance::RefreshWalkRunBlendAmount()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshWalkRunBlendAmount")
+
 	// Calculate the walk run blend amount. This value is used within the blend spaces to blend between walking and running.
 
 	GroundedState.WalkRunBlendAmount = Gait == AlsGaitTags::Walking ? 0.0f : 1.0f;
@@ -695,6 +784,8 @@ void UAlsAnimationInstance::RefreshWalkRunBlendAmount()
 
 void UAlsAnimationInstance::RefreshStandingPlayRate()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshStandingPlayRate")
+
 	// Calculate the standing play rate by dividing the character's speed by the animated speed for each gait.
 	// The interpolation is determined by the gait amount curve that exists on every locomotion cycle so that
 	// the play rate is always in sync with the currently blended animation. The value is also divided by the
@@ -718,6 +809,8 @@ void UAlsAnimationInstance::RefreshStandingPlayRate()
 
 void UAlsAnimationInstance::RefreshCrouchingPlayRate()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshCrouchingPlayRate")
+
 	// Calculate the crouching play rate by dividing the character's speed by the animated speed. This value needs
 	// to be separate from the standing play rate to improve the blend from crouching to standing while in motion.
 
@@ -728,6 +821,8 @@ void UAlsAnimationInstance::RefreshCrouchingPlayRate()
 
 void UAlsAnimationInstance::RefreshGroundedLeanAmount(const FVector3f& RelativeAccelerationAmount, const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshGroundedLeanAmount")
+
 	if (bPendingUpdate)
 	{
 		LeanState.RightAmount = RelativeAccelerationAmount.Y;
@@ -759,6 +854,8 @@ void UAlsAnimationInstance::ResetGroundedLeanAmount(const float DeltaTime)
 
 void UAlsAnimationInstance::RefreshInAirOnGameThread()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshInAirOnGameThread")
+
 	check(IsInGameThread())
 
 	InAirState.bJumped = !bPendingUpdate && (InAirState.bJumped || InAirState.bJumpRequested);
@@ -767,6 +864,9 @@ void UAlsAnimationInstance::RefreshInAirOnGameThread()
 
 void UAlsAnimationInstance::RefreshInAir(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshInAir")
+	ALS_COST_SCOPE(Character->GetCostTracker(), InAir)
+
 	if (InAirState.bJumped)
 	{
 		static constexpr auto ReferenceSpeed{600.0f};
@@ -792,6 +892,8 @@ void UAlsAnimationInstance::RefreshInAir(const float DeltaTime)
 
 void UAlsAnimationInstance::RefreshGroundPredictionAmount()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshGroundPredictionAmount")
+
 	// Calculate the ground prediction weight by tracing in the velocity direction to find a walkable surface the character
 	// is falling toward and getting the "time" (range from 0 to 1, 1 being maximum, 0 being about to ground) till impact.
 	// The ground prediction amount curve is used to control how the time affects the final amount for a smooth blend.
@@ -830,9 +932,15 @@ void UAlsAnimationInstance::RefreshGroundPredictionAmount()
 	};
 
 	FHitResult Hit;
-	GetWorld()->SweepSingleByChannel(Hit, SweepStartLocation, SweepStartLocation + SweepVector, FQuat::Identity, ECC_WorldStatic,
-	                                 FCollisionShape::MakeCapsule(LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight),
-	                                 {__FUNCTION__, false, Character}, Settings->InAir.GroundPredictionSweepResponses);
+	if (!TryGetReplaySceneQueryHit(Hit))
+	{
+		ALS_SCENE_QUERY(GroundPredictionSweeps, Character->GetCostTracker());
+		GetWorld()->SweepSingleByChannel(Hit, SweepStartLocation, SweepStartLocation + SweepVector, FQuat::Identity, ECC_WorldStatic,
+		                                 FCollisionShape::MakeCapsule(LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight),
+		                                 {__FUNCTION__, false, Character}, Settings->InAir.GroundPredictionSweepResponses);
+
+		RecordSceneQueryHit(Hit);
+	}
 
 	const auto bGroundValid{Hit.IsValidBlockingHit() && Hit.ImpactNormal.Z >= LocomotionState.WalkableFloorZ};
 
@@ -865,6 +973,8 @@ void UAlsAnimationInstance::RefreshGroundPredictionAmount()
 
 void UAlsAnimationInstance::RefreshInAirLeanAmount(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshInAirLeanAmount")
+
 	// Use the relative velocity direction and amount to determine how much the character should lean
 	// while in air. The lean amount curve gets the vertical velocity and is used as a multiplier to
 	// smoothly reverse the leaning direction when transitioning from moving upwards to moving downwards.
@@ -893,6 +1003,8 @@ void UAlsAnimationInstance::RefreshInAirLeanAmount(const float DeltaTime)
 
 void UAlsAnimationInstance::RefreshFeetOnGameThread()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshFeetOnGameThread")
+
 	check(IsInGameThread())
 
 	const auto* Mesh{GetSkelMeshComponent()};
@@ -918,6 +1030,9 @@ void UAlsAnimationInstance::RefreshFeetOnGameThread()
 
 void UAlsAnimationInstance::RefreshFeet(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshFeet")
+	ALS_COST_SCOPE(Character->GetCostTracker(), Feet)
+
 	FeetState.FootPlantedAmount = FMath::Clamp(GetCurveValue(UAlsConstants::FootPlantedCurveName()), -1.0f, 1.0f);
 	FeetState.FeetCrossingAmount = GetCurveValueClamped01(UAlsConstants::FeetCrossingCurveName());
 
@@ -941,6 +1056,8 @@ void UAlsAnimationInstance::RefreshFeet(const float DeltaTime)
 void UAlsAnimationInstance::RefreshFoot(FAlsFootState& FootState, const FName& FootIkCurveName, const FName& FootLockCurveName,
                                         const FTransform& ComponentTransformInverse, const float DeltaTime) const
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshFoot")
+
 	FootState.IkAmount = GetCurveValueClamped01(FootIkCurveName);
 
 	ProcessFootLockTeleport(FootState);
@@ -964,7 +1081,7 @@ void UAlsAnimationInstance::ProcessFootLockTeleport(FAlsFootState& FootState) co
 	// in one frame, since after accepting the teleportation event, the character can still be moved for
 	// some indefinite time, and this must be taken into account in order to avoid foot locking glitches.
 
-	if (bPendingUpdate || GetWorld()->TimeSince(TeleportedTime) > 0.2f ||
+	if (bPendingUpdate || GetWorldTimeSeconds() - TeleportedTime > 0.2f ||
 	    !FAnimWeight::IsRelevant(FootState.IkAmount * FootState.LockAmount))
 	{
 		return;
@@ -1018,6 +1135,8 @@ void UAlsAnimationInstance::RefreshFootLock(FAlsFootState& FootState, const FNam
                                             const FTransform& ComponentTransformInverse, const float DeltaTime,
                                             FVector& FinalLocation, FQuat& FinalRotation) const
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshFootLock")
+
 	auto NewFootLockAmount{GetCurveValueClamped01(FootLockCurveName)};
 
 	NewFootLockAmount *= 1.0f - RotateInPlaceState.FootLockBlockAmount;
@@ -1116,11 +1235,14 @@ void UAlsAnimationInstance::RefreshFootLock(FAlsFootState& FootState, const FNam
 void UAlsAnimationInstance::RefreshFootOffset(FAlsFootState& FootState, const float DeltaTime,
                                               FVector& FinalLocation, FQuat& FinalRotation) const
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshFootOffset")
+
 	if (!FAnimWeight::IsRelevant(FootState.IkAmount))
 	{
 		FootState.OffsetTargetLocation = FVector::ZeroVector;
 		FootState.OffsetTargetRotation = FQuat::Identity;
 		FootState.OffsetSpringState.Reset();
+		FootState.GroundHit.bValid = false;
 		return;
 	}
 
@@ -1129,6 +1251,7 @@ void UAlsAnimationInstance::RefreshFootOffset(FAlsFootState& FootState, const fl
 		FootState.OffsetTargetLocation = FVector::ZeroVector;
 		FootState.OffsetTargetRotation = FQuat::Identity;
 		FootState.OffsetSpringState.Reset();
+		FootState.GroundHit.bValid = false;
 
 		if (bPendingUpdate)
 		{
@@ -1155,19 +1278,41 @@ void UAlsAnimationInstance::RefreshFootOffset(FAlsFootState& FootState, const fl
 		FinalLocation.X, FinalLocation.Y, GetProxyOnAnyThread<FAnimInstanceProxy>().GetComponentTransform().GetLocation().Z
 	};
 
+	// The physical material is also requested so that the hit can be reused for footstep effects.
+
+	FCollisionQueryParams QueryParameters{__FUNCTION__, true, Character};
+	QueryParameters.bReturnPhysicalMaterial = true;
+
 	FHitResult Hit;
-	GetWorld()->LineTraceSingleByChannel(Hit,
-	                                     TraceLocation + FVector{
-		                                     0.0f, 0.0f, Settings->Feet.IkTraceDistanceUpward * LocomotionState.Scale
-	                                     },
-	                                     TraceLocation - FVector{
-		                                     0.0f, 0.0f, Settings->Feet.IkTraceDistanceDownward * LocomotionState.Scale
-	                                     },
-	                                     UEngineTypes::ConvertToCollisionChannel(Settings->Feet.IkTraceChannel),
-	                                     {__FUNCTION__, true, Character});
+	if (!TryGetReplaySceneQueryHit(Hit))
+	{
+		ALS_SCENE_QUERY(FootIkTraces, Character->GetCostTracker());
+		GetWorld()->LineTraceSingleByChannel(Hit,
+		                                     TraceLocation + FVector{
+			                                     0.0f, 0.0f, Settings->Feet.IkTraceDistanceUpward * LocomotionState.Scale
+		                                     },
+		                                     TraceLocation - FVector{
+			                                     0.0f, 0.0f, Settings->Feet.IkTraceDistanceDownward * LocomotionState.Scale
+		                                     },
+		                                     UEngineTypes::ConvertToCollisionChannel(Settings->Feet.IkTraceChannel),
+		                                     QueryParameters);
+
+		RecordSceneQueryHit(Hit);
+	}
 
 	const auto bGroundValid{Hit.IsValidBlockingHit() && Hit.ImpactNormal.Z >= LocomotionState.WalkableFloorZ};
 
+	FootState.GroundHit.bValid = bGroundValid;
+
+	if (bGroundValid)
+	{
+		FootState.GroundHit.Time = GetWorldTimeSeconds();
+		FootState.GroundHit.ImpactPoint = Hit.ImpactPoint;
+		FootState.GroundHit.ImpactNormal = Hit.ImpactNormal;
+		FootState.GroundHit.Component = Hit.Component;
+		FootState.GroundHit.PhysicalMaterial = Hit.PhysMaterial;
+	}
+
 #if WITH_EDITORONLY_DATA && ENABLE_DRAW_DEBUG
 	if (bDisplayDebugTraces)
 	{
@@ -1287,6 +1432,8 @@ void UAlsAnimationInstance::PlayTransitionAnimation(UAnimSequenceBase* Animation
 		return;
 	}
 
+	ALS_CSV_ACCUMULATE(MontageRequests, 1);
+
 	PlaySlotAnimationAsDynamicMontage(Animation, UAlsConstants::TransitionSlotName(),
 	                                  BlendInDuration, BlendOutDuration, PlayRate, 1, 0.0f, StartTime);
 }
@@ -1330,6 +1477,9 @@ void UAlsAnimationInstance::StopTransitionAndTurnInPlaceAnimations(const float B
 
 void UAlsAnimationInstance::RefreshTransitions()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshTransitions")
+	ALS_COST_SCOPE(Character->GetCostTracker(), Transitions)
+
 	// The allow transitions curve is modified within certain states, so that transitions allowed will be true while in those states.
 
 	TransitionsState.bTransitionsAllowed = FAnimWeight::IsFullWeight(GetCurveValue(UAlsConstants::AllowTransitionsCurveName()));
@@ -1339,6 +1489,8 @@ void UAlsAnimationInstance::RefreshTransitions()
 
 void UAlsAnimationInstance::RefreshDynamicTransition()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshDynamicTransition")
+
 	if (TransitionsState.DynamicTransitionsFrameDelay > 0)
 	{
 		TransitionsState.DynamicTransitionsFrameDelay -= 1;
@@ -1424,6 +1576,8 @@ void UAlsAnimationInstance::PlayQueuedDynamicTransitionAnimation()
 {
 	check(IsInGameThread())
 
+	ALS_CSV_ACCUMULATE(MontageRequests, 1);
+
 	PlaySlotAnimationAsDynamicMontage(TransitionsState.QueuedDynamicTransitionAnimation, UAlsConstants::TransitionSlotName(),
 	                                  Settings->Transitions.DynamicTransitionBlendDuration,
 	                                  Settings->Transitions.DynamicTransitionBlendDuration,
@@ -1439,6 +1593,9 @@ bool UAlsAnimationInstance::IsRotateInPlaceAllowed()
 
 void UAlsAnimationInstance::RefreshRotateInPlace(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshRotateInPlace")
+	ALS_COST_SCOPE(Character->GetCostTracker(), RotateInPlace)
+
 	static constexpr auto PlayRateInterpolationSpeed{5.0f};
 
 	// Rotate in place is allowed only if the character is standing still and aiming or in first-person view mode.
@@ -1509,6 +1666,9 @@ bool UAlsAnimationInstance::IsTurnInPlaceAllowed()
 
 void UAlsAnimationInstance::RefreshTurnInPlace(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshTurnInPlace")
+	ALS_COST_SCOPE(Character->GetCostTracker(), TurnInPlace)
+
 	// Turn in place is allowed only if transitions are allowed, the character
 	// standing still and looking at the camera and not in first-person mode.
 
@@ -1624,6 +1784,8 @@ void UAlsAnimationInstance::PlayQueuedTurnInPlaceAnimation()
 
 	const auto* TurnInPlaceSettings{TurnInPlaceState.QueuedSettings.Get()};
 
+	ALS_CSV_ACCUMULATE(MontageRequests, 1);
+
 	PlaySlotAnimationAsDynamicMontage(TurnInPlaceSettings->Animation, TurnInPlaceState.QueuedSlotName,
 	                                  Settings->TurnInPlace.BlendDuration, Settings->TurnInPlace.BlendDuration,
 	                                  TurnInPlaceSettings->PlayRate, 1, 0.0f);
@@ -1644,6 +1806,8 @@ void UAlsAnimationInstance::PlayQueuedTurnInPlaceAnimation()
 
 void UAlsAnimationInstance::RefreshRagdollingOnGameThread()
 {
+	ALS_TRACE_SCOPE("UAlsAnimationInstance::RefreshRagdollingOnGameThread")
+
 	check(IsInGameThread())
 
 	if (LocomotionAction != AlsLocomotionActionTags::Ragdolling)
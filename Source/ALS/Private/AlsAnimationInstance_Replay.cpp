@@ -0,0 +1,379 @@
+#include "AlsAnimationInstance.h"
+
+#include "AlsAnimationInstanceProxy.h"
+#include "AlsCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Utility/AlsLog.h"
+#include "Utility/AlsMacros.h"
+
+namespace AlsAnimationInstanceReplay
+{
+	bool IsStateProperty(const FProperty* Property)
+	{
+		// Editor-only properties are excluded, so that recordings made in the editor can be replayed in a game build and vice versa.
+
+		return Property->HasAnyPropertyFlags(CPF_Transient) && !Property->IsEditorOnlyProperty() &&
+		       !Property->IsA<FObjectPropertyBase>();
+	}
+
+	uint32 HashPropertyLayout(const FProperty* Property, uint32 Hash)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Property->GetFName()));
+		Hash = HashCombine(Hash, GetTypeHash(Property->GetCPPType()));
+
+		const auto* StructProperty{CastField<FStructProperty>(Property)};
+		if (StructProperty != nullptr)
+		{
+			for (TFieldIterator<FProperty> Iterator{StructProperty->Struct}; Iterator; ++Iterator)
+			{
+				Hash = HashPropertyLayout(*Iterator, Hash);
+			}
+		}
+
+		return Hash;
+	}
+
+	UAlsAnimationInstance* GetPlayerAnimationInstance(const UWorld* World)
+	{
+		const auto* Player{IsValid(World) ? World->GetFirstPlayerController() : nullptr};
+		const auto* Character{IsValid(Player) ? Cast<AAlsCharacter>(Player->GetPawn()) : nullptr};
+
+		return IsValid(Character) ? Cast<UAlsAnimationInstance>(Character->GetMesh()->GetAnimInstance()) : nullptr;
+	}
+
+	FString GetRecordingFilePath(const TArray<FString>& Arguments)
+	{
+		return FPaths::Combine(FPaths::ProfilingDir(), TEXT("Als"), TEXT("Replays"),
+		                       (Arguments.IsValidIndex(0) ? Arguments[0] : TEXT("Recording")) + TEXT(".alsreplay"));
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs StartRecordingCommand{
+		TEXT("als.AnimationReplay.StartRecording"),
+		TEXT("Starts recording the animation instance inputs of the local player character."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Arguments, UWorld* World)
+		{
+			auto* AnimationInstance{GetPlayerAnimationInstance(World)};
+			if (!IsValid(AnimationInstance))
+			{
+				UE_LOG(LogAls, Warning, TEXT("%hs: The local player has no ALS animation instance."), __FUNCTION__);
+				return;
+			}
+
+			AnimationInstance->StartRecording();
+		})
+	};
+
+	FAutoConsoleCommandWithWorldAndArgs StopRecordingCommand{
+		TEXT("als.AnimationReplay.StopRecording"),
+		TEXT("Stops recording the animation instance inputs of the local player character and saves the recording. ")
+		TEXT("Arguments: [Name = Recording]."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Arguments, UWorld* World)
+		{
+			auto* AnimationInstance{GetPlayerAnimationInstance(World)};
+			if (!IsValid(AnimationInstance) || !AnimationInstance->IsRecording())
+			{
+				UE_LOG(LogAls, Warning, TEXT("%hs: The local player animation instance is not being recorded."), __FUNCTION__);
+				return;
+			}
+
+			const auto Recording{AnimationInstance->StopRecording()};
+			const auto FilePath{GetRecordingFilePath(Arguments)};
+
+			if (!Recording.SaveToFile(FilePath))
+			{
+				UE_LOG(LogAls, Warning, TEXT("%hs: Failed to save the recording to %s."), __FUNCTION__, *FilePath);
+				return;
+			}
+
+			UE_LOG(LogAls, Log, TEXT("%hs: Saved %d recorded frames to %s."), __FUNCTION__, Recording.Frames.Num(), *FilePath);
+		})
+	};
+
+	FAutoConsoleCommandWithWorldAndArgs RunCommand{
+		TEXT("als.AnimationReplay.Run"),
+		TEXT("Replays a recording against the local player animation instance and reports timings and output mismatches. ")
+		TEXT("Arguments: [Name = Recording] [IterationsCount = 100]."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Arguments, UWorld* World)
+		{
+			auto* AnimationInstance{GetPlayerAnimationInstance(World)};
+			if (!IsValid(AnimationInstance))
+			{
+				UE_LOG(LogAls, Warning, TEXT("%hs: The local player has no ALS animation instance."), __FUNCTION__);
+				return;
+			}
+
+			const auto FilePath{GetRecordingFilePath(Arguments)};
+
+			FAlsAnimationInstanceRecording Recording;
+			if (!Recording.LoadFromFile(FilePath))
+			{
+				UE_LOG(LogAls, Warning, TEXT("%hs: Failed to load the recording from %s."), __FUNCTION__, *FilePath);
+				return;
+			}
+
+			const auto IterationsCount{Arguments.IsValidIndex(1) ? FMath::Max(1, FCString::Atoi(*Arguments[1])) : 100};
+			const auto Result{AnimationInstance->Replay(Recording, IterationsCount)};
+
+			UE_LOG(LogAls, Log, TEXT("%hs: Replayed %d frames %d times in %.3f ms. Fastest iteration: %.3f ms (%.4f ms per frame)."),
+			       __FUNCTION__, Result.FramesCount, IterationsCount, Result.TotalMilliseconds, Result.MinIterationMilliseconds,
+			       Result.FramesCount > 0 ? Result.MinIterationMilliseconds / Result.FramesCount : 0.0);
+
+			if (Result.MismatchedFramesCount > 0)
+			{
+				UE_LOG(LogAls, Warning, TEXT("%hs: %d of %d frames did not match the recorded output, starting from frame %d."),
+				       __FUNCTION__, Result.MismatchedFramesCount, Result.FramesCount, Result.FirstMismatchedFrameIndex);
+			}
+			else
+			{
+				UE_LOG(LogAls, Log, TEXT("%hs: All frames matched the recorded output."), __FUNCTION__);
+			}
+		})
+	};
+}
+
+void UAlsAnimationInstance::StartRecording()
+{
+	check(IsInGameThread())
+
+	Recording = MakeUnique<FAlsAnimationInstanceRecording>();
+	Recording->StateLayoutHash = GetStateLayoutHash();
+}
+
+FAlsAnimationInstanceRecording UAlsAnimationInstance::StopRecording()
+{
+	check(IsInGameThread())
+
+	FAlsAnimationInstanceRecording Result;
+
+	RecordingFrame = nullptr;
+
+	if (Recording.IsValid())
+	{
+		Result = MoveTemp(*Recording);
+		Recording.Reset();
+	}
+
+	return Result;
+}
+
+FAlsAnimationInstanceReplayResult UAlsAnimationInstance::Replay(const FAlsAnimationInstanceRecording& SourceRecording,
+                                                                const int32 IterationsCount)
+{
+	check(IsInGameThread())
+
+	FAlsAnimationInstanceReplayResult Result;
+
+	if (!ALS_ENSURE(IsValid(Settings) && IsValid(Character)) || !ALS_ENSURE(!Recording.IsValid()) ||
+	    SourceRecording.Frames.Num() <= 0 || IterationsCount <= 0)
+	{
+		return Result;
+	}
+
+	if (SourceRecording.StateLayoutHash != GetStateLayoutHash())
+	{
+		UE_LOG(LogAls, Warning, TEXT("%hs: The recording was made with a different animation instance state layout and can't be replayed."),
+		       __FUNCTION__);
+		return Result;
+	}
+
+	// The replay runs synchronously on the game thread between frames, so it is safe to
+	// temporarily overwrite the proxy state that the thread safe update reads from.
+
+	auto& Proxy{GetProxyOnGameThread<FAlsAnimationInstanceProxy>()};
+	auto& ProxyCurves{const_cast<TMap<FName, float>&>(Proxy.GetAnimationCurves(EAnimCurveType::AttributeCurve))};
+	auto& ProxyComponentTransform{const_cast<FTransform&>(Proxy.GetComponentTransform())};
+
+	TArray<uint8> InitialState;
+	SaveState(InitialState);
+
+	const auto InitialCurves{ProxyCurves};
+	const auto InitialComponentTransform{ProxyComponentTransform};
+
+	TArray<uint8> OutputState;
+
+	Result.FramesCount = SourceRecording.Frames.Num();
+	Result.MinIterationMilliseconds = TNumericLimits<double>::Max();
+
+	for (auto Iteration{0}; Iteration < IterationsCount; Iteration++)
+	{
+		uint64 IterationCycles{0};
+
+		for (auto i{0}; i < SourceRecording.Frames.Num(); i++)
+		{
+			const auto& Frame{SourceRecording.Frames[i]};
+
+			// Restoring the recorded input state on every frame keeps an early mismatch from cascading into the following frames.
+
+			LoadState(Frame.InputState);
+
+			ProxyCurves = Frame.Curves;
+			ProxyComponentTransform = Frame.ComponentTransform;
+
+			ReplayFrame = &Frame;
+			ReplaySceneQueryIndex = 0;
+
+			const auto StartCycles{FPlatformTime::Cycles64()};
+
+			NativeThreadSafeUpdateAnimation(Frame.DeltaTime);
+
+			for (auto j{0}; j < Frame.LookRefreshesCount; j++)
+			{
+				RefreshLook();
+			}
+
+			IterationCycles += FPlatformTime::Cycles64() - StartCycles;
+
+			ReplayFrame = nullptr;
+
+			if (Iteration <= 0)
+			{
+				SaveState(OutputState);
+
+				if (OutputState != Frame.OutputState)
+				{
+					if (Result.MismatchedFramesCount <= 0)
+					{
+						Result.FirstMismatchedFrameIndex = i;
+					}
+
+					Result.MismatchedFramesCount += 1;
+				}
+			}
+		}
+
+		const auto IterationMilliseconds{FPlatformTime::ToMilliseconds64(IterationCycles)};
+
+		Result.TotalMilliseconds += IterationMilliseconds;
+		Result.MinIterationMilliseconds = FMath::Min(Result.MinIterationMilliseconds, IterationMilliseconds);
+	}
+
+	LoadState(InitialState);
+
+	ProxyCurves = InitialCurves;
+	ProxyComponentTransform = InitialComponentTransform;
+
+	return Result;
+}
+
+uint32 UAlsAnimationInstance::GetStateLayoutHash()
+{
+	static const auto Hash{
+		[]
+		{
+			uint32 Result{0};
+
+			for (TFieldIterator<FProperty> Iterator{StaticClass(), EFieldIteratorFlags::ExcludeSuper}; Iterator; ++Iterator)
+			{
+				if (AlsAnimationInstanceReplay::IsStateProperty(*Iterator))
+				{
+					Result = AlsAnimationInstanceReplay::HashPropertyLayout(*Iterator, Result);
+				}
+			}
+
+			return Result;
+		}()
+	};
+
+	return Hash;
+}
+
+void UAlsAnimationInstance::SerializeState(FArchive& Archive)
+{
+	// Only the transient state is serialized. Object references such as the character or the settings are not
+	// part of the state, since they are not changed by the thread safe update and cannot be restored from a file.
+
+	FObjectAndNameAsStringProxyArchive ProxyArchive{Archive, false};
+
+	for (TFieldIterator<FProperty> Iterator{StaticClass(), EFieldIteratorFlags::ExcludeSuper}; Iterator; ++Iterator)
+	{
+		auto* Property{*Iterator};
+
+		if (AlsAnimationInstanceReplay::IsStateProperty(Property))
+		{
+			Property->SerializeItem(FStructuredArchiveFromArchive{ProxyArchive}.GetSlot(),
+			                        Property->ContainerPtrToValuePtr<void>(this));
+		}
+	}
+}
+
+void UAlsAnimationInstance::SaveState(TArray<uint8>& State)
+{
+	State.Reset();
+
+	FMemoryWriter Writer{State};
+	SerializeState(Writer);
+}
+
+void UAlsAnimationInstance::LoadState(const TArray<uint8>& State)
+{
+	FMemoryReader Reader{State};
+	SerializeState(Reader);
+}
+
+void UAlsAnimationInstance::BeginRecordingFrame(const float DeltaTime)
+{
+	check(Recording.IsValid())
+
+	auto& Frame{Recording->Frames.Emplace_GetRef()};
+
+	const auto& Proxy{GetProxyOnAnyThread<FAlsAnimationInstanceProxy>()};
+
+	Frame.DeltaTime = DeltaTime;
+	Frame.WorldTime = GetWorld()->GetTimeSeconds();
+	Frame.ComponentTransform = Proxy.GetComponentTransform();
+	Frame.Curves = Proxy.GetAnimationCurves(EAnimCurveType::AttributeCurve);
+
+	SaveState(Frame.InputState);
+
+	RecordingFrame = &Frame;
+}
+
+void UAlsAnimationInstance::EndRecordingFrame()
+{
+	SaveState(RecordingFrame->OutputState);
+
+	RecordingFrame = nullptr;
+}
+
+bool UAlsAnimationInstance::TryGetReplaySceneQueryHit(FHitResult& Hit) const
+{
+	if (ReplayFrame == nullptr)
+	{
+		return false;
+	}
+
+	// A scene query that was not recorded means that the replay has already diverged from the recording. An empty
+	// hit is returned in this case so that the world is never touched during the replay.
+
+	Hit = ReplayFrame->SceneQueryHits.IsValidIndex(ReplaySceneQueryIndex)
+		      ? ReplayFrame->SceneQueryHits[ReplaySceneQueryIndex]
+		      : FHitResult{};
+
+	ReplaySceneQueryIndex += 1;
+	return true;
+}
+
+void UAlsAnimationInstance::RecordSceneQueryHit(const FHitResult& Hit) const
+{
+	if (RecordingFrame != nullptr)
+	{
+		RecordingFrame->SceneQueryHits.Add(Hit);
+	}
+}
+
+double UAlsAnimationInstance::GetWorldTimeSeconds() const
+{
+	return ReplayFrame != nullptr ? ReplayFrame->WorldTime : GetWorld()->GetTimeSeconds();
+}
+
+float UAlsAnimationInstance::GetDeltaTimeSeconds() const
+{
+	return ReplayFrame != nullptr ? ReplayFrame->DeltaTime : GetDeltaSeconds();
+}
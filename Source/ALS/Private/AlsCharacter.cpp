@@ -12,7 +12,10 @@
 #include "Net/Core/PushModel/PushModel.h"
 #include "Settings/AlsCharacterSettings.h"
 #include "Utility/AlsConstants.h"
+#include "Utility/AlsCsvProfiler.h"
 #include "Utility/AlsMacros.h"
+#include "Utility/AlsProfiling.h"
+#include "Utility/AlsTrace.h"
 #include "Utility/AlsUtility.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsCharacter)
@@ -82,6 +85,28 @@ void AAlsCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLif
 	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, RagdollTargetLocation, Parameters)
 }
 
+void AAlsCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	CostTracker.AddReplicationUpdate();
+
+	ALS_CSV_ACCUMULATE(ReplicationUpdates, 1);
+}
+
+bool AAlsCharacter::CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParameters, FFrame* Stack)
+{
+	// The size of the function parameters is used as an approximation of the size of the
+	// remote function call, since the actual number of bytes sent is not exposed per actor.
+
+	CostTracker.AddRemoteFunctionCall(Function->ParmsSize);
+
+	ALS_CSV_ACCUMULATE(RemoteFunctionCalls, 1);
+	ALS_CSV_ACCUMULATE(RemoteFunctionBytes, static_cast<int32>(Function->ParmsSize));
+
+	return Super::CallRemoteFunction(Function, Parameters, OutParameters, Stack);
+}
+
 void AAlsCharacter::PreRegisterAllComponents()
 {
 	// Set some default values here to ensure that the animation instance and the
@@ -159,6 +184,11 @@ void AAlsCharacter::BeginPlay()
 	RefreshUsingAbsoluteRotation();
 	RefreshVisibilityBasedAnimTickOption();
 
+	if (IsValid(Settings))
+	{
+		LoadActionAssetsAsync(static_cast<EAlsActionAssets>(Settings->PreloadedActionAssets));
+	}
+
 	ViewState.NetworkSmoothing.bEnabled |= IsValid(Settings) &&
 		Settings->View.bEnableNetworkSmoothing && GetLocalRole() == ROLE_SimulatedProxy;
 
@@ -252,7 +282,16 @@ void AAlsCharacter::OnRep_ReplicatedBasedMovement()
 
 void AAlsCharacter::Tick(const float DeltaTime)
 {
-	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("AAlsCharacter::Tick()"), STAT_AAlsCharacter_Tick, STATGROUP_Als)
+	ALS_PROFILE_SCOPE("AAlsCharacter::Tick", AAlsCharacter_Tick, CharacterTick, CostTracker, CharacterTick)
+
+	ALS_TRACE_CHARACTER(GetMesh()->GetPredictedLODLevel());
+
+	CostTracker.BeginFrame();
+
+	ALS_CSV_ACCUMULATE(Characters, 1);
+	ALS_CSV_ACCUMULATE(CharactersRagdolling, LocomotionAction == AlsLocomotionActionTags::Ragdolling ? 1 : 0);
+	ALS_CSV_ACCUMULATE(CharactersMantling, LocomotionAction == AlsLocomotionActionTags::Mantling ? 1 : 0);
+	ALS_CSV_ACCUMULATE(CharactersRolling, LocomotionAction == AlsLocomotionActionTags::Rolling ? 1 : 0);
 
 	if (!IsValid(Settings) || !AnimationInstance.IsValid())
 	{
@@ -318,6 +357,8 @@ void AAlsCharacter::Restart()
 
 void AAlsCharacter::RefreshUsingAbsoluteRotation() const
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshUsingAbsoluteRotation")
+
 	// Use absolute mesh rotation to be able to precisely synchronize character rotation
 	// with animations by manually updating the mesh rotation from the animation instance.
 
@@ -341,6 +382,8 @@ void AAlsCharacter::RefreshUsingAbsoluteRotation() const
 
 void AAlsCharacter::RefreshVisibilityBasedAnimTickOption() const
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshVisibilityBasedAnimTickOption")
+
 	const auto DefaultTickOption{GetClass()->GetDefaultObject<ThisClass>()->GetMesh()->VisibilityBasedAnimTickOption};
 
 	// Make sure that the pose is always ticked on the server when the character is controlled
@@ -359,6 +402,8 @@ void AAlsCharacter::RefreshVisibilityBasedAnimTickOption() const
 
 void AAlsCharacter::RefreshMovementBase()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshMovementBase")
+
 	if (BasedMovement.MovementBase != MovementBase.Primitive || BasedMovement.BoneName != MovementBase.BoneName)
 	{
 		MovementBase.Primitive = BasedMovement.MovementBase;
@@ -400,6 +445,8 @@ void AAlsCharacter::SetViewMode(const FGameplayTag& NewViewMode)
 
 void AAlsCharacter::ServerSetViewMode_Implementation(const FGameplayTag& NewViewMode)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::ServerSetViewMode_Implementation")
+
 	SetViewMode(NewViewMode);
 }
 
@@ -492,6 +539,13 @@ void AAlsCharacter::NotifyLocomotionModeChanged(const FGameplayTag& PreviousLoco
 		StartRagdolling();
 	}
 
+	if (LocomotionMode == AlsLocomotionModeTags::InAir && Settings->Rolling.bStartRollingOnLand)
+	{
+		// Warm up the rolling montage while the character is in the air, so that it can roll on land.
+
+		LoadActionAssetsAsync(EAlsActionAssets::Rolling);
+	}
+
 	OnLocomotionModeChanged(PreviousLocomotionMode);
 }
 
@@ -523,6 +577,8 @@ void AAlsCharacter::OnDesiredAimingChanged_Implementation(const bool bPreviousDe
 
 void AAlsCharacter::ServerSetDesiredAiming_Implementation(const bool bNewAiming)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::ServerSetDesiredAiming_Implementation")
+
 	SetDesiredAiming(bNewAiming);
 }
 
@@ -543,6 +599,8 @@ void AAlsCharacter::SetDesiredRotationMode(const FGameplayTag& NewDesiredRotatio
 
 void AAlsCharacter::ServerSetDesiredRotationMode_Implementation(const FGameplayTag& NewDesiredRotationMode)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::ServerSetDesiredRotationMode_Implementation")
+
 	SetDesiredRotationMode(NewDesiredRotationMode);
 }
 
@@ -564,6 +622,8 @@ void AAlsCharacter::OnRotationModeChanged_Implementation(const FGameplayTag& Pre
 
 void AAlsCharacter::RefreshRotationMode()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshRotationMode")
+
 	const auto bSprinting{Gait == AlsGaitTags::Sprinting};
 	const auto bAiming{bDesiredAiming || DesiredRotationMode == AlsRotationModeTags::Aiming};
 
@@ -670,6 +730,8 @@ void AAlsCharacter::SetDesiredStance(const FGameplayTag& NewDesiredStance)
 
 void AAlsCharacter::ServerSetDesiredStance_Implementation(const FGameplayTag& NewDesiredStance)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::ServerSetDesiredStance_Implementation")
+
 	SetDesiredStance(NewDesiredStance);
 }
 
@@ -780,6 +842,8 @@ void AAlsCharacter::SetDesiredGait(const FGameplayTag& NewDesiredGait)
 
 void AAlsCharacter::ServerSetDesiredGait_Implementation(const FGameplayTag& NewDesiredGait)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::ServerSetDesiredGait_Implementation")
+
 	SetDesiredGait(NewDesiredGait);
 }
 
@@ -799,6 +863,8 @@ void AAlsCharacter::OnGaitChanged_Implementation(const FGameplayTag& PreviousGai
 
 void AAlsCharacter::RefreshGait()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshGait")
+
 	if (LocomotionMode != AlsLocomotionModeTags::Grounded)
 	{
 		return;
@@ -901,6 +967,8 @@ void AAlsCharacter::SetOverlayMode(const FGameplayTag& NewOverlayMode)
 
 void AAlsCharacter::ServerSetOverlayMode_Implementation(const FGameplayTag& NewOverlayMode)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::ServerSetOverlayMode_Implementation")
+
 	SetOverlayMode(NewOverlayMode);
 }
 
@@ -946,6 +1014,8 @@ void AAlsCharacter::SetInputDirection(FVector NewInputDirection)
 
 void AAlsCharacter::RefreshInput(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshInput")
+
 	if (GetLocalRole() >= ROLE_AutonomousProxy)
 	{
 		SetInputDirection(GetCharacterMovement()->GetCurrentAcceleration() / GetCharacterMovement()->GetMaxAcceleration());
@@ -979,6 +1049,8 @@ void AAlsCharacter::SetReplicatedViewRotation(const FRotator& NewViewRotation)
 
 void AAlsCharacter::ServerSetReplicatedViewRotation_Implementation(const FRotator& NewViewRotation)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::ServerSetReplicatedViewRotation_Implementation")
+
 	SetReplicatedViewRotation(NewViewRotation);
 }
 
@@ -1049,6 +1121,8 @@ void AAlsCharacter::CorrectViewNetworkSmoothing(const FRotator& NewViewRotation)
 
 void AAlsCharacter::RefreshView(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshView")
+
 	if (MovementBase.bHasRelativeRotation)
 	{
 		// Offset the rotations to keep them relative to the movement base.
@@ -1081,6 +1155,8 @@ void AAlsCharacter::RefreshView(const float DeltaTime)
 
 void AAlsCharacter::RefreshViewNetworkSmoothing(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshViewNetworkSmoothing")
+
 	// Based on UCharacterMovementComponent::SmoothClientPosition_Interpolate()
 	// and UCharacterMovementComponent::SmoothClientPosition_UpdateVisuals().
 
@@ -1132,6 +1208,8 @@ void AAlsCharacter::SetDesiredVelocityYawAngle(const float NewDesiredVelocityYaw
 
 void AAlsCharacter::RefreshLocomotionLocationAndRotation()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshLocomotionLocationAndRotation")
+
 	const auto& ActorTransform{GetActorTransform()};
 
 	// If network smoothing is disabled, then return regular actor transform.
@@ -1165,6 +1243,8 @@ void AAlsCharacter::RefreshLocomotionLocationAndRotation()
 
 void AAlsCharacter::RefreshLocomotionEarly()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshLocomotionEarly")
+
 	if (MovementBase.bHasRelativeRotation)
 	{
 		// Offset the rotations (the actor's rotation too) to keep them relative to the movement base.
@@ -1194,6 +1274,8 @@ void AAlsCharacter::RefreshLocomotionEarly()
 
 void AAlsCharacter::RefreshLocomotion(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshLocomotion")
+
 	LocomotionState.Velocity = GetVelocity();
 
 	// Determine if the character is moving by getting its speed. The speed equals the length
@@ -1232,6 +1314,8 @@ void AAlsCharacter::RefreshLocomotion(const float DeltaTime)
 
 void AAlsCharacter::RefreshLocomotionLate(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshLocomotionLate")
+
 	if (!LocomotionMode.IsValid() || LocomotionAction.IsValid())
 	{
 		RefreshLocomotionLocationAndRotation();
@@ -1268,6 +1352,8 @@ void AAlsCharacter::OnJumped_Implementation()
 
 void AAlsCharacter::MulticastOnJumpedNetworked_Implementation()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::MulticastOnJumpedNetworked_Implementation")
+
 	if (!IsLocallyControlled())
 	{
 		OnJumpedNetworked();
@@ -1295,6 +1381,8 @@ void AAlsCharacter::CharacterMovement_OnPhysicsRotation(const float DeltaTime)
 
 void AAlsCharacter::RefreshGroundedRotation(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshGroundedRotation")
+
 	if (LocomotionAction.IsValid() || LocomotionMode != AlsLocomotionModeTags::Grounded)
 	{
 		return;
@@ -1393,16 +1481,22 @@ void AAlsCharacter::RefreshGroundedRotation(const float DeltaTime)
 
 bool AAlsCharacter::RefreshCustomGroundedMovingRotation(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshCustomGroundedMovingRotation")
+
 	return false;
 }
 
 bool AAlsCharacter::RefreshCustomGroundedNotMovingRotation(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshCustomGroundedNotMovingRotation")
+
 	return false;
 }
 
 void AAlsCharacter::RefreshGroundedMovingAimingRotation(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshGroundedMovingAimingRotation")
+
 	static constexpr auto RotationInterpolationSpeed{20.0f};
 	static constexpr auto TargetYawAngleRotationSpeed{1000.0f};
 
@@ -1412,6 +1506,8 @@ void AAlsCharacter::RefreshGroundedMovingAimingRotation(const float DeltaTime)
 
 void AAlsCharacter::RefreshGroundedNotMovingAimingRotation(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshGroundedNotMovingAimingRotation")
+
 	static constexpr auto RotationInterpolationSpeed{20.0f};
 
 	if (LocomotionState.bHasInput)
@@ -1486,6 +1582,8 @@ void AAlsCharacter::ApplyRotationYawSpeed(const float DeltaTime)
 
 void AAlsCharacter::RefreshInAirRotation(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshInAirRotation")
+
 	if (LocomotionAction.IsValid() || LocomotionMode != AlsLocomotionModeTags::InAir)
 	{
 		return;
@@ -1536,11 +1634,15 @@ void AAlsCharacter::RefreshInAirRotation(const float DeltaTime)
 
 bool AAlsCharacter::RefreshCustomInAirRotation(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshCustomInAirRotation")
+
 	return false;
 }
 
 void AAlsCharacter::RefreshInAirAimingRotation(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshInAirAimingRotation")
+
 	static constexpr auto RotationInterpolationSpeed{15.0f};
 
 	RefreshRotation(UE_REAL_TO_FLOAT(ViewState.Rotation.Yaw), DeltaTime, RotationInterpolationSpeed);
@@ -1548,6 +1650,8 @@ void AAlsCharacter::RefreshInAirAimingRotation(const float DeltaTime)
 
 void AAlsCharacter::RefreshRotation(const float TargetYawAngle, const float DeltaTime, const float RotationInterpolationSpeed)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshRotation")
+
 	RefreshTargetYawAngle(TargetYawAngle);
 
 	auto NewRotation{GetActorRotation()};
@@ -1562,6 +1666,8 @@ void AAlsCharacter::RefreshRotation(const float TargetYawAngle, const float Delt
 void AAlsCharacter::RefreshRotationExtraSmooth(const float TargetYawAngle, const float DeltaTime,
                                                const float RotationInterpolationSpeed, const float TargetYawAngleRotationSpeed)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshRotationExtraSmooth")
+
 	LocomotionState.TargetYawAngle = TargetYawAngle;
 
 	RefreshViewRelativeTargetYawAngle();
@@ -1582,6 +1688,8 @@ void AAlsCharacter::RefreshRotationExtraSmooth(const float TargetYawAngle, const
 
 void AAlsCharacter::RefreshRotationInstant(const float TargetYawAngle, const ETeleportType Teleport)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshRotationInstant")
+
 	RefreshTargetYawAngle(TargetYawAngle);
 
 	auto NewRotation{GetActorRotation()};
@@ -1594,11 +1702,15 @@ void AAlsCharacter::RefreshRotationInstant(const float TargetYawAngle, const ETe
 
 void AAlsCharacter::RefreshTargetYawAngleUsingLocomotionRotation()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshTargetYawAngleUsingLocomotionRotation")
+
 	RefreshTargetYawAngle(UE_REAL_TO_FLOAT(LocomotionState.Rotation.Yaw));
 }
 
 void AAlsCharacter::RefreshTargetYawAngle(const float TargetYawAngle)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshTargetYawAngle")
+
 	LocomotionState.TargetYawAngle = TargetYawAngle;
 
 	RefreshViewRelativeTargetYawAngle();
@@ -1608,6 +1720,8 @@ void AAlsCharacter::RefreshTargetYawAngle(const float TargetYawAngle)
 
 void AAlsCharacter::RefreshViewRelativeTargetYawAngle()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshViewRelativeTargetYawAngle")
+
 	LocomotionState.ViewRelativeTargetYawAngle = FRotator3f::NormalizeAxis(UE_REAL_TO_FLOAT(
 		ViewState.Rotation.Yaw - LocomotionState.TargetYawAngle));
 }
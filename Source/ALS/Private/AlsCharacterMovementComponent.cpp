@@ -187,6 +187,31 @@ void UAlsCharacterMovementComponent::BeginPlay()
 	Super::BeginPlay();
 }
 
+void UAlsCharacterMovementComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	// The network prediction data and saved moves are not visible to serialization, so they are counted here.
+
+	if (ClientPredictionData != nullptr)
+	{
+		const auto SavedMovesCount{
+			ClientPredictionData->SavedMoves.Num() + ClientPredictionData->FreeMoves.Num() +
+			(ClientPredictionData->PendingMove.IsValid() ? 1 : 0) + (ClientPredictionData->LastAckedMove.IsValid() ? 1 : 0)
+		};
+
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(sizeof(FAlsNetworkPredictionData) +
+		                                                     ClientPredictionData->SavedMoves.GetAllocatedSize() +
+		                                                     ClientPredictionData->FreeMoves.GetAllocatedSize() +
+		                                                     SavedMovesCount * sizeof(FAlsSavedMove));
+	}
+
+	if (ServerPredictionData != nullptr)
+	{
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(sizeof(FNetworkPredictionData_Server_Character));
+	}
+}
+
 void UAlsCharacterMovementComponent::SetMovementMode(const EMovementMode NewMovementMode, const uint8 NewCustomMode)
 {
 	if (!bMovementModeLocked)
@@ -3,20 +3,107 @@
 #include "AlsAnimationInstance.h"
 #include "AlsCharacterMovementComponent.h"
 #include "DrawDebugHelpers.h"
+#include "Animation/AnimMontage.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Curves/CurveFloat.h"
 #include "Curves/CurveVector.h"
+#include "Engine/AssetManager.h"
 #include "Engine/NetConnection.h"
 #include "Net/Core/PushModel/PushModel.h"
 #include "RootMotionSources/AlsRootMotionSource_Mantling.h"
 #include "Settings/AlsCharacterSettings.h"
 #include "Utility/AlsConstants.h"
+#include "Utility/AlsCsvProfiler.h"
 #include "Utility/AlsMacros.h"
+#include "Utility/AlsProfiling.h"
+#include "Utility/AlsTrace.h"
 #include "Utility/AlsUtility.h"
 
+void AAlsCharacter::LoadActionAssetsAsync(const EAlsActionAssets Assets)
+{
+	const auto NewAssets{Assets & ~RequestedActionAssets};
+	if (NewAssets == EAlsActionAssets::None)
+	{
+		return;
+	}
+
+	RequestedActionAssets |= NewAssets;
+
+	TArray<FSoftObjectPath> AssetPaths;
+	GatherActionAssets(NewAssets, AssetPaths);
+
+	if (AssetPaths.IsEmpty())
+	{
+		OnActionAssetsLoaded(NewAssets);
+		return;
+	}
+
+	if (!UAssetManager::IsInitialized())
+	{
+		for (const auto& AssetPath : AssetPaths)
+		{
+			AssetPath.TryLoad();
+		}
+
+		OnActionAssetsLoaded(NewAssets);
+		return;
+	}
+
+	ActionAssetsLoadHandles.Emplace(UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(AssetPaths), FStreamableDelegate::CreateUObject(this, &ThisClass::OnActionAssetsLoaded, NewAssets)));
+}
+
+void AAlsCharacter::GatherActionAssets(const EAlsActionAssets Assets, TArray<FSoftObjectPath>& AssetPaths)
+{
+	const auto AddAssetPath{
+		[&AssetPaths](const TSoftObjectPtr<UAnimMontage>& Montage)
+		{
+			if (!Montage.IsNull())
+			{
+				AssetPaths.AddUnique(Montage.ToSoftObjectPath());
+			}
+		}
+	};
+
+	if (!IsValid(Settings))
+	{
+		return;
+	}
+
+	if (EnumHasAnyFlags(Assets, EAlsActionAssets::Rolling))
+	{
+		AddAssetPath(Settings->Rolling.Montage);
+	}
+
+	if (EnumHasAnyFlags(Assets, EAlsActionAssets::GettingUp))
+	{
+		AddAssetPath(Settings->Ragdolling.GetUpFrontMontage);
+		AddAssetPath(Settings->Ragdolling.GetUpBackMontage);
+	}
+
+	if (EnumHasAnyFlags(Assets, EAlsActionAssets::Mantling))
+	{
+		for (const auto MantlingType : {EAlsMantlingType::High, EAlsMantlingType::Low, EAlsMantlingType::InAir})
+		{
+			const auto* MantlingSettings{SelectMantlingSettings(MantlingType)};
+			if (IsValid(MantlingSettings))
+			{
+				AddAssetPath(MantlingSettings->Montage);
+			}
+		}
+	}
+}
+
+void AAlsCharacter::OnActionAssetsLoaded(const EAlsActionAssets Assets)
+{
+	LoadedActionAssets |= Assets;
+}
+
 void AAlsCharacter::TryStartRolling(const float PlayRate)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::TryStartRolling")
+
 	if (LocomotionMode == AlsLocomotionModeTags::Grounded)
 	{
 		StartRolling(PlayRate, Settings->Rolling.bRotateToInputOnStart && LocomotionState.bHasInput
@@ -39,6 +126,14 @@ void AAlsCharacter::StartRolling(const float PlayRate, const float TargetYawAngl
 		return;
 	}
 
+	if (!AreActionAssetsLoaded(EAlsActionAssets::Rolling))
+	{
+		// Rolling is not allowed to start until its montage is loaded.
+
+		LoadActionAssetsAsync(EAlsActionAssets::Rolling);
+		return;
+	}
+
 	auto* Montage{SelectRollMontage()};
 
 	if (!ALS_ENSURE(IsValid(Montage)) || !IsRollingAllowedToStart(Montage))
@@ -63,12 +158,14 @@ void AAlsCharacter::StartRolling(const float PlayRate, const float TargetYawAngl
 
 UAnimMontage* AAlsCharacter::SelectRollMontage_Implementation()
 {
-	return Settings->Rolling.Montage;
+	return Settings->Rolling.Montage.Get();
 }
 
 void AAlsCharacter::ServerStartRolling_Implementation(UAnimMontage* Montage, const float PlayRate,
                                                       const float StartYawAngle, const float TargetYawAngle)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::ServerStartRolling_Implementation")
+
 	if (IsRollingAllowedToStart(Montage))
 	{
 		MulticastStartRolling(Montage, PlayRate, StartYawAngle, TargetYawAngle);
@@ -79,12 +176,16 @@ void AAlsCharacter::ServerStartRolling_Implementation(UAnimMontage* Montage, con
 void AAlsCharacter::MulticastStartRolling_Implementation(UAnimMontage* Montage, const float PlayRate,
                                                          const float StartYawAngle, const float TargetYawAngle)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::MulticastStartRolling_Implementation")
+
 	StartRollingImplementation(Montage, PlayRate, StartYawAngle, TargetYawAngle);
 }
 
 void AAlsCharacter::StartRollingImplementation(UAnimMontage* Montage, const float PlayRate,
                                                const float StartYawAngle, const float TargetYawAngle)
 {
+	ALS_CSV_ACCUMULATE(MontageRequests, 1);
+
 	if (IsRollingAllowedToStart(Montage) && GetMesh()->GetAnimInstance()->Montage_Play(Montage, PlayRate))
 	{
 		RollingState.TargetYawAngle = TargetYawAngle;
@@ -97,6 +198,8 @@ void AAlsCharacter::StartRollingImplementation(UAnimMontage* Montage, const floa
 
 void AAlsCharacter::RefreshRolling(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshRolling")
+
 	if (GetLocalRole() <= ROLE_SimulatedProxy ||
 	    GetMesh()->GetAnimInstance()->RootMotionMode <= ERootMotionMode::IgnoreRootMotion)
 	{
@@ -110,6 +213,8 @@ void AAlsCharacter::RefreshRolling(const float DeltaTime)
 // ReSharper disable once CppMemberFunctionMayBeConst
 void AAlsCharacter::RefreshRollingPhysics(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshRollingPhysics")
+
 	if (LocomotionAction != AlsLocomotionActionTags::Rolling)
 	{
 		return;
@@ -135,12 +240,16 @@ void AAlsCharacter::RefreshRollingPhysics(const float DeltaTime)
 
 bool AAlsCharacter::TryStartMantlingGrounded()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::TryStartMantlingGrounded")
+
 	return LocomotionMode == AlsLocomotionModeTags::Grounded &&
 	       TryStartMantling(Settings->Mantling.GroundedTrace);
 }
 
 bool AAlsCharacter::TryStartMantlingInAir()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::TryStartMantlingInAir")
+
 	return LocomotionMode == AlsLocomotionModeTags::InAir && IsLocallyControlled() &&
 	       TryStartMantling(Settings->Mantling.InAirTrace);
 }
@@ -152,11 +261,21 @@ bool AAlsCharacter::IsMantlingAllowedToStart_Implementation() const
 
 bool AAlsCharacter::TryStartMantling(const FAlsMantlingTraceSettings& TraceSettings)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::TryStartMantling")
+
 	if (!Settings->Mantling.bAllowMantling || GetLocalRole() <= ROLE_SimulatedProxy || !IsMantlingAllowedToStart())
 	{
 		return false;
 	}
 
+	if (!AreActionAssetsLoaded(EAlsActionAssets::Mantling))
+	{
+		// Mantling is not allowed to start until its montages are loaded.
+
+		LoadActionAssetsAsync(EAlsActionAssets::Mantling);
+		return false;
+	}
+
 	const auto ActorLocation{GetActorLocation()};
 	const auto ActorYawAngle{UE_REAL_TO_FLOAT(FRotator::NormalizeAxis(GetActorRotation().Yaw))};
 
@@ -214,6 +333,7 @@ bool AAlsCharacter::TryStartMantling(const FAlsMantlingTraceSettings& TraceSetti
 	const auto ForwardTraceCapsuleHalfHeight{LedgeHeightDelta * 0.5f};
 
 	FHitResult ForwardTraceHit;
+	ALS_SCENE_QUERY(MantlingTraces, CostTracker);
 	GetWorld()->SweepSingleByChannel(ForwardTraceHit, ForwardTraceStart, ForwardTraceEnd, FQuat::Identity, ECC_WorldStatic,
 	                                 FCollisionShape::MakeCapsule(TraceCapsuleRadius, ForwardTraceCapsuleHalfHeight),
 	                                 {ForwardTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses);
@@ -260,6 +380,7 @@ bool AAlsCharacter::TryStartMantling(const FAlsMantlingTraceSettings& TraceSetti
 	};
 
 	FHitResult DownwardTraceHit;
+	ALS_SCENE_QUERY(MantlingTraces, CostTracker);
 	GetWorld()->SweepSingleByChannel(DownwardTraceHit, DownwardTraceStart, DownwardTraceEnd, FQuat::Identity,
 	                                 ECC_WorldStatic, FCollisionShape::MakeSphere(TraceCapsuleRadius),
 	                                 {DownwardTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses);
@@ -295,6 +416,8 @@ bool AAlsCharacter::TryStartMantling(const FAlsMantlingTraceSettings& TraceSetti
 
 	const FVector TargetCapsuleLocation{TargetLocation.X, TargetLocation.Y, TargetLocation.Z + CapsuleHalfHeight};
 
+	ALS_SCENE_QUERY(MantlingTraces, CostTracker);
+
 	if (GetWorld()->OverlapBlockingTestByChannel(TargetCapsuleLocation, FQuat::Identity, ECC_WorldStatic,
 	                                             FCollisionShape::MakeCapsule(CapsuleRadius, CapsuleHalfHeight),
 	                                             {FreeSpaceTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses))
@@ -381,6 +504,8 @@ bool AAlsCharacter::TryStartMantling(const FAlsMantlingTraceSettings& TraceSetti
 
 void AAlsCharacter::ServerStartMantling_Implementation(const FAlsMantlingParameters& Parameters)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::ServerStartMantling_Implementation")
+
 	if (IsMantlingAllowedToStart())
 	{
 		MulticastStartMantling(Parameters);
@@ -390,6 +515,8 @@ void AAlsCharacter::ServerStartMantling_Implementation(const FAlsMantlingParamet
 
 void AAlsCharacter::MulticastStartMantling_Implementation(const FAlsMantlingParameters& Parameters)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::MulticastStartMantling_Implementation")
+
 	StartMantlingImplementation(Parameters);
 }
 
@@ -468,9 +595,12 @@ void AAlsCharacter::StartMantlingImplementation(const FAlsMantlingParameters& Pa
 
 	MantlingRootMotionSourceId = GetCharacterMovement()->ApplyRootMotionSource(Mantling);
 
-	// Play the animation montage if valid.
+	// Play the animation montage if valid. The montage is loaded before mantling is allowed to start on the
+	// local machine, but it may not be loaded yet on remote machines, where mantling can't be postponed.
 
-	if (ALS_ENSURE(IsValid(MantlingSettings->Montage)))
+	auto* Montage{MantlingSettings->Montage.LoadSynchronous()};
+
+	if (ALS_ENSURE(IsValid(Montage)))
 	{
 		// TODO Magic. I can't explain why, but this code fixes animation and root motion source desynchronization.
 
@@ -481,7 +611,9 @@ void AAlsCharacter::StartMantlingImplementation(const FAlsMantlingParameters& Pa
 				: StartTime
 		};
 
-		if (GetMesh()->GetAnimInstance()->Montage_Play(MantlingSettings->Montage, PlayRate,
+		ALS_CSV_ACCUMULATE(MontageRequests, 1);
+
+		if (GetMesh()->GetAnimInstance()->Montage_Play(Montage, PlayRate,
 		                                               EMontagePlayReturnType::MontageLength,
 		                                               MontageStartTime, false))
 		{
@@ -501,6 +633,8 @@ void AAlsCharacter::OnMantlingStarted_Implementation(const FAlsMantlingParameter
 
 void AAlsCharacter::RefreshMantling()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshMantling")
+
 	if (MantlingRootMotionSourceId <= 0)
 	{
 		return;
@@ -576,6 +710,8 @@ void AAlsCharacter::StartRagdolling()
 
 void AAlsCharacter::ServerStartRagdolling_Implementation()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::ServerStartRagdolling_Implementation")
+
 	if (IsRagdollingAllowedToStart())
 	{
 		MulticastStartRagdolling();
@@ -585,6 +721,8 @@ void AAlsCharacter::ServerStartRagdolling_Implementation()
 
 void AAlsCharacter::MulticastStartRagdolling_Implementation()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::MulticastStartRagdolling_Implementation")
+
 	StartRagdollingImplementation();
 }
 
@@ -595,6 +733,10 @@ void AAlsCharacter::StartRagdollingImplementation()
 		return;
 	}
 
+	// Warm up the get up montages while the character is ragdolling.
+
+	LoadActionAssetsAsync(EAlsActionAssets::GettingUp);
+
 	GetMesh()->bUpdateJointsFromAnimation = true; // Required for the flail animation to work properly.
 
 	if (!GetMesh()->IsRunningParallelEvaluation() && GetMesh()->GetBoneSpaceTransforms().Num() > 0)
@@ -684,11 +826,15 @@ void AAlsCharacter::SetRagdollTargetLocation(const FVector& NewTargetLocation)
 
 void AAlsCharacter::ServerSetRagdollTargetLocation_Implementation(const FVector_NetQuantize100& NewTargetLocation)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::ServerSetRagdollTargetLocation_Implementation")
+
 	SetRagdollTargetLocation(NewTargetLocation);
 }
 
 void AAlsCharacter::RefreshRagdolling(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshRagdolling")
+
 	if (LocomotionAction != AlsLocomotionActionTags::Ragdolling)
 	{
 		return;
@@ -728,6 +874,8 @@ void AAlsCharacter::RefreshRagdolling(const float DeltaTime)
 
 void AAlsCharacter::RefreshRagdollingActorTransform(const float DeltaTime)
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::RefreshRagdollingActorTransform")
+
 	const auto bLocallyControlled{IsLocallyControlled()};
 	const auto PelvisTransform{GetMesh()->GetSocketTransform(UAlsConstants::PelvisBoneName())};
 
@@ -740,6 +888,7 @@ void AAlsCharacter::RefreshRagdollingActorTransform(const float DeltaTime)
 	// half of the capsule from going through the floor when the ragdoll is laying on the ground.
 
 	FHitResult Hit;
+	ALS_SCENE_QUERY(RagdollingTraces, CostTracker);
 	GetWorld()->LineTraceSingleByChannel(Hit, RagdollTargetLocation, {
 		                                     RagdollTargetLocation.X,
 		                                     RagdollTargetLocation.Y,
@@ -791,6 +940,8 @@ bool AAlsCharacter::IsRagdollingAllowedToStop() const
 
 bool AAlsCharacter::TryStopRagdolling()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::TryStopRagdolling")
+
 	if (GetLocalRole() <= ROLE_SimulatedProxy || !IsRagdollingAllowedToStop())
 	{
 		return false;
@@ -810,6 +961,8 @@ bool AAlsCharacter::TryStopRagdolling()
 
 void AAlsCharacter::ServerStopRagdolling_Implementation()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::ServerStopRagdolling_Implementation")
+
 	if (IsRagdollingAllowedToStop())
 	{
 		MulticastStopRagdolling();
@@ -819,6 +972,8 @@ void AAlsCharacter::ServerStopRagdolling_Implementation()
 
 void AAlsCharacter::MulticastStopRagdolling_Implementation()
 {
+	ALS_TRACE_SCOPE("AAlsCharacter::MulticastStopRagdolling_Implementation")
+
 	StopRagdollingImplementation();
 }
 
@@ -867,6 +1022,8 @@ void AAlsCharacter::StopRagdollingImplementation()
 
 	OnRagdollingEnded();
 
+	ALS_CSV_ACCUMULATE(MontageRequests, 1);
+
 	if (RagdollingState.bGrounded &&
 	    GetMesh()->GetAnimInstance()->Montage_Play(SelectGetUpMontage(RagdollingState.bFacedUpward), 1.0f,
 	                                               EMontagePlayReturnType::MontageLength, 0.0f, true))
@@ -895,7 +1052,10 @@ void AAlsCharacter::FinalizeRagdolling()
 
 UAnimMontage* AAlsCharacter::SelectGetUpMontage_Implementation(const bool bRagdollFacedUpward)
 {
-	return bRagdollFacedUpward ? Settings->Ragdolling.GetUpBackMontage : Settings->Ragdolling.GetUpFrontMontage;
+	// The get up montages start loading together with ragdolling, so they are usually loaded by
+	// now. Otherwise, they have to be loaded synchronously, since getting up can't be postponed.
+
+	return (bRagdollFacedUpward ? Settings->Ragdolling.GetUpBackMontage : Settings->Ragdolling.GetUpFrontMontage).LoadSynchronous();
 }
 
 void AAlsCharacter::OnRagdollingEnded_Implementation() {}
@@ -10,6 +10,7 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Utility/AlsConstants.h"
 #include "Utility/AlsMath.h"
+#include "Utility/AlsMemoryReport.h"
 #include "Utility/AlsUtility.h"
 
 #define LOCTEXT_NAMESPACE "AlsCharacterDebug"
@@ -35,7 +36,9 @@ void AAlsCharacter::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& Displ
 	    !DisplayInfo.IsDisplayOn(UAlsConstants::StateDebugDisplayName()) &&
 	    !DisplayInfo.IsDisplayOn(UAlsConstants::ShapesDebugDisplayName()) &&
 	    !DisplayInfo.IsDisplayOn(UAlsConstants::TracesDebugDisplayName()) &&
-	    !DisplayInfo.IsDisplayOn(UAlsConstants::MantlingDebugDisplayName()))
+	    !DisplayInfo.IsDisplayOn(UAlsConstants::MantlingDebugDisplayName()) &&
+	    !DisplayInfo.IsDisplayOn(UAlsConstants::CostDebugDisplayName()) &&
+	    !DisplayInfo.IsDisplayOn(UAlsConstants::MemoryDebugDisplayName()))
 	{
 		VerticalLocation = MaxVerticalLocation;
 
@@ -125,6 +128,40 @@ void AAlsCharacter::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& Displ
 	VerticalLocation += RowOffset;
 	MaxVerticalLocation = FMath::Max(MaxVerticalLocation, VerticalLocation);
 
+	static const auto CostHeaderText{FText::AsCultureInvariant(FString{TEXTVIEW("Als.Cost (Shift + 9)")})};
+
+	if (DisplayInfo.IsDisplayOn(UAlsConstants::CostDebugDisplayName()))
+	{
+		CostTracker.Request();
+
+		DisplayDebugHeader(Canvas, CostHeaderText, FLinearColor::Green, Scale, HorizontalLocation, VerticalLocation);
+		DisplayDebugCost(Canvas, Scale, HorizontalLocation, VerticalLocation);
+	}
+	else
+	{
+		DisplayDebugHeader(Canvas, CostHeaderText, {0.0f, 0.333333f, 0.0f}, Scale, HorizontalLocation, VerticalLocation);
+	}
+
+	VerticalLocation += RowOffset;
+	MaxVerticalLocation = FMath::Max(MaxVerticalLocation, VerticalLocation);
+
+	// There is no free key left for this page, so it can only be toggled from the console.
+
+	static const auto MemoryHeaderText{FText::AsCultureInvariant(FString{TEXTVIEW("Als.Memory")})};
+
+	if (DisplayInfo.IsDisplayOn(UAlsConstants::MemoryDebugDisplayName()))
+	{
+		DisplayDebugHeader(Canvas, MemoryHeaderText, FLinearColor::Green, Scale, HorizontalLocation, VerticalLocation);
+		DisplayDebugMemory(Canvas, Scale, HorizontalLocation, VerticalLocation);
+	}
+	else
+	{
+		DisplayDebugHeader(Canvas, MemoryHeaderText, {0.0f, 0.333333f, 0.0f}, Scale, HorizontalLocation, VerticalLocation);
+	}
+
+	VerticalLocation += RowOffset;
+	MaxVerticalLocation = FMath::Max(MaxVerticalLocation, VerticalLocation);
+
 	VerticalLocation = MaxVerticalLocation;
 
 	Super::DisplayDebug(Canvas, DisplayInfo, Unused, VerticalLocation);
@@ -624,4 +661,190 @@ void AAlsCharacter::DisplayDebugMantling(const UCanvas* Canvas, const float Scal
 	VerticalLocation += RowOffset;
 }
 
+void AAlsCharacter::DisplayDebugCost(const UCanvas* Canvas, const float Scale,
+                                     const float HorizontalLocation, float& VerticalLocation) const
+{
+	VerticalLocation += 4.0f * Scale;
+
+	FCanvasTextItem Text{
+		FVector2D::ZeroVector,
+		FText::GetEmpty(),
+		GEngine->GetMediumFont(),
+		FLinearColor::White
+	};
+
+	Text.Scale = {Scale * 0.75f, Scale * 0.75f};
+	Text.EnableShadow(FLinearColor::Black);
+
+	const auto RowOffset{12.0f * Scale};
+	const auto ColumnOffset{145.0f * Scale};
+	const auto IndentOffset{10.0f * Scale};
+
+	TStringBuilder<32> ValueBuilder;
+
+	const auto DrawRow{
+		[&](const FString& Label, const float LabelOffset)
+		{
+			Text.Text = FText::AsCultureInvariant(Label);
+			Text.Draw(Canvas->Canvas, {HorizontalLocation + LabelOffset, VerticalLocation});
+
+			Text.Text = FText::AsCultureInvariant(FString{ValueBuilder});
+			Text.Draw(Canvas->Canvas, {HorizontalLocation + ColumnOffset, VerticalLocation});
+
+			ValueBuilder.Reset();
+
+			VerticalLocation += RowOffset;
+		}
+	};
+
+	const auto DrawCostRow{
+		[&](const EAlsCostCategory Category, const float LabelOffset)
+		{
+			ValueBuilder.Appendf(TEXT("%.3f ms"), CostTracker.GetAverageMilliseconds(Category));
+			DrawRow(FAlsCostTracker::GetCategoryName(Category), LabelOffset);
+		}
+	};
+
+	static const auto GameThreadText{LOCTEXT("GameThread", "Game Thread")};
+
+	Text.SetColor(FLinearColor::Gray);
+
+	Text.Text = GameThreadText;
+	Text.Draw(Canvas->Canvas, {HorizontalLocation, VerticalLocation});
+
+	VerticalLocation += RowOffset;
+
+	Text.SetColor(FLinearColor::White);
+
+	DrawCostRow(EAlsCostCategory::CharacterTick, IndentOffset);
+	DrawCostRow(EAlsCostCategory::AnimationUpdate, IndentOffset);
+
+	// The thread safe update runs on a worker thread only if the skeletal mesh allows multi-threaded animation update.
+
+	static const auto AnimationThreadText{LOCTEXT("AnimationThread", "Animation Thread")};
+
+	Text.SetColor(FLinearColor::Gray);
+
+	Text.Text = AnimationThreadText;
+	Text.Draw(Canvas->Canvas, {HorizontalLocation, VerticalLocation});
+
+	VerticalLocation += RowOffset;
+
+	Text.SetColor(FLinearColor::White);
+
+	DrawCostRow(EAlsCostCategory::AnimationThreadSafeUpdate, IndentOffset);
+
+	for (auto i{static_cast<int32>(EAlsCostCategory::AnimationThreadSafeUpdate) + 1}; i < static_cast<int32>(EAlsCostCategory::Count); i++)
+	{
+		DrawCostRow(static_cast<EAlsCostCategory>(i), IndentOffset * 2.0f);
+	}
+
+	VerticalLocation += 4.0f * Scale;
+
+	ValueBuilder << CostTracker.GetSceneQueries();
+	DrawRow(TEXT("Scene Queries"), 0.0f);
+
+	ValueBuilder << CostTracker.GetReplicationUpdates();
+	DrawRow(TEXT("Replication Updates"), 0.0f);
+
+	ValueBuilder << CostTracker.GetRemoteFunctionCalls() << TEXTVIEW(" (") << CostTracker.GetRemoteFunctionBytes() << TEXTVIEW(" B)");
+	DrawRow(TEXT("Remote Function Calls"), 0.0f);
+
+	VerticalLocation += 4.0f * Scale;
+
+	ValueBuilder << GetMesh()->GetPredictedLODLevel();
+	DrawRow(TEXT("Lod"), 0.0f);
+
+	const auto* UpdateRateParameters{GetMesh()->AnimUpdateRateParams};
+
+	if (GetMesh()->bEnableUpdateRateOptimizations && UpdateRateParameters != nullptr)
+	{
+		ValueBuilder << TEXTVIEW("1 / ") << UpdateRateParameters->UpdateRate;
+		DrawRow(TEXT("Update Rate"), 0.0f);
+
+		ValueBuilder << TEXTVIEW("1 / ") << UpdateRateParameters->EvaluationRate;
+		DrawRow(TEXT("Evaluation Rate"), 0.0f);
+	}
+	else
+	{
+		ValueBuilder << TEXTVIEW("1 / 1");
+		DrawRow(TEXT("Update Rate"), 0.0f);
+	}
+}
+
+void AAlsCharacter::DisplayDebugMemory(const UCanvas* Canvas, const float Scale,
+                                       const float HorizontalLocation, float& VerticalLocation) const
+{
+	VerticalLocation += 4.0f * Scale;
+
+	FCanvasTextItem Text{
+		FVector2D::ZeroVector,
+		FText::GetEmpty(),
+		GEngine->GetMediumFont(),
+		FLinearColor::White
+	};
+
+	Text.Scale = {Scale * 0.75f, Scale * 0.75f};
+	Text.EnableShadow(FLinearColor::Black);
+
+	const auto RowOffset{12.0f * Scale};
+	const auto ColumnOffset{260.0f * Scale};
+	const auto IndentOffset{10.0f * Scale};
+
+	FAlsMemoryReport Report;
+	Report.Gather(this);
+
+	TStringBuilder<32> ValueBuilder;
+
+	const auto DrawRow{
+		[&](const FString& Label, const float LabelOffset, const SIZE_T Bytes)
+		{
+			ValueBuilder.Appendf(TEXT("%.1f KB"), static_cast<double>(Bytes) / 1024.0);
+
+			Text.Text = FText::AsCultureInvariant(Label);
+			Text.Draw(Canvas->Canvas, {HorizontalLocation + LabelOffset, VerticalLocation});
+
+			Text.Text = FText::AsCultureInvariant(FString{ValueBuilder});
+			Text.Draw(Canvas->Canvas, {HorizontalLocation + ColumnOffset, VerticalLocation});
+
+			ValueBuilder.Reset();
+
+			VerticalLocation += RowOffset;
+		}
+	};
+
+	for (const auto& Entry : Report.Entries)
+	{
+		DrawRow(Entry.Name, Entry.Depth * IndentOffset, Entry.Bytes);
+	}
+
+	VerticalLocation += 4.0f * Scale;
+
+	Text.SetColor(Report.IsOverBudget() ? FLinearColor::Red : FLinearColor::White);
+
+	const auto BudgetBytes{FAlsMemoryReport::GetCharacterBudgetBytes()};
+
+	DrawRow(BudgetBytes > 0
+		        ? FString::Printf(TEXT("Total (Budget %.1f KB)"), static_cast<double>(BudgetBytes) / 1024.0)
+		        : FString{TEXTVIEW("Total")}, 0.0f, Report.TotalBytes);
+
+	VerticalLocation += 4.0f * Scale;
+
+	static const auto SharedText{LOCTEXT("SharedDataAssets", "Shared Data Assets")};
+
+	Text.SetColor(FLinearColor::Gray);
+
+	Text.Text = SharedText;
+	Text.Draw(Canvas->Canvas, {HorizontalLocation, VerticalLocation});
+
+	VerticalLocation += RowOffset;
+
+	Text.SetColor(FLinearColor::White);
+
+	for (const auto& Entry : Report.SharedEntries)
+	{
+		DrawRow(Entry.Name, IndentOffset, Entry.Bytes);
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
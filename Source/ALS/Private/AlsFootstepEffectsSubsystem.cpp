@@ -0,0 +1,541 @@
+#include "AlsFootstepEffectsSubsystem.h"
+
+#include "NiagaraComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/AudioComponent.h"
+#include "Components/DecalComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "Kismet/GameplayStatics.h"
+#include "Sound/SoundBase.h"
+#include "Utility/AlsCsvProfiler.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsFootstepEffectsSubsystem)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Effects Requested"), STAT_AlsFootstepEffects_Requested, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Effects Downgraded"), STAT_AlsFootstepEffects_Downgraded, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Effects Dropped"), STAT_AlsFootstepEffects_Dropped, STATGROUP_Als)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Footstep Sounds Playing"), STAT_AlsFootstepSounds_Playing, STATGROUP_Als)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Footstep Particle Systems Active"), STAT_AlsFootstepParticleSystems_Active, STATGROUP_Als)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Footstep Decals Live"), STAT_AlsFootstepDecals_Live, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Decals Spawned"), STAT_AlsFootstepDecals_Spawned, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Decals Culled"), STAT_AlsFootstepDecals_Culled, STATGROUP_Als)
+
+namespace AlsFootstepEffectsSubsystem
+{
+	TAutoConsoleVariable<int32> MaxSoundsPerFrame{
+		TEXT("als.FootstepEffects.MaxSoundsPerFrame"), 8,
+		TEXT("Maximum number of footstep sounds spawned per frame. The nearest and most significant footsteps are spawned first."),
+		ECVF_Scalability
+	};
+
+	TAutoConsoleVariable<int32> MaxParticleSystemsPerFrame{
+		TEXT("als.FootstepEffects.MaxParticleSystemsPerFrame"), 8,
+		TEXT("Maximum number of footstep particle systems spawned per frame. The nearest and most significant footsteps are spawned first."),
+		ECVF_Scalability
+	};
+
+	TAutoConsoleVariable<int32> MaxConcurrentSoundsPerView{
+		TEXT("als.FootstepEffects.MaxConcurrentSoundsPerView"), 24,
+		TEXT("Maximum number of concurrently playing footstep sounds per local view."),
+		ECVF_Scalability
+	};
+
+	TAutoConsoleVariable<int32> MaxConcurrentParticleSystemsPerView{
+		TEXT("als.FootstepEffects.MaxConcurrentParticleSystemsPerView"), 24,
+		TEXT("Maximum number of concurrently active footstep particle systems per local view."),
+		ECVF_Scalability
+	};
+
+	TAutoConsoleVariable<float> FullEffectsDistance{
+		TEXT("als.FootstepEffects.FullEffectsDistance"), 2500.0f,
+		TEXT("Footsteps farther than this distance from the nearest local view only spawn sounds, without decals and particle systems. ")
+		TEXT("0 disables downgrading."),
+		ECVF_Scalability
+	};
+
+	TAutoConsoleVariable<float> MaxDistance{
+		TEXT("als.FootstepEffects.MaxDistance"), 6000.0f,
+		TEXT("Footsteps farther than this distance from the nearest local view don't spawn any effects. 0 disables culling."),
+		ECVF_Scalability
+	};
+
+	TAutoConsoleVariable<float> NotRenderedDistanceScale{
+		TEXT("als.FootstepEffects.NotRenderedDistanceScale"), 2.0f,
+		TEXT("Distance multiplier for footsteps of characters that were not recently rendered, which makes them less significant."),
+		ECVF_Scalability
+	};
+
+	TAutoConsoleVariable<int32> MaxDecals{
+		TEXT("als.FootstepEffects.MaxDecals"), 64,
+		TEXT("Maximum number of live footstep decals per world. The oldest decal is reused when this budget is exhausted."),
+		ECVF_Scalability
+	};
+
+	TAutoConsoleVariable<float> DecalCullDistance{
+		TEXT("als.FootstepEffects.DecalCullDistance"), 5000.0f,
+		TEXT("Footstep decals farther than this distance from all local player cameras are not spawned. 0 disables culling."),
+		ECVF_Scalability
+	};
+}
+
+void UAlsFootstepEffectsSubsystem::Deinitialize()
+{
+	for (auto& PooledDecal : Decals)
+	{
+		if (IsValid(PooledDecal.Decal))
+		{
+			PooledDecal.Decal->DestroyComponent();
+		}
+	}
+
+	Decals.Reset();
+	ActiveDecalsCount = 0;
+
+	Requests.Reset();
+	ActiveSounds.Reset();
+	ActiveParticleSystems.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UAlsFootstepEffectsSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsFootstepEffectsSubsystem, STATGROUP_Tickables);
+}
+
+bool UAlsFootstepEffectsSubsystem::IsTickableInEditor() const
+{
+	// Required to spawn queued effects in animation editor preview worlds.
+
+	return true;
+}
+
+void UAlsFootstepEffectsSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (ActiveDecalsCount > 0)
+	{
+		// Hide fully faded out decals so that they no longer cost anything to render.
+
+		const auto Time{GetWorld()->GetTimeSeconds()};
+
+		for (auto& PooledDecal : Decals)
+		{
+			if (PooledDecal.bActive && PooledDecal.ExpirationTime <= Time)
+			{
+				DeactivateDecal(PooledDecal);
+			}
+		}
+	}
+
+	ProcessRequests();
+
+	SET_DWORD_STAT(STAT_AlsFootstepSounds_Playing, ActiveSounds.Num());
+	SET_DWORD_STAT(STAT_AlsFootstepParticleSystems_Active, ActiveParticleSystems.Num());
+	SET_DWORD_STAT(STAT_AlsFootstepDecals_Live, ActiveDecalsCount);
+}
+
+bool UAlsFootstepEffectsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Also support animation editor preview worlds, since footstep notifies are triggered there too.
+
+	return Super::DoesSupportWorldType(WorldType) || WorldType == EWorldType::EditorPreview || WorldType == EWorldType::GamePreview;
+}
+
+void UAlsFootstepEffectsSubsystem::QueueEffects(const FAlsFootstepEffectsRequest& Request)
+{
+	if (IsValid(Request.Sound) || IsValid(Request.DecalMaterial) || IsValid(Request.ParticleSystem))
+	{
+		INC_DWORD_STAT(STAT_AlsFootstepEffects_Requested);
+		ALS_CSV_ACCUMULATE(FootstepEffectsRequested, 1);
+
+		Requests.Add(Request);
+	}
+}
+
+bool UAlsFootstepEffectsSubsystem::IsWithinViewDistance(const FVector& Location, const float MaxDistance) const
+{
+	auto bAnyViewFound{false};
+
+	for (auto Iterator{GetWorld()->GetPlayerControllerIterator()}; Iterator; ++Iterator)
+	{
+		const auto* Player{Iterator->Get()};
+		if (!IsValid(Player) || !Player->IsLocalController() || !IsValid(Player->PlayerCameraManager))
+		{
+			continue;
+		}
+
+		if (FVector::DistSquared(Player->PlayerCameraManager->GetCameraLocation(), Location) <= FMath::Square(MaxDistance))
+		{
+			return true;
+		}
+
+		bAnyViewFound = true;
+	}
+
+	// If there are no local views, such as in animation editor previews, then there is nothing to cull against.
+
+	return !bAnyViewFound;
+}
+
+UDecalComponent* UAlsFootstepEffectsSubsystem::SpawnDecal(UMaterialInterface* Material, const FVector& Size, const FVector& Location,
+                                                          const FRotator& Rotation, USceneComponent* AttachParent,
+                                                          const float Duration, const float FadeOutDuration)
+{
+	const auto CullDistance{AlsFootstepEffectsSubsystem::DecalCullDistance.GetValueOnGameThread()};
+	if (CullDistance > UE_SMALL_NUMBER && !IsWithinViewDistance(Location, CullDistance))
+	{
+		INC_DWORD_STAT(STAT_AlsFootstepDecals_Culled);
+		ALS_CSV_ACCUMULATE(FootstepEffectsCulled, 1);
+		return nullptr;
+	}
+
+	ResizeDecalsPool(FMath::Max(0, AlsFootstepEffectsSubsystem::MaxDecals.GetValueOnGameThread()));
+
+	if (Decals.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	auto* World{GetWorld()};
+
+	auto& PooledDecal{Decals[NextDecalIndex]};
+	NextDecalIndex = (NextDecalIndex + 1) % Decals.Num();
+
+	if (!IsValid(PooledDecal.Decal))
+	{
+		if (PooledDecal.bActive)
+		{
+			DeactivateDecal(PooledDecal);
+		}
+
+		PooledDecal.Decal = NewObject<UDecalComponent>(World->GetWorldSettings());
+		PooledDecal.Decal->bAllowAnyoneToDestroyMe = true;
+		PooledDecal.Decal->SetUsingAbsoluteScale(true);
+		PooledDecal.Decal->RegisterComponentWithWorld(World);
+	}
+
+	if (!PooledDecal.bActive)
+	{
+		PooledDecal.bActive = true;
+		ActiveDecalsCount += 1;
+	}
+
+	auto* Decal{PooledDecal.Decal.Get()};
+
+	if (IsValid(AttachParent))
+	{
+		Decal->AttachToComponent(AttachParent, FAttachmentTransformRules::KeepWorldTransform);
+	}
+	else if (IsValid(Decal->GetAttachParent()))
+	{
+		Decal->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	}
+
+	Decal->DecalSize = Size;
+	Decal->SetDecalMaterial(Material);
+	Decal->SetWorldLocationAndRotation(Location, Rotation);
+	Decal->SetVisibility(true);
+
+	Decal->SetFadeOut(Duration, FadeOutDuration, false);
+
+	// The pool itself manages the lifetime of decals, so prevent them from destroying themselves after fading out.
+
+	Decal->SetLifeSpan(0.0f);
+
+	PooledDecal.ExpirationTime = Duration > 0.0f || FadeOutDuration > 0.0f
+		                             ? World->GetTimeSeconds() + Duration + FadeOutDuration
+		                             : TNumericLimits<double>::Max();
+
+	INC_DWORD_STAT(STAT_AlsFootstepDecals_Spawned);
+	ALS_CSV_ACCUMULATE(FootstepEffectsSpawned, 1);
+
+	return Decal;
+}
+
+void UAlsFootstepEffectsSubsystem::ProcessRequests()
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsFootstepEffectsSubsystem::ProcessRequests()"),
+	                            STAT_UAlsFootstepEffectsSubsystem_ProcessRequests, STATGROUP_Als)
+
+	static const auto IsEffectInactive{
+		[](const FAlsActiveFootstepEffect& Effect)
+		{
+			return !Effect.Component.IsValid() || !Effect.Component->IsActive();
+		}
+	};
+
+	ActiveSounds.RemoveAllSwap(IsEffectInactive, false);
+	ActiveParticleSystems.RemoveAllSwap(IsEffectInactive, false);
+
+	if (Requests.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+
+	for (auto Iterator{GetWorld()->GetPlayerControllerIterator()}; Iterator; ++Iterator)
+	{
+		const auto* Player{Iterator->Get()};
+		if (IsValid(Player) && Player->IsLocalController() && IsValid(Player->PlayerCameraManager))
+		{
+			ViewLocations.Add(Player->PlayerCameraManager->GetCameraLocation());
+		}
+	}
+
+	// Rank requests by the distance to the nearest view. If there are no local views, such as in
+	// animation editor previews, then all requests have the same priority and nothing is culled.
+
+	const auto NotRenderedDistanceScale{AlsFootstepEffectsSubsystem::NotRenderedDistanceScale.GetValueOnGameThread()};
+
+	for (auto& Request : Requests)
+	{
+		if (ViewLocations.IsEmpty())
+		{
+			continue;
+		}
+
+		auto NearestDistanceSquared{TNumericLimits<double>::Max()};
+
+		for (auto i{0}; i < ViewLocations.Num(); i++)
+		{
+			const auto DistanceSquared{FVector::DistSquared(ViewLocations[i], Request.FootstepLocation)};
+			if (DistanceSquared < NearestDistanceSquared)
+			{
+				NearestDistanceSquared = DistanceSquared;
+				Request.ViewIndex = i;
+			}
+		}
+
+		Request.Priority = FMath::Sqrt(NearestDistanceSquared);
+
+		const auto* Mesh{Request.Mesh.Get()};
+		if (IsValid(Mesh) && !Mesh->WasRecentlyRendered())
+		{
+			Request.Priority *= NotRenderedDistanceScale;
+		}
+	}
+
+	Requests.Sort([](const FAlsFootstepEffectsRequest& A, const FAlsFootstepEffectsRequest& B)
+	{
+		return A.Priority < B.Priority;
+	});
+
+	TArray<int32, TInlineAllocator<4>> ViewsSoundsCounts;
+	ViewsSoundsCounts.SetNumZeroed(FMath::Max(1, ViewLocations.Num()));
+
+	for (const auto& Sound : ActiveSounds)
+	{
+		if (ViewsSoundsCounts.IsValidIndex(Sound.ViewIndex))
+		{
+			ViewsSoundsCounts[Sound.ViewIndex] += 1;
+		}
+	}
+
+	TArray<int32, TInlineAllocator<4>> ViewsParticleSystemsCounts;
+	ViewsParticleSystemsCounts.SetNumZeroed(FMath::Max(1, ViewLocations.Num()));
+
+	for (const auto& ParticleSystem : ActiveParticleSystems)
+	{
+		if (ViewsParticleSystemsCounts.IsValidIndex(ParticleSystem.ViewIndex))
+		{
+			ViewsParticleSystemsCounts[ParticleSystem.ViewIndex] += 1;
+		}
+	}
+
+	const auto MaxDistance{AlsFootstepEffectsSubsystem::MaxDistance.GetValueOnGameThread()};
+	const auto FullEffectsDistance{AlsFootstepEffectsSubsystem::FullEffectsDistance.GetValueOnGameThread()};
+
+	const auto MaxSoundsPerFrame{AlsFootstepEffectsSubsystem::MaxSoundsPerFrame.GetValueOnGameThread()};
+	const auto MaxParticleSystemsPerFrame{AlsFootstepEffectsSubsystem::MaxParticleSystemsPerFrame.GetValueOnGameThread()};
+
+	const auto MaxConcurrentSoundsPerView{AlsFootstepEffectsSubsystem::MaxConcurrentSoundsPerView.GetValueOnGameThread()};
+	const auto MaxConcurrentParticleSystemsPerView{
+		AlsFootstepEffectsSubsystem::MaxConcurrentParticleSystemsPerView.GetValueOnGameThread()
+	};
+
+	auto SoundsCount{0};
+	auto ParticleSystemsCount{0};
+
+	for (auto& Request : Requests)
+	{
+		if (MaxDistance > UE_SMALL_NUMBER && Request.Priority > MaxDistance)
+		{
+			INC_DWORD_STAT(STAT_AlsFootstepEffects_Dropped);
+			ALS_CSV_ACCUMULATE(FootstepEffectsCulled, 1);
+			continue;
+		}
+
+		if (FullEffectsDistance > UE_SMALL_NUMBER && Request.Priority > FullEffectsDistance &&
+		    (IsValid(Request.DecalMaterial) || IsValid(Request.ParticleSystem)))
+		{
+			INC_DWORD_STAT(STAT_AlsFootstepEffects_Downgraded);
+			ALS_CSV_ACCUMULATE(FootstepEffectsDowngraded, 1);
+
+			Request.DecalMaterial = nullptr;
+			Request.ParticleSystem = nullptr;
+		}
+
+		if (IsValid(Request.Sound))
+		{
+			if (SoundsCount < MaxSoundsPerFrame && ViewsSoundsCounts[Request.ViewIndex] < MaxConcurrentSoundsPerView)
+			{
+				SoundsCount += 1;
+				ViewsSoundsCounts[Request.ViewIndex] += 1;
+
+				auto* Audio{SpawnSound(Request)};
+				if (IsValid(Audio))
+				{
+					ALS_CSV_ACCUMULATE(FootstepEffectsSpawned, 1);
+
+					ActiveSounds.Add({Audio, Request.ViewIndex});
+				}
+			}
+			else
+			{
+				INC_DWORD_STAT(STAT_AlsFootstepEffects_Dropped);
+				ALS_CSV_ACCUMULATE(FootstepEffectsCulled, 1);
+			}
+		}
+
+		if (IsValid(Request.DecalMaterial))
+		{
+			SpawnDecal(Request.DecalMaterial, Request.DecalSize, Request.DecalLocation, Request.DecalRotation,
+			           Request.DecalAttachParent.Get(), Request.DecalDuration, Request.DecalFadeOutDuration);
+		}
+
+		if (IsValid(Request.ParticleSystem))
+		{
+			if (ParticleSystemsCount < MaxParticleSystemsPerFrame &&
+			    ViewsParticleSystemsCounts[Request.ViewIndex] < MaxConcurrentParticleSystemsPerView)
+			{
+				ParticleSystemsCount += 1;
+				ViewsParticleSystemsCounts[Request.ViewIndex] += 1;
+
+				auto* ParticleSystem{SpawnParticleSystem(Request)};
+				if (IsValid(ParticleSystem))
+				{
+					ALS_CSV_ACCUMULATE(FootstepEffectsSpawned, 1);
+
+					ActiveParticleSystems.Add({ParticleSystem, Request.ViewIndex});
+				}
+			}
+			else
+			{
+				INC_DWORD_STAT(STAT_AlsFootstepEffects_Dropped);
+				ALS_CSV_ACCUMULATE(FootstepEffectsCulled, 1);
+			}
+		}
+	}
+
+	Requests.Reset();
+}
+
+UAudioComponent* UAlsFootstepEffectsSubsystem::SpawnSound(const FAlsFootstepEffectsRequest& Request) const
+{
+	auto* World{GetWorld()};
+	UAudioComponent* Audio{nullptr};
+
+	switch (Request.SoundSpawnMode)
+	{
+		case EAlsFootstepSoundSpawnMode::SpawnAtTraceHitLocation:
+			if (World->WorldType == EWorldType::EditorPreview)
+			{
+				UGameplayStatics::PlaySoundAtLocation(World, Request.Sound, Request.FootstepLocation,
+				                                      Request.SoundVolumeMultiplier, Request.SoundPitchMultiplier);
+			}
+			else
+			{
+				Audio = UGameplayStatics::SpawnSoundAtLocation(World, Request.Sound, Request.FootstepLocation,
+				                                               Request.FootstepRotation, Request.SoundVolumeMultiplier,
+				                                               Request.SoundPitchMultiplier);
+			}
+			break;
+
+		case EAlsFootstepSoundSpawnMode::SpawnAttachedToFootBone:
+			if (Request.Mesh.IsValid())
+			{
+				Audio = UGameplayStatics::SpawnSoundAttached(Request.Sound, Request.Mesh.Get(), Request.FootBoneName,
+				                                             FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::SnapToTarget,
+				                                             true, Request.SoundVolumeMultiplier, Request.SoundPitchMultiplier);
+			}
+			break;
+	}
+
+	if (IsValid(Audio))
+	{
+		Audio->SetIntParameter(FName{TEXTVIEW("FootstepType")}, static_cast<int32>(Request.SoundType));
+	}
+
+	return Audio;
+}
+
+UNiagaraComponent* UAlsFootstepEffectsSubsystem::SpawnParticleSystem(const FAlsFootstepEffectsRequest& Request) const
+{
+	switch (Request.ParticleSystemSpawnMode)
+	{
+		case EAlsFootstepParticleEffectSpawnMode::SpawnAtTraceHitLocation:
+			return UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), Request.ParticleSystem,
+			                                                      Request.ParticleSystemLocation, Request.ParticleSystemRotation,
+			                                                      Request.ParticleSystemScale, true, true, ENCPoolMethod::AutoRelease);
+
+		case EAlsFootstepParticleEffectSpawnMode::SpawnAttachedToFootBone:
+			if (Request.Mesh.IsValid())
+			{
+				return UNiagaraFunctionLibrary::SpawnSystemAttached(Request.ParticleSystem, Request.Mesh.Get(), Request.FootBoneName,
+				                                                    Request.ParticleSystemLocation, Request.ParticleSystemRotation,
+				                                                    Request.ParticleSystemScale, EAttachLocation::KeepRelativeOffset,
+				                                                    true, ENCPoolMethod::AutoRelease);
+			}
+			break;
+	}
+
+	return nullptr;
+}
+
+void UAlsFootstepEffectsSubsystem::ResizeDecalsPool(const int32 NewSize)
+{
+	if (Decals.Num() == NewSize)
+	{
+		return;
+	}
+
+	for (auto i{NewSize}; i < Decals.Num(); i++)
+	{
+		if (Decals[i].bActive)
+		{
+			DeactivateDecal(Decals[i]);
+		}
+
+		if (IsValid(Decals[i].Decal))
+		{
+			Decals[i].Decal->DestroyComponent();
+		}
+	}
+
+	Decals.SetNum(NewSize);
+
+	if (NextDecalIndex >= NewSize)
+	{
+		NextDecalIndex = 0;
+	}
+}
+
+void UAlsFootstepEffectsSubsystem::DeactivateDecal(FAlsPooledFootstepDecal& PooledDecal)
+{
+	PooledDecal.bActive = false;
+	ActiveDecalsCount -= 1;
+
+	if (IsValid(PooledDecal.Decal))
+	{
+		PooledDecal.Decal->SetVisibility(false);
+		PooledDecal.Decal->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	}
+}
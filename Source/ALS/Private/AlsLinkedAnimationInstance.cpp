@@ -48,6 +48,13 @@ void UAlsLinkedAnimationInstance::NativeBeginPlay()
 	Super::NativeBeginPlay();
 }
 
+void UAlsLinkedAnimationInstance::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(sizeof(FAlsAnimationInstanceProxy));
+}
+
 FAnimInstanceProxy* UAlsLinkedAnimationInstance::CreateAnimInstanceProxy()
 {
 	return new FAlsAnimationInstanceProxy{this};
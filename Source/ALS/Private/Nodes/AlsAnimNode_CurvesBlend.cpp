@@ -1,10 +1,79 @@
 #include "Nodes/AlsAnimNode_CurvesBlend.h"
 
+#include "Animation/AnimClassInterface.h"
+#include "Animation/AnimNode_SequencePlayer.h"
+#include "Animation/AnimSequenceBase.h"
 #include "Animation/AnimTrace.h"
+#include "AnimNodes/AnimNode_SequenceEvaluator.h"
 #include "Utility/AlsEnumUtility.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimNode_CurvesBlend)
 
+namespace AlsCurvesBlend
+{
+	FAnimNode_AssetPlayerBase* FindLinkedSequencePlayer(const FAnimationBaseContext& Context, FPoseLink& PoseLink)
+	{
+		const auto* LinkedNode{PoseLink.GetLinkNode()};
+		const auto* AnimationClass{Context.AnimInstanceProxy->GetAnimClassInterface()};
+
+		if (LinkedNode == nullptr || AnimationClass == nullptr)
+		{
+			return nullptr;
+		}
+
+		// Animation nodes don't have run-time type information, so find the node property of the linked node to check its type.
+
+		auto* AnimationInstance{Context.AnimInstanceProxy->GetAnimInstanceObject()};
+
+		for (const auto& NodeProperty : AnimationClass->GetAnimNodeProperties())
+		{
+			if (NodeProperty->ContainerPtrToValuePtr<FAnimNode_Base>(AnimationInstance) != LinkedNode)
+			{
+				continue;
+			}
+
+			const auto* NodeStruct{NodeProperty->Struct.Get()};
+
+			return NodeStruct->IsChildOf(FAnimNode_SequencePlayerBase::StaticStruct()) ||
+			       NodeStruct->IsChildOf(FAnimNode_SequenceEvaluatorBase::StaticStruct())
+				       ? NodeProperty->ContainerPtrToValuePtr<FAnimNode_AssetPlayerBase>(AnimationInstance)
+				       : nullptr;
+		}
+
+		return nullptr;
+	}
+
+	void BlendCurves(FBlendedCurve& Curve, const FBlendedCurve& CurvesPoseCurve, const EAlsCurvesBlendMode BlendMode, const float BlendAmount)
+	{
+		switch (BlendMode)
+		{
+			case EAlsCurvesBlendMode::BlendByAmount:
+				Curve.Accumulate(CurvesPoseCurve, BlendAmount);
+				break;
+
+			case EAlsCurvesBlendMode::Combine:
+				Curve.Combine(CurvesPoseCurve);
+				break;
+
+			case EAlsCurvesBlendMode::CombinePreserved:
+				Curve.CombinePreserved(CurvesPoseCurve);
+				break;
+
+			case EAlsCurvesBlendMode::UseMaxValue:
+				Curve.UseMaxValue(CurvesPoseCurve);
+				break;
+
+			case EAlsCurvesBlendMode::UseMinValue:
+				Curve.UseMinValue(CurvesPoseCurve);
+				break;
+
+			case EAlsCurvesBlendMode::Override:
+				Curve.Override(CurvesPoseCurve);
+				break;
+		}
+	}
+}
+
 void FAlsAnimNode_CurvesBlend::Initialize_AnyThread(const FAnimationInitializeContext& Context)
 {
 	DECLARE_SCOPE_HIERARCHICAL_COUNTER_ANIMNODE(Initialize_AnyThread)
@@ -13,6 +82,8 @@ void FAlsAnimNode_CurvesBlend::Initialize_AnyThread(const FAnimationInitializeCo
 
 	SourcePose.Initialize(Context);
 	CurvesPose.Initialize(Context);
+
+	CurvesAssetPlayer = bEvaluateCurvesOnly ? AlsCurvesBlend::FindLinkedSequencePlayer(Context, CurvesPose) : nullptr;
 }
 
 void FAlsAnimNode_CurvesBlend::CacheBones_AnyThread(const FAnimationCacheBonesContext& Context)
@@ -59,35 +130,34 @@ void FAlsAnimNode_CurvesBlend::Evaluate_AnyThread(FPoseContext& Output)
 		return;
 	}
 
-	auto CurvesPoseContext{Output};
-	CurvesPose.Evaluate(CurvesPoseContext);
-
-	switch (GetBlendMode())
+	if (CurvesAssetPlayer != nullptr)
 	{
-		case EAlsCurvesBlendMode::BlendByAmount:
-			Output.Curve.Accumulate(CurvesPoseContext.Curve, CurrentBlendAmount);
-			break;
+		const auto* Sequence{Cast<UAnimSequenceBase>(CurvesAssetPlayer->GetAnimAsset())};
+		if (IsValid(Sequence))
+		{
+			// Evaluate only the sequence curves. The sequence player itself has already
+			// been updated, so its accumulated time is the current evaluation time.
 
-		case EAlsCurvesBlendMode::Combine:
-			Output.Curve.Combine(CurvesPoseContext.Curve);
-			break;
+			FBlendedCurve Curve;
+			Curve.InitFrom(Output.AnimInstanceProxy->GetRequiredBones());
 
-		case EAlsCurvesBlendMode::CombinePreserved:
-			Output.Curve.CombinePreserved(CurvesPoseContext.Curve);
-			break;
+			Sequence->EvaluateCurveData(Curve, CurvesAssetPlayer->GetAccumulatedTime());
 
-		case EAlsCurvesBlendMode::UseMaxValue:
-			Output.Curve.UseMaxValue(CurvesPoseContext.Curve);
-			break;
+			AlsCurvesBlend::BlendCurves(Output.Curve, Curve, GetBlendMode(), CurrentBlendAmount);
 
-		case EAlsCurvesBlendMode::UseMinValue:
-			Output.Curve.UseMinValue(CurvesPoseContext.Curve);
-			break;
-
-		case EAlsCurvesBlendMode::Override:
-			Output.Curve.Override(CurvesPoseContext.Curve);
-			break;
+			TRACE_ANIM_NODE_VALUE(Output, TEXT("Curves Only"), true);
+			TRACE_ANIM_NODE_VALUE(Output, TEXT("Saved Pose Memory (Bytes)"),
+			                      static_cast<int32>(Output.Pose.GetNumBones() * sizeof(FTransform)));
+			return;
+		}
 	}
+
+	auto CurvesPoseContext{Output};
+	CurvesPose.Evaluate(CurvesPoseContext);
+
+	AlsCurvesBlend::BlendCurves(Output.Curve, CurvesPoseContext.Curve, GetBlendMode(), CurrentBlendAmount);
+
+	TRACE_ANIM_NODE_VALUE(Output, TEXT("Curves Only"), false);
 }
 
 void FAlsAnimNode_CurvesBlend::GatherDebugData(FNodeDebugData& DebugData)
@@ -0,0 +1,446 @@
+#include "Nodes/AlsAnimNode_FootIk.h"
+
+#include "AlsAnimationInstance.h"
+#include "AnimationRuntime.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "Animation/AnimTrace.h"
+#include "RigVMFunctions/Math/RigVMMathLibrary.h"
+#include "Utility/AlsMath.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimNode_FootIk)
+
+// All constants below are taken from the ALS control rig (CR_Als) to keep both paths in sync.
+
+namespace AlsAnimNode_FootIk
+{
+	static constexpr auto DiagonalScaleAmount{0.4f};
+
+	// Leg length ratios at which the pelvis offset reaches its minimum and maximum.
+	static constexpr auto PelvisOffsetMinLegLengthRatio{0.6f};
+	static constexpr auto PelvisOffsetMaxLegLengthRatio{0.4f};
+
+	static constexpr auto PelvisOffsetSpringStrength{0.2f};
+	static constexpr auto PelvisOffsetSpringCriticalDamping{3.0f};
+	static constexpr auto PelvisOffsetSpringTargetVelocityAmount{0.75f};
+
+	// Foot ik locations are kept slightly closer than the leg length, so that the legs never become fully straight.
+	static constexpr auto FootIkMaxLegLengthRatio{0.99f};
+
+	static constexpr auto LegPoleDistance{40.0f};
+	static constexpr auto LegPoleInterpolationSpeed{15.0f};
+
+	FVector GetReferenceLocation(const FBoneContainer& RequiredBones, const FBoneReference& Bone)
+	{
+		return FAnimationRuntime::GetComponentSpaceTransformRefPose(RequiredBones.GetReferenceSkeleton(), Bone.BoneIndex).GetLocation();
+	}
+
+	FTransform GetTransform(FCSPose<FCompactPose>& Pose, const FBoneReference& Bone)
+	{
+		return Pose.GetComponentSpaceTransform(Bone.GetCompactPoseIndex(Pose.GetPose().GetBoneContainer()));
+	}
+
+	FVector CalculateLegPoleLocation(FCSPose<FCompactPose>& Pose, const FAlsFootIkLimbBones& Leg)
+	{
+		// Same as the Calculate Pole Vector rig unit, including the fallback to the reference pose.
+
+		const auto& RequiredBones{Pose.GetPose().GetBoneContainer()};
+
+		auto LowerLocation{GetTransform(Pose, Leg.LowerBone).GetLocation()};
+		FVector ProjectionLocation, Direction;
+
+		if (!UAlsMath::TryCalculatePoleVector(GetTransform(Pose, Leg.UpperBone).GetLocation(), LowerLocation,
+		                                      GetTransform(Pose, Leg.EndBone).GetLocation(), ProjectionLocation, Direction))
+		{
+			LowerLocation = GetReferenceLocation(RequiredBones, Leg.LowerBone);
+
+			if (!UAlsMath::TryCalculatePoleVector(GetReferenceLocation(RequiredBones, Leg.UpperBone), LowerLocation,
+			                                      GetReferenceLocation(RequiredBones, Leg.EndBone), ProjectionLocation, Direction))
+			{
+				Direction = FVector::ForwardVector;
+			}
+		}
+
+		return LowerLocation + Direction * LegPoleDistance;
+	}
+
+	FVector ClampFootIkLocation(FCSPose<FCompactPose>& Pose, const FAlsFootIkLimbBones& Leg, const FVector& FootIkLocation)
+	{
+		const auto ThighLocation{GetTransform(Pose, Leg.UpperBone).GetLocation()};
+
+		return ThighLocation + (FootIkLocation - ThighLocation).GetClampedToMaxSize(Leg.GetLength() * FootIkMaxLegLengthRatio);
+	}
+}
+
+void FAlsFootIkLimbBones::Initialize(const FBoneContainer& RequiredBones)
+{
+	UpperBone.Initialize(RequiredBones);
+	LowerBone.Initialize(RequiredBones);
+	EndBone.Initialize(RequiredBones);
+
+	// The control rig also measures limbs in the reference pose, so the lengths don't depend on the animated pose.
+
+	if (UpperBone.HasValidSetup() && LowerBone.HasValidSetup() && EndBone.HasValidSetup())
+	{
+		const auto UpperLocation{AlsAnimNode_FootIk::GetReferenceLocation(RequiredBones, UpperBone)};
+		const auto LowerLocation{AlsAnimNode_FootIk::GetReferenceLocation(RequiredBones, LowerBone)};
+
+		UpperLength = UE_REAL_TO_FLOAT(FVector::Distance(UpperLocation, LowerLocation));
+		LowerLength = UE_REAL_TO_FLOAT(FVector::Distance(LowerLocation, AlsAnimNode_FootIk::GetReferenceLocation(RequiredBones, EndBone)));
+	}
+	else
+	{
+		UpperLength = 0.0f;
+		LowerLength = 0.0f;
+	}
+}
+
+bool FAlsFootIkLimbBones::IsValidToEvaluate(const FBoneContainer& RequiredBones) const
+{
+	return UpperBone.IsValidToEvaluate(RequiredBones) &&
+	       LowerBone.IsValidToEvaluate(RequiredBones) &&
+	       EndBone.IsValidToEvaluate(RequiredBones) &&
+	       UpperLength > UE_SMALL_NUMBER && LowerLength > UE_SMALL_NUMBER;
+}
+
+void FAlsAnimNode_FootIk::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_ANIMNODE(Initialize_AnyThread)
+
+	Super::Initialize_AnyThread(Context);
+
+	PelvisOffsetZ = 0.0f;
+	PelvisOffsetSpringState.Reset();
+
+	bLegPoleLocationsInitialized = false;
+}
+
+void FAlsAnimNode_FootIk::GatherDebugData(FNodeDebugData& DebugData)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_ANIMNODE(GatherDebugData)
+
+	TStringBuilder<256> DebugItemBuilder;
+
+	DebugItemBuilder << DebugData.GetNodeName(this) << TEXTVIEW(": Pelvis Offset Z: ");
+	DebugItemBuilder.Appendf(TEXT("%.2f"), PelvisOffsetZ);
+	DebugItemBuilder << TEXTVIEW(", Foot Ik Amount: ");
+	DebugItemBuilder.Appendf(TEXT("%.2f / %.2f"), Input.FootLeftIkAmount, Input.FootRightIkAmount);
+
+	DebugData.AddDebugItem(FString{DebugItemBuilder});
+	ComponentPose.GatherDebugData(DebugData);
+}
+
+void FAlsAnimNode_FootIk::UpdateInternal(const FAnimationUpdateContext& Context)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_ANIMNODE(UpdateInternal)
+
+	Super::UpdateInternal(Context);
+
+	DeltaTime = Context.GetDeltaTime();
+
+	const auto* AnimationInstance{Cast<UAlsAnimationInstance>(Context.AnimInstanceProxy->GetAnimInstanceObject())};
+	if (IsValid(AnimationInstance))
+	{
+		Input = AnimationInstance->GetControlRigInput();
+	}
+
+	TRACE_ANIM_NODE_VALUE(Context, TEXT("Foot Left Ik Amount"), Input.FootLeftIkAmount);
+	TRACE_ANIM_NODE_VALUE(Context, TEXT("Foot Right Ik Amount"), Input.FootRightIkAmount);
+	TRACE_ANIM_NODE_VALUE(Context, TEXT("Spine Yaw Angle"), Input.SpineYawAngle);
+}
+
+void FAlsAnimNode_FootIk::InitializeBoneReferences(const FBoneContainer& RequiredBones)
+{
+	InitializeRig(RequiredBones);
+}
+
+void FAlsAnimNode_FootIk::InitializeRig(const FBoneContainer& RequiredBones)
+{
+	PelvisBone.Initialize(RequiredBones);
+
+	LeftLeg.Initialize(RequiredBones);
+	RightLeg.Initialize(RequiredBones);
+
+	for (auto& Bone : SpineBones)
+	{
+		Bone.Initialize(RequiredBones);
+	}
+
+	FootRootBone.Initialize(RequiredBones);
+	FootIkRootBone.Initialize(RequiredBones);
+
+	LeftArm.Initialize(RequiredBones);
+	RightArm.Initialize(RequiredBones);
+
+	HandLeftTargetBone.Initialize(RequiredBones);
+	HandLeftIkTargetBone.Initialize(RequiredBones);
+	HandRightTargetBone.Initialize(RequiredBones);
+	HandRightIkTargetBone.Initialize(RequiredBones);
+
+	const auto* Skeleton{RequiredBones.GetSkeletonAsset()};
+	if (IsValid(Skeleton))
+	{
+		PoseMovingCurveUid = Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, UAlsConstants::PoseMovingCurveName());
+		LayerArmLeftCurveUid = Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, UAlsConstants::LayerArmLeftCurveName());
+		LayerArmRightCurveUid = Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, UAlsConstants::LayerArmRightCurveName());
+		HandLeftIkCurveUid = Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, UAlsConstants::HandLeftIkCurveName());
+		HandRightIkCurveUid = Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, UAlsConstants::HandRightIkCurveName());
+	}
+
+	BoneTransforms.Reset(3);
+}
+
+bool FAlsAnimNode_FootIk::IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones)
+{
+	return PelvisBone.IsValidToEvaluate(RequiredBones) &&
+	       LeftLeg.IsValidToEvaluate(RequiredBones) &&
+	       RightLeg.IsValidToEvaluate(RequiredBones);
+}
+
+void FAlsAnimNode_FootIk::EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_ANIMNODE(EvaluateSkeletalControl_AnyThread)
+
+	EvaluateRig(Output.Pose, Output.Curve);
+}
+
+void FAlsAnimNode_FootIk::EvaluateRig(FCSPose<FCompactPose>& Pose, const FBlendedCurve& Curve)
+{
+	// Each step depends on the result of the previous one, so the bone transforms are applied to
+	// the pose right after each step instead of being returned in a single batch through OutBoneTransforms.
+	// Setting a component space transform keeps the local transforms of child bones, just like the control rig does.
+
+	RefreshDiagonalScaling(Pose, Curve);
+	RefreshPelvisOffset(Pose);
+	RefreshSpineRotation(Pose);
+	RefreshHandIk(Pose, Curve);
+	RefreshFootIk(Pose);
+}
+
+void FAlsAnimNode_FootIk::ApplyTransforms(FCSPose<FCompactPose>& Pose)
+{
+	if (BoneTransforms.Num() > 0)
+	{
+		Pose.LocalBlendCSBoneTransforms(BoneTransforms, ActualAlpha);
+		BoneTransforms.Reset();
+	}
+}
+
+void FAlsAnimNode_FootIk::RefreshDiagonalScaling(FCSPose<FCompactPose>& Pose, const FBlendedCurve& Curve)
+{
+	const auto& RequiredBones{Pose.GetPose().GetBoneContainer()};
+
+	const auto& Bone{Input.bUseFootIkBones ? FootIkRootBone : FootRootBone};
+	if (!Bone.IsValidToEvaluate(RequiredBones))
+	{
+		return;
+	}
+
+	const auto Weight{Curve.Get(PoseMovingCurveUid)};
+	if (Weight < UE_SMALL_NUMBER)
+	{
+		return;
+	}
+
+	// The foot root bone is scaled the most when moving diagonally, i.e. when both velocity blend amounts are close to 0.25.
+
+	const auto DiagonalAmount{1.0f - FMath::Abs((Input.VelocityBlendForwardAmount + Input.VelocityBlendBackwardAmount - 0.5f) * 2.0f)};
+
+	const auto BoneIndex{Bone.GetCompactPoseIndex(RequiredBones)};
+
+	auto LocalTransform{Pose.GetLocalSpaceTransform(BoneIndex)};
+	const auto Scale{LocalTransform.GetScale3D()};
+
+	LocalTransform.SetScale3D(FMath::Lerp(Scale, Scale + FVector{AlsAnimNode_FootIk::DiagonalScaleAmount * DiagonalAmount,
+	                                                             AlsAnimNode_FootIk::DiagonalScaleAmount * DiagonalAmount, 0.0f},
+	                                      Weight));
+
+	const auto ParentIndex{Pose.GetPose().GetParentBoneIndex(BoneIndex)};
+
+	BoneTransforms.Emplace(BoneIndex, ParentIndex.IsValid()
+		                                  ? LocalTransform * Pose.GetComponentSpaceTransform(ParentIndex)
+		                                  : LocalTransform);
+	ApplyTransforms(Pose);
+}
+
+void FAlsAnimNode_FootIk::RefreshPelvisOffset(FCSPose<FCompactPose>& Pose)
+{
+	const auto Weight{(Input.FootLeftIkAmount + Input.FootRightIkAmount) * 0.5f};
+	if (FMath::IsNearlyZero(Weight, 0.001f))
+	{
+		return;
+	}
+
+	// The pelvis is lowered when one of the feet can't reach its ik location, and raised when one of the legs is bent too much.
+
+	const auto LeftLegLengthRatio{
+		FVector::Distance(AlsAnimNode_FootIk::GetTransform(Pose, LeftLeg.UpperBone).GetLocation(), Input.FootLeftIkLocation) /
+		LeftLeg.GetLength()
+	};
+
+	const auto RightLegLengthRatio{
+		FVector::Distance(Input.FootRightIkLocation, AlsAnimNode_FootIk::GetTransform(Pose, RightLeg.UpperBone).GetLocation()) /
+		RightLeg.GetLength()
+	};
+
+	const auto TargetPelvisOffsetZ{
+		FMath::GetMappedRangeValueClamped(FVector2f{AlsAnimNode_FootIk::PelvisOffsetMinLegLengthRatio,
+		                                            AlsAnimNode_FootIk::PelvisOffsetMaxLegLengthRatio},
+		                                  FVector2f{Input.MinMaxPelvisOffsetZ},
+		                                  UE_REAL_TO_FLOAT(FMath::Min(LeftLegLengthRatio, RightLegLengthRatio)))
+	};
+
+	// Same as the Spring Interpolate rig unit, which treats its strength as a frequency in hertz.
+
+	const auto AngularFrequency{AlsAnimNode_FootIk::PelvisOffsetSpringStrength * UE_TWO_PI};
+
+	PelvisOffsetZ = UKismetMathLibrary::FloatSpringInterp(PelvisOffsetZ, TargetPelvisOffsetZ, PelvisOffsetSpringState,
+	                                                      FMath::Square(AngularFrequency),
+	                                                      AlsAnimNode_FootIk::PelvisOffsetSpringCriticalDamping, DeltaTime, 1.0f,
+	                                                      AlsAnimNode_FootIk::PelvisOffsetSpringTargetVelocityAmount,
+	                                                      false, 0.0f, 0.0f, true);
+
+	const auto BoneIndex{PelvisBone.GetCompactPoseIndex(Pose.GetPose().GetBoneContainer())};
+
+	auto Transform{Pose.GetComponentSpaceTransform(BoneIndex)};
+	Transform.AddToTranslation({0.0f, 0.0f, PelvisOffsetZ * Weight});
+
+	BoneTransforms.Emplace(BoneIndex, Transform);
+	ApplyTransforms(Pose);
+}
+
+void FAlsAnimNode_FootIk::RefreshSpineRotation(FCSPose<FCompactPose>& Pose)
+{
+	if (SpineBones.Num() <= 0 || FMath::IsNearlyZero(Input.SpineYawAngle, 0.001f))
+	{
+		return;
+	}
+
+	const auto& RequiredBones{Pose.GetPose().GetBoneContainer()};
+
+	const auto DeltaRotation{FRotator{0.0f, Input.SpineYawAngle / SpineBones.Num(), 0.0f}.Quaternion()};
+
+	// Spine bones are rotated one by one, since each rotation changes the component space transforms of the next bones.
+
+	for (const auto& Bone : SpineBones)
+	{
+		if (!Bone.IsValidToEvaluate(RequiredBones))
+		{
+			continue;
+		}
+
+		const auto BoneIndex{Bone.GetCompactPoseIndex(RequiredBones)};
+
+		auto Transform{Pose.GetComponentSpaceTransform(BoneIndex)};
+		Transform.SetRotation(DeltaRotation * Transform.GetRotation());
+
+		BoneTransforms.Emplace(BoneIndex, Transform);
+		ApplyTransforms(Pose);
+	}
+}
+
+void FAlsAnimNode_FootIk::RefreshHandIk(FCSPose<FCompactPose>& Pose, const FBlendedCurve& Curve)
+{
+	const auto& RequiredBones{Pose.GetPose().GetBoneContainer()};
+
+	const auto& HandLeftTarget{Input.bUseHandIkBones ? HandLeftIkTargetBone : HandLeftTargetBone};
+	if (LeftArm.IsValidToEvaluate(RequiredBones) && HandLeftTarget.IsValidToEvaluate(RequiredBones))
+	{
+		const auto PoleLocation{
+			AlsAnimNode_FootIk::GetTransform(Pose, LeftArm.LowerBone).TransformPositionNoScale(LeftArmPoleLocation)
+		};
+
+		SolveTwoBoneIk(Pose, LeftArm, AlsAnimNode_FootIk::GetTransform(Pose, HandLeftTarget), PoleLocation,
+		               Curve.Get(LayerArmLeftCurveUid) * Curve.Get(HandLeftIkCurveUid));
+	}
+
+	const auto& HandRightTarget{Input.bUseHandIkBones ? HandRightIkTargetBone : HandRightTargetBone};
+	if (RightArm.IsValidToEvaluate(RequiredBones) && HandRightTarget.IsValidToEvaluate(RequiredBones))
+	{
+		const auto PoleLocation{
+			AlsAnimNode_FootIk::GetTransform(Pose, RightArm.LowerBone).TransformPositionNoScale(RightArmPoleLocation)
+		};
+
+		SolveTwoBoneIk(Pose, RightArm, AlsAnimNode_FootIk::GetTransform(Pose, HandRightTarget), PoleLocation,
+		               Curve.Get(LayerArmRightCurveUid) * Curve.Get(HandRightIkCurveUid));
+	}
+}
+
+void FAlsAnimNode_FootIk::RefreshFootIk(FCSPose<FCompactPose>& Pose)
+{
+	// Pole locations are smoothed on every evaluation, even when foot ik is disabled, just like in the control rig.
+
+	const auto NewLeftLegPoleLocation{AlsAnimNode_FootIk::CalculateLegPoleLocation(Pose, LeftLeg)};
+	const auto NewRightLegPoleLocation{AlsAnimNode_FootIk::CalculateLegPoleLocation(Pose, RightLeg)};
+
+	if (!bLegPoleLocationsInitialized)
+	{
+		LeftLegPoleLocation = NewLeftLegPoleLocation;
+		RightLegPoleLocation = NewRightLegPoleLocation;
+
+		bLegPoleLocationsInitialized = true;
+	}
+
+	LeftLegPoleLocation = UAlsMath::ExponentialDecay(LeftLegPoleLocation, NewLeftLegPoleLocation,
+	                                                 DeltaTime, AlsAnimNode_FootIk::LegPoleInterpolationSpeed);
+
+	RightLegPoleLocation = UAlsMath::ExponentialDecay(RightLegPoleLocation, NewRightLegPoleLocation,
+	                                                  DeltaTime, AlsAnimNode_FootIk::LegPoleInterpolationSpeed);
+
+	SolveTwoBoneIk(Pose, LeftLeg, FTransform{
+		               Input.FootLeftIkRotation,
+		               AlsAnimNode_FootIk::ClampFootIkLocation(Pose, LeftLeg, Input.FootLeftIkLocation)
+	               }, LeftLegPoleLocation, Input.FootLeftIkAmount);
+
+	SolveTwoBoneIk(Pose, RightLeg, FTransform{
+		               Input.FootRightIkRotation,
+		               AlsAnimNode_FootIk::ClampFootIkLocation(Pose, RightLeg, Input.FootRightIkLocation)
+	               }, RightLegPoleLocation, Input.FootRightIkAmount);
+}
+
+void FAlsAnimNode_FootIk::SolveTwoBoneIk(FCSPose<FCompactPose>& Pose, const FAlsFootIkLimbBones& Limb,
+                                         const FTransform& EffectorTransform, const FVector& PoleLocation, const float Weight)
+{
+	// Same as the Basic IK rig unit without stretching.
+
+	if (Weight < UE_SMALL_NUMBER)
+	{
+		return;
+	}
+
+	const auto& RequiredBones{Pose.GetPose().GetBoneContainer()};
+
+	const auto UpperIndex{Limb.UpperBone.GetCompactPoseIndex(RequiredBones)};
+	const auto LowerIndex{Limb.LowerBone.GetCompactPoseIndex(RequiredBones)};
+	const auto EndIndex{Limb.EndBone.GetCompactPoseIndex(RequiredBones)};
+
+	auto UpperTransform{Pose.GetComponentSpaceTransform(UpperIndex)};
+	auto LowerTransform{Pose.GetComponentSpaceTransform(LowerIndex)};
+	auto EndTransform{EffectorTransform};
+
+	FRigVMMathLibrary::SolveBasicTwoBoneIK(UpperTransform, LowerTransform, EndTransform, PoleLocation,
+	                                       Limb.PrimaryAxis, Limb.SecondaryAxis, 1.0f,
+	                                       Limb.UpperLength, Limb.LowerLength, false, 1.0f, 1.0f);
+
+	if (Weight < 1.0f - UE_SMALL_NUMBER)
+	{
+		const auto LowerLocation{UpperTransform.InverseTransformPosition(LowerTransform.GetLocation())};
+		const auto EndLocation{LowerTransform.InverseTransformPosition(EndTransform.GetLocation())};
+
+		UpperTransform.SetRotation(FQuat::Slerp(Pose.GetComponentSpaceTransform(UpperIndex).GetRotation(),
+		                                        UpperTransform.GetRotation(), Weight));
+
+		LowerTransform.SetRotation(FQuat::Slerp(Pose.GetComponentSpaceTransform(LowerIndex).GetRotation(),
+		                                        LowerTransform.GetRotation(), Weight));
+
+		EndTransform.SetRotation(FQuat::Slerp(Pose.GetComponentSpaceTransform(EndIndex).GetRotation(),
+		                                      EndTransform.GetRotation(), Weight));
+
+		LowerTransform.SetLocation(UpperTransform.TransformPosition(LowerLocation));
+		EndTransform.SetLocation(LowerTransform.TransformPosition(EndLocation));
+	}
+
+	BoneTransforms.Emplace(UpperIndex, UpperTransform);
+	BoneTransforms.Emplace(LowerIndex, LowerTransform);
+	BoneTransforms.Emplace(EndIndex, EndTransform);
+	ApplyTransforms(Pose);
+}
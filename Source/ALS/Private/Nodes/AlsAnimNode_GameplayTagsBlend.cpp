@@ -2,13 +2,37 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimNode_GameplayTagsBlend)
 
+void FAlsAnimNode_GameplayTagsBlend::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+	const auto& CurrentTags{GetTags()};
+
+	TagIndices.Reset();
+	TagIndices.Reserve(CurrentTags.Num());
+
+	for (auto i{0}; i < CurrentTags.Num(); i++)
+	{
+		// The first pose is the default one, so tag poses start at index 1. If a tag
+		// is listed more than once, the first occurrence wins, just like in TArray::Find().
+
+		if (CurrentTags[i].IsValid() && !TagIndices.Contains(CurrentTags[i]))
+		{
+			TagIndices.Emplace(CurrentTags[i], i + 1);
+		}
+	}
+
+	Super::Initialize_AnyThread(Context);
+}
+
 int32 FAlsAnimNode_GameplayTagsBlend::GetActiveChildIndex()
 {
 	const auto& CurrentActiveTag{GetActiveTag()};
+	if (!CurrentActiveTag.IsValid())
+	{
+		return 0;
+	}
 
-	return CurrentActiveTag.IsValid()
-		       ? GetTags().Find(CurrentActiveTag) + 1
-		       : 0;
+	const auto* Index{TagIndices.Find(CurrentActiveTag)};
+	return Index != nullptr ? *Index : 0;
 }
 
 const FGameplayTag& FAlsAnimNode_GameplayTagsBlend::GetActiveTag() const
@@ -0,0 +1,349 @@
+#include "Nodes/AlsAnimNode_LayeringBlend.h"
+
+#include "AnimationRuntime.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "Animation/AnimTrace.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimNode_LayeringBlend)
+
+namespace AlsLayeringBlend
+{
+	constexpr auto RegionsCount{static_cast<int32>(EAlsLayeringBoneRegion::HandRight) + 1};
+
+	struct FRegionBlendAmounts
+	{
+		// Blend amount between the base pose and the overlay pose.
+		float BlendAmount{0.0f};
+
+		// Amount of the base pose additive applied on top of the overlay pose.
+		float AdditiveBlendAmount{0.0f};
+
+		// Blend amount between the mesh space additive and the local space additive.
+		float LocalSpaceBlendAmount{1.0f};
+
+		// Blend amount between the layered pose and the unmodified overlay pose.
+		float HandBlendAmount{0.0f};
+
+		float SlotBlendAmount{0.0f};
+	};
+
+	void GetRegionBlendAmounts(const FAlsLayeringState& LayeringState, const float SlotWeight,
+	                           TStaticArray<FRegionBlendAmounts, RegionsCount>& Amounts)
+	{
+		auto& Pelvis{Amounts[static_cast<int32>(EAlsLayeringBoneRegion::Pelvis)]};
+		Pelvis.BlendAmount = LayeringState.PelvisBlendAmount;
+		Pelvis.SlotBlendAmount = LayeringState.PelvisSlotBlendAmount * SlotWeight;
+
+		auto& Legs{Amounts[static_cast<int32>(EAlsLayeringBoneRegion::Legs)]};
+		Legs.BlendAmount = LayeringState.LegsBlendAmount;
+		Legs.SlotBlendAmount = LayeringState.LegsSlotBlendAmount * SlotWeight;
+
+		auto& Spine{Amounts[static_cast<int32>(EAlsLayeringBoneRegion::Spine)]};
+		Spine.BlendAmount = LayeringState.SpineBlendAmount;
+		Spine.AdditiveBlendAmount = LayeringState.SpineAdditiveBlendAmount;
+		Spine.LocalSpaceBlendAmount = 0.0f;
+		Spine.SlotBlendAmount = LayeringState.SpineSlotBlendAmount * SlotWeight;
+
+		auto& Head{Amounts[static_cast<int32>(EAlsLayeringBoneRegion::Head)]};
+		Head.BlendAmount = LayeringState.HeadBlendAmount;
+		Head.AdditiveBlendAmount = LayeringState.HeadAdditiveBlendAmount;
+		Head.SlotBlendAmount = LayeringState.HeadSlotBlendAmount * SlotWeight;
+
+		auto& ArmLeft{Amounts[static_cast<int32>(EAlsLayeringBoneRegion::ArmLeft)]};
+		ArmLeft.BlendAmount = LayeringState.ArmLeftBlendAmount;
+		ArmLeft.AdditiveBlendAmount = LayeringState.ArmLeftAdditiveBlendAmount;
+		ArmLeft.LocalSpaceBlendAmount = LayeringState.ArmLeftLocalSpaceBlendAmount;
+		ArmLeft.SlotBlendAmount = LayeringState.ArmLeftSlotBlendAmount * SlotWeight;
+
+		auto& ArmRight{Amounts[static_cast<int32>(EAlsLayeringBoneRegion::ArmRight)]};
+		ArmRight.BlendAmount = LayeringState.ArmRightBlendAmount;
+		ArmRight.AdditiveBlendAmount = LayeringState.ArmRightAdditiveBlendAmount;
+		ArmRight.LocalSpaceBlendAmount = LayeringState.ArmRightLocalSpaceBlendAmount;
+		ArmRight.SlotBlendAmount = LayeringState.ArmRightSlotBlendAmount * SlotWeight;
+
+		auto& HandLeft{Amounts[static_cast<int32>(EAlsLayeringBoneRegion::HandLeft)]};
+		HandLeft = ArmLeft;
+		HandLeft.HandBlendAmount = LayeringState.HandLeftBlendAmount;
+
+		auto& HandRight{Amounts[static_cast<int32>(EAlsLayeringBoneRegion::HandRight)]};
+		HandRight = ArmRight;
+		HandRight.HandBlendAmount = LayeringState.HandRightBlendAmount;
+	}
+}
+
+void FAlsAnimNode_LayeringBlend::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_ANIMNODE(Initialize_AnyThread)
+
+	Super::Initialize_AnyThread(Context);
+
+	BasePose.Initialize(Context);
+	BaseReferencePose.Initialize(Context);
+	OverlayPose.Initialize(Context);
+	SlotPose.Initialize(Context);
+
+	SlotWeight = 0.0f;
+}
+
+void FAlsAnimNode_LayeringBlend::CacheBones_AnyThread(const FAnimationCacheBonesContext& Context)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_ANIMNODE(CacheBones_AnyThread)
+
+	Super::CacheBones_AnyThread(Context);
+
+	BasePose.CacheBones(Context);
+	BaseReferencePose.CacheBones(Context);
+	OverlayPose.CacheBones(Context);
+	SlotPose.CacheBones(Context);
+
+	const auto& RequiredBones{Context.AnimInstanceProxy->GetRequiredBones()};
+
+	BoneRegions.Reset();
+	BoneRegions.SetNumZeroed(RequiredBones.GetCompactPoseNumBones());
+
+	const auto MarkRegionRoot{
+		[this, &RequiredBones](FBoneReference& Bone, const EAlsLayeringBoneRegion Region)
+		{
+			// A bone that exists in the skeleton can still be missing from the required bones, for example
+			// when it is removed by the bone reduction of a lower LOD, so it is also checked for evaluation.
+
+			if (Bone.Initialize(RequiredBones) && Bone.IsValidToEvaluate(RequiredBones))
+			{
+				BoneRegions[Bone.GetCompactPoseIndex(RequiredBones).GetInt()] = Region;
+			}
+		}
+	};
+
+	MarkRegionRoot(PelvisBone, EAlsLayeringBoneRegion::Pelvis);
+	MarkRegionRoot(LegLeftBone, EAlsLayeringBoneRegion::Legs);
+	MarkRegionRoot(LegRightBone, EAlsLayeringBoneRegion::Legs);
+	MarkRegionRoot(SpineBone, EAlsLayeringBoneRegion::Spine);
+	MarkRegionRoot(HeadBone, EAlsLayeringBoneRegion::Head);
+	MarkRegionRoot(ArmLeftBone, EAlsLayeringBoneRegion::ArmLeft);
+	MarkRegionRoot(ArmRightBone, EAlsLayeringBoneRegion::ArmRight);
+	MarkRegionRoot(HandLeftBone, EAlsLayeringBoneRegion::HandLeft);
+	MarkRegionRoot(HandRightBone, EAlsLayeringBoneRegion::HandRight);
+
+	// Parent bones always precede their children in the compact pose, so in a single pass each
+	// bone that is not a region root inherits the region of its nearest region root ancestor.
+
+	for (auto i{1}; i < BoneRegions.Num(); i++)
+	{
+		if (BoneRegions[i] == EAlsLayeringBoneRegion::None)
+		{
+			const auto ParentIndex{RequiredBones.GetParentBoneIndex(FCompactPoseBoneIndex{i})};
+			if (ParentIndex.IsValid())
+			{
+				BoneRegions[i] = BoneRegions[ParentIndex.GetInt()];
+			}
+		}
+	}
+}
+
+void FAlsAnimNode_LayeringBlend::Update_AnyThread(const FAnimationUpdateContext& Context)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_ANIMNODE(Update_AnyThread)
+
+	Super::Update_AnyThread(Context);
+
+	GetEvaluateGraphExposedInputs().Execute(Context);
+
+	BasePose.Update(Context);
+
+	const auto OverlayBlendAmount{GetMaxOverlayBlendAmount()};
+	if (FAnimWeight::IsRelevant(OverlayBlendAmount))
+	{
+		OverlayPose.Update(Context.FractionalWeight(OverlayBlendAmount));
+
+		const auto AdditiveBlendAmount{GetMaxAdditiveBlendAmount()};
+		if (FAnimWeight::IsRelevant(AdditiveBlendAmount))
+		{
+			BaseReferencePose.Update(Context.FractionalWeight(AdditiveBlendAmount));
+		}
+	}
+
+	// The slot pose is always updated, otherwise its slot node will not be registered
+	// and montages playing in that slot will not be able to blend in.
+
+	SlotWeight = Context.AnimInstanceProxy->GetSlotMontageLocalWeight(SlotName);
+
+	SlotPose.Update(Context.FractionalWeight(SlotWeight * GetMaxSlotBlendAmount()));
+
+	TRACE_ANIM_NODE_VALUE(Context, TEXT("Overlay Blend Amount"), OverlayBlendAmount);
+	TRACE_ANIM_NODE_VALUE(Context, TEXT("Slot Weight"), SlotWeight);
+}
+
+void FAlsAnimNode_LayeringBlend::Evaluate_AnyThread(FPoseContext& Output)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_ANIMNODE(Evaluate_AnyThread)
+
+	Super::Evaluate_AnyThread(Output);
+
+	BasePose.Evaluate(Output);
+
+	const auto bOverlayRelevant{FAnimWeight::IsRelevant(GetMaxOverlayBlendAmount())};
+	const auto bSlotRelevant{FAnimWeight::IsRelevant(SlotWeight * GetMaxSlotBlendAmount())};
+
+	if (!bOverlayRelevant && !bSlotRelevant)
+	{
+		return;
+	}
+
+	TStaticArray<AlsLayeringBlend::FRegionBlendAmounts, AlsLayeringBlend::RegionsCount> Amounts;
+	AlsLayeringBlend::GetRegionBlendAmounts(LayeringState, SlotWeight, Amounts);
+
+	FPoseContext OverlayPoseContext{Output};
+	if (bOverlayRelevant)
+	{
+		OverlayPose.Evaluate(OverlayPoseContext);
+
+		Output.Curve.Combine(OverlayPoseContext.Curve);
+	}
+
+	FPoseContext SlotPoseContext{Output};
+	if (bSlotRelevant)
+	{
+		SlotPose.Evaluate(SlotPoseContext);
+
+		Output.Curve.Combine(SlotPoseContext.Curve);
+	}
+
+	// Additives are calculated only if at least one region actually uses them.
+
+	auto bLocalSpaceAdditiveRequired{false};
+	auto bMeshSpaceAdditiveRequired{false};
+
+	if (bOverlayRelevant)
+	{
+		for (const auto& RegionAmounts : Amounts)
+		{
+			if (FAnimWeight::IsRelevant(RegionAmounts.BlendAmount) && FAnimWeight::IsRelevant(RegionAmounts.AdditiveBlendAmount))
+			{
+				bLocalSpaceAdditiveRequired |= FAnimWeight::IsRelevant(RegionAmounts.LocalSpaceBlendAmount);
+				bMeshSpaceAdditiveRequired |= !FAnimWeight::IsFullWeight(RegionAmounts.LocalSpaceBlendAmount);
+			}
+		}
+	}
+
+	FCompactPose LocalSpaceAdditivePose;
+	FCompactPose MeshSpaceAdditiveOverlayPose;
+
+	if (bLocalSpaceAdditiveRequired || bMeshSpaceAdditiveRequired)
+	{
+		FPoseContext BaseReferencePoseContext{Output};
+		BaseReferencePose.Evaluate(BaseReferencePoseContext);
+
+		if (bLocalSpaceAdditiveRequired)
+		{
+			LocalSpaceAdditivePose = Output.Pose;
+			FAnimationRuntime::ConvertPoseToAdditive(LocalSpaceAdditivePose, BaseReferencePoseContext.Pose);
+		}
+
+		if (bMeshSpaceAdditiveRequired)
+		{
+			// The mesh space additive can't be applied per bone, since it depends on the whole bone
+			// chain, so it is applied at full weight to a copy of the overlay pose and blended later.
+
+			FPoseContext MeshSpaceAdditivePoseContext{Output};
+			MeshSpaceAdditivePoseContext.Pose = Output.Pose;
+
+			FAnimationRuntime::ConvertPoseToMeshRotationSpace(MeshSpaceAdditivePoseContext.Pose);
+			FAnimationRuntime::ConvertPoseToMeshRotationSpace(BaseReferencePoseContext.Pose);
+			FAnimationRuntime::ConvertPoseToAdditive(MeshSpaceAdditivePoseContext.Pose, BaseReferencePoseContext.Pose);
+
+			FPoseContext MeshSpaceAdditiveOverlayPoseContext{Output};
+			MeshSpaceAdditiveOverlayPoseContext.Pose = OverlayPoseContext.Pose;
+
+			FAnimationPoseData MeshSpaceAdditiveOverlayPoseData{MeshSpaceAdditiveOverlayPoseContext};
+			FAnimationRuntime::AccumulateMeshSpaceRotationAdditiveToLocalPose(
+				MeshSpaceAdditiveOverlayPoseData, FAnimationPoseData{MeshSpaceAdditivePoseContext}, 1.0f);
+
+			MeshSpaceAdditiveOverlayPose = MoveTemp(MeshSpaceAdditiveOverlayPoseContext.Pose);
+		}
+	}
+
+	for (const auto BoneIndex : Output.Pose.ForEachBoneIndex())
+	{
+		const auto Region{BoneRegions.IsValidIndex(BoneIndex.GetInt()) ? BoneRegions[BoneIndex.GetInt()] : EAlsLayeringBoneRegion::None};
+		if (Region == EAlsLayeringBoneRegion::None)
+		{
+			continue;
+		}
+
+		const auto& RegionAmounts{Amounts[static_cast<int32>(Region)]};
+		auto& Transform{Output.Pose[BoneIndex]};
+
+		if (bOverlayRelevant && FAnimWeight::IsRelevant(RegionAmounts.BlendAmount))
+		{
+			const auto& OverlayTransform{OverlayPoseContext.Pose[BoneIndex]};
+			auto LayeredTransform{OverlayTransform};
+
+			if (FAnimWeight::IsRelevant(RegionAmounts.AdditiveBlendAmount))
+			{
+				auto LocalSpaceTransform{OverlayTransform};
+				auto MeshSpaceTransform{OverlayTransform};
+
+				if (FAnimWeight::IsRelevant(RegionAmounts.LocalSpaceBlendAmount))
+				{
+					FTransform::BlendFromIdentityAndAccumulate(LocalSpaceTransform, LocalSpaceAdditivePose[BoneIndex],
+					                                           ScalarRegister{RegionAmounts.AdditiveBlendAmount});
+				}
+
+				if (!FAnimWeight::IsFullWeight(RegionAmounts.LocalSpaceBlendAmount))
+				{
+					MeshSpaceTransform.Blend(OverlayTransform, MeshSpaceAdditiveOverlayPose[BoneIndex], RegionAmounts.AdditiveBlendAmount);
+				}
+
+				LayeredTransform.Blend(MeshSpaceTransform, LocalSpaceTransform, RegionAmounts.LocalSpaceBlendAmount);
+			}
+
+			if (FAnimWeight::IsRelevant(RegionAmounts.HandBlendAmount))
+			{
+				LayeredTransform.BlendWith(OverlayTransform, RegionAmounts.HandBlendAmount);
+			}
+
+			Transform.BlendWith(LayeredTransform, RegionAmounts.BlendAmount);
+		}
+
+		if (bSlotRelevant && FAnimWeight::IsRelevant(RegionAmounts.SlotBlendAmount))
+		{
+			Transform.BlendWith(SlotPoseContext.Pose[BoneIndex], RegionAmounts.SlotBlendAmount);
+		}
+
+		Transform.NormalizeRotation();
+	}
+}
+
+void FAlsAnimNode_LayeringBlend::GatherDebugData(FNodeDebugData& DebugData)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_ANIMNODE(GatherDebugData)
+
+	TStringBuilder<256> DebugItemBuilder;
+
+	DebugItemBuilder << DebugData.GetNodeName(this) << TEXTVIEW(": Slot Weight: ");
+	DebugItemBuilder.Appendf(TEXT("%.2f"), SlotWeight);
+
+	DebugData.AddDebugItem(FString{DebugItemBuilder});
+	BasePose.GatherDebugData(DebugData.BranchFlow(1.0f));
+	BaseReferencePose.GatherDebugData(DebugData.BranchFlow(GetMaxAdditiveBlendAmount()));
+	OverlayPose.GatherDebugData(DebugData.BranchFlow(GetMaxOverlayBlendAmount()));
+	SlotPose.GatherDebugData(DebugData.BranchFlow(SlotWeight * GetMaxSlotBlendAmount()));
+}
+
+float FAlsAnimNode_LayeringBlend::GetMaxOverlayBlendAmount() const
+{
+	return FMath::Max(FMath::Max3(LayeringState.HeadBlendAmount, LayeringState.ArmLeftBlendAmount, LayeringState.ArmRightBlendAmount),
+	                  FMath::Max3(LayeringState.SpineBlendAmount, LayeringState.PelvisBlendAmount, LayeringState.LegsBlendAmount));
+}
+
+float FAlsAnimNode_LayeringBlend::GetMaxAdditiveBlendAmount() const
+{
+	return FMath::Max(FMath::Max(LayeringState.HeadAdditiveBlendAmount, LayeringState.SpineAdditiveBlendAmount),
+	                  FMath::Max(LayeringState.ArmLeftAdditiveBlendAmount, LayeringState.ArmRightAdditiveBlendAmount));
+}
+
+float FAlsAnimNode_LayeringBlend::GetMaxSlotBlendAmount() const
+{
+	return FMath::Max(FMath::Max3(LayeringState.HeadSlotBlendAmount, LayeringState.ArmLeftSlotBlendAmount, LayeringState.ArmRightSlotBlendAmount),
+	                  FMath::Max3(LayeringState.SpineSlotBlendAmount, LayeringState.PelvisSlotBlendAmount, LayeringState.LegsSlotBlendAmount));
+}
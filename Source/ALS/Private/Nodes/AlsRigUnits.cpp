@@ -4,6 +4,34 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsRigUnits)
 
+namespace AlsRigUnits
+{
+	FVector CalculateHandIkRetargetingOffset(const URigHierarchy* Hierarchy,
+	                                         const FCachedRigElement& LeftHandBone, const FCachedRigElement& LeftHandIkBone,
+	                                         const FCachedRigElement& RightHandBone, const FCachedRigElement& RightHandIkBone,
+	                                         const float RetargetingWeight)
+	{
+		if (FAnimWeight::IsFullWeight(RetargetingWeight))
+		{
+			return Hierarchy->GetGlobalTransform(RightHandBone).GetLocation() -
+			       Hierarchy->GetGlobalTransform(RightHandIkBone).GetLocation();
+		}
+
+		if (!FAnimWeight::IsRelevant(RetargetingWeight))
+		{
+			return Hierarchy->GetGlobalTransform(LeftHandBone).GetLocation() -
+			       Hierarchy->GetGlobalTransform(LeftHandIkBone).GetLocation();
+		}
+
+		return FMath::Lerp(Hierarchy->GetGlobalTransform(LeftHandBone).GetLocation(),
+		                   Hierarchy->GetGlobalTransform(RightHandBone).GetLocation(),
+		                   RetargetingWeight) -
+		       FMath::Lerp(Hierarchy->GetGlobalTransform(LeftHandIkBone).GetLocation(),
+		                   Hierarchy->GetGlobalTransform(RightHandIkBone).GetLocation(),
+		                   RetargetingWeight);
+	}
+}
+
 void FAlsRigVMFunction_ExponentialDecayVector::Initialize()
 {
 	bInitialized = false;
@@ -21,36 +49,6 @@ FAlsRigVMFunction_ExponentialDecayVector_Execute()
 	Current = UAlsMath::ExponentialDecay(Current, Target, ExecuteContext.GetDeltaTime(), Lambda);
 }
 
-static bool TryCalculatePoleVector(const FVector& ALocation, const FVector& BLocation, const FVector& CLocation,
-                                   FVector& ProjectionLocation, FVector& Direction)
-{
-	auto AcVector{CLocation - ALocation};
-	auto AbVector{BLocation - ALocation};
-
-	if (!AcVector.Normalize())
-	{
-		if (!AbVector.Normalize())
-		{
-			return false;
-		}
-
-		ProjectionLocation = ALocation;
-		Direction = AbVector;
-
-		return true;
-	}
-
-	if (AbVector.IsNearlyZero())
-	{
-		return false;
-	}
-
-	ProjectionLocation = ALocation + AbVector.ProjectOnToNormal(AcVector);
-	Direction = (BLocation - ProjectionLocation).GetSafeNormal();
-
-	return true;
-}
-
 void FAlsRigUnit_CalculatePoleVector::Initialize()
 {
 	bInitialized = false;
@@ -86,8 +84,8 @@ FAlsRigUnit_CalculatePoleVector_Execute()
 	{
 		const auto NewEndLocation{Hierarchy->GetGlobalTransform(CachedItemB).GetLocation()};
 
-		if (TryCalculatePoleVector(Hierarchy->GetGlobalTransform(CachedItemA).GetLocation(), NewEndLocation,
-		                           Hierarchy->GetGlobalTransform(CachedItemC).GetLocation(), StartLocation, Direction))
+		if (UAlsMath::TryCalculatePoleVector(Hierarchy->GetGlobalTransform(CachedItemA).GetLocation(), NewEndLocation,
+		                                     Hierarchy->GetGlobalTransform(CachedItemC).GetLocation(), StartLocation, Direction))
 		{
 			EndLocation = NewEndLocation;
 			bSuccess = true;
@@ -97,8 +95,8 @@ FAlsRigUnit_CalculatePoleVector_Execute()
 
 	const auto NewEndLocation{Hierarchy->GetInitialGlobalTransform(CachedItemB).GetLocation()};
 
-	if (TryCalculatePoleVector(Hierarchy->GetInitialGlobalTransform(CachedItemA).GetLocation(), NewEndLocation,
-	                           Hierarchy->GetInitialGlobalTransform(CachedItemC).GetLocation(), StartLocation, Direction))
+	if (UAlsMath::TryCalculatePoleVector(Hierarchy->GetInitialGlobalTransform(CachedItemA).GetLocation(), NewEndLocation,
+	                                     Hierarchy->GetInitialGlobalTransform(CachedItemC).GetLocation(), StartLocation, Direction))
 	{
 		EndLocation = NewEndLocation;
 		bSuccess = true;
@@ -152,28 +150,80 @@ FAlsRigUnit_HandIkRetargeting_Execute()
 		return;
 	}
 
-	FVector RetargetingOffset;
+	auto RetargetingOffset{
+		AlsRigUnits::CalculateHandIkRetargetingOffset(Hierarchy, CachedLeftHandBone, CachedLeftHandIkBone,
+		                                              CachedRightHandBone, CachedRightHandIkBone, RetargetingWeight)
+	};
+
+	RetargetingOffset *= FMath::Min(1.0f, Weight);
+
+	if (RetargetingOffset.IsNearlyZero())
+	{
+		return;
+	}
+
+	if (CachedBonesToMove.Num() != BonesToMove.Num())
+	{
+		CachedBonesToMove.Reset();
+		CachedBonesToMove.SetNum(BonesToMove.Num());
+	}
+
+	for (auto i{0}; i < BonesToMove.Num(); i++)
+	{
+		if (CachedBonesToMove[i].UpdateCache(BonesToMove[i], Hierarchy))
+		{
+			auto BoneTransform{Hierarchy->GetGlobalTransform(CachedBonesToMove[i])};
+			BoneTransform.AddToTranslation(RetargetingOffset);
+
+			Hierarchy->SetGlobalTransform(CachedBonesToMove[i], BoneTransform, bPropagateToChildren);
+		}
+	}
+}
+
+void FAlsRigUnit_HandIkRetargetingBatched::Initialize()
+{
+	bInitialized = false;
+}
+
+FAlsRigUnit_HandIkRetargetingBatched_Execute()
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_RIGUNIT()
 
-	if (FAnimWeight::IsFullWeight(RetargetingWeight))
+	auto* Hierarchy{ExecuteContext.Hierarchy};
+	if (!IsValid(Hierarchy))
 	{
-		RetargetingOffset = Hierarchy->GetGlobalTransform(CachedRightHandBone).GetLocation() -
-		                    Hierarchy->GetGlobalTransform(CachedRightHandIkBone).GetLocation();
+		return;
 	}
-	else if (!FAnimWeight::IsRelevant(RetargetingWeight))
+
+	if (!bInitialized)
 	{
-		RetargetingOffset = Hierarchy->GetGlobalTransform(CachedLeftHandBone).GetLocation() -
-		                    Hierarchy->GetGlobalTransform(CachedLeftHandIkBone).GetLocation();
+		CachedLeftHandBone.Reset();
+		CachedLeftHandIkBone.Reset();
+		CachedRightHandBone.Reset();
+		CachedRightHandIkBone.Reset();
+		CachedBonesToMove.Reset();
+
+		bInitialized = true;
 	}
-	else
+
+	if (!CachedLeftHandBone.UpdateCache(LeftHandBone, Hierarchy) ||
+	    !CachedLeftHandIkBone.UpdateCache(LeftHandIkBone, Hierarchy) ||
+	    !CachedRightHandBone.UpdateCache(RightHandBone, Hierarchy) ||
+	    !CachedRightHandIkBone.UpdateCache(RightHandIkBone, Hierarchy))
+	{
+		return;
+	}
+
+	if (!FAnimWeight::IsRelevant(Weight))
 	{
-		RetargetingOffset = FMath::Lerp(Hierarchy->GetGlobalTransform(CachedLeftHandBone).GetLocation(),
-		                                Hierarchy->GetGlobalTransform(CachedRightHandBone).GetLocation(),
-		                                RetargetingWeight) -
-		                    FMath::Lerp(Hierarchy->GetGlobalTransform(CachedLeftHandIkBone).GetLocation(),
-		                                Hierarchy->GetGlobalTransform(CachedRightHandIkBone).GetLocation(),
-		                                RetargetingWeight);
+		return;
 	}
 
+	auto RetargetingOffset{
+		AlsRigUnits::CalculateHandIkRetargetingOffset(Hierarchy, CachedLeftHandBone, CachedLeftHandIkBone,
+		                                              CachedRightHandBone, CachedRightHandIkBone, RetargetingWeight)
+	};
+
 	RetargetingOffset *= FMath::Min(1.0f, Weight);
 
 	if (RetargetingOffset.IsNearlyZero())
@@ -184,17 +234,34 @@ FAlsRigUnit_HandIkRetargeting_Execute()
 	if (CachedBonesToMove.Num() != BonesToMove.Num())
 	{
 		CachedBonesToMove.Reset();
-		CachedBonesToMove.SetNum(CachedBonesToMove.Num());
+		CachedBonesToMove.SetNum(BonesToMove.Num());
 	}
 
+	// Read the global transforms of all bones before any of them is moved. Otherwise, when bones are propagated to children,
+	// moving a parent bone would make the global transforms of its child bones dirty, and reading them would recalculate them.
+	// Since the transforms are read up front, a listed child bone is not moved a second time along with its parent.
+
+	ValidBoneIndices.Reset(BonesToMove.Num());
+	BoneTransforms.Reset(BonesToMove.Num());
+
 	for (auto i{0}; i < BonesToMove.Num(); i++)
 	{
 		if (CachedBonesToMove[i].UpdateCache(BonesToMove[i], Hierarchy))
 		{
-			auto BoneTransform{Hierarchy->GetGlobalTransform(CachedBonesToMove[i])};
-			BoneTransform.AddToTranslation(RetargetingOffset);
-
-			Hierarchy->SetGlobalTransform(CachedBonesToMove[i], BoneTransform, bPropagateToChildren);
+			ValidBoneIndices.Add(i);
+			BoneTransforms.Add(Hierarchy->GetGlobalTransform(CachedBonesToMove[i]));
 		}
 	}
+
+	// FTransform stores its translation in a vector register, so this is a single vector addition per bone.
+
+	for (auto& BoneTransform : BoneTransforms)
+	{
+		BoneTransform.AddToTranslation(RetargetingOffset);
+	}
+
+	for (auto i{0}; i < ValidBoneIndices.Num(); i++)
+	{
+		Hierarchy->SetGlobalTransform(CachedBonesToMove[ValidBoneIndices[i]], BoneTransforms[i], bPropagateToChildren);
+	}
 }
@@ -1,25 +1,217 @@
 #include "Notifies/AlsAnimNotify_FootstepEffects.h"
 
+#include "AlsAnimationInstance.h"
 #include "AlsCharacter.h"
+#include "AlsFootstepEffectsSubsystem.h"
 #include "DrawDebugHelpers.h"
-#include "NiagaraFunctionLibrary.h"
 #include "Animation/AnimInstance.h"
-#include "Components/AudioComponent.h"
-#include "Components/DecalComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/AssetManager.h"
 #include "Engine/World.h"
-#include "Kismet/GameplayStatics.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
-#include "Sound/SoundBase.h"
+#include "PhysicsEngine/PhysicsSettings.h"
 #include "Utility/AlsConstants.h"
+#include "Utility/AlsCsvProfiler.h"
 #include "Utility/AlsEnumUtility.h"
+#include "Utility/AlsLog.h"
 #include "Utility/AlsMacros.h"
 #include "Utility/AlsMath.h"
+#include "Utility/AlsProfiling.h"
 #include "Utility/AlsUtility.h"
 
+#if WITH_EDITOR
+#include "Logging/MessageLog.h"
+#include "Misc/DataValidation.h"
+#include "Misc/UObjectToken.h"
+#endif
+
 // ReSharper disable once CppUnusedIncludeDirective
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimNotify_FootstepEffects)
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Effects Skipped"), STAT_AlsFootstepEffects_Skipped, STATGROUP_Als)
+
+#define LOCTEXT_NAMESPACE "AlsAnimNotify_FootstepEffects"
+
+void UAlsFootstepEffectsSettings::PostLoad()
+{
+	Super::PostLoad();
+
+	CompileEffects();
+
+	if (!IsTemplate() && !IsRunningCommandlet())
+	{
+		LoadEffectsAsync();
+	}
+}
+
+#if WITH_EDITOR
+void UAlsFootstepEffectsSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, Effects) ||
+	    PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, DefaultEffectSurface))
+	{
+		if (EffectsLoadHandle.IsValid())
+		{
+			EffectsLoadHandle->CancelHandle();
+			EffectsLoadHandle.Reset();
+		}
+
+		CompileEffects();
+		LoadEffectsAsync();
+	}
+
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+}
+
+EDataValidationResult UAlsFootstepEffectsSettings::IsDataValid(TArray<FText>& ValidationErrors)
+{
+	auto Result{CombineDataValidationResults(Super::IsDataValid(ValidationErrors), EDataValidationResult::Valid)};
+
+	if (!Effects.IsEmpty() && !Effects.Contains(DefaultEffectSurface))
+	{
+		auto FallbackEffectSurface{EPhysicalSurface::SurfaceType_Max};
+
+		for (const auto& Tuple : Effects)
+		{
+			FallbackEffectSurface = FMath::Min(FallbackEffectSurface, Tuple.Key.GetValue());
+		}
+
+		ValidationErrors.Add(FText::Format(
+			LOCTEXT("DefaultEffectMissingError", "The default effect surface {0} doesn't have an effect, so surfaces without their own effect will use the effect of the {1} surface instead!"),
+			StaticEnum<EPhysicalSurface>()->GetDisplayNameTextByValue(DefaultEffectSurface),
+			StaticEnum<EPhysicalSurface>()->GetDisplayNameTextByValue(FallbackEffectSurface)));
+
+		Result = EDataValidationResult::Invalid;
+	}
+
+	// Surfaces of the project that don't have their own effect are not an error, since they use the default effect, but they are worth noting.
+
+	TStringBuilder<256> MissingSurfacesBuilder;
+
+	for (const auto& PhysicalSurface : GetDefault<UPhysicsSettings>()->PhysicalSurfaces)
+	{
+		if (!Effects.Contains(PhysicalSurface.Type))
+		{
+			if (MissingSurfacesBuilder.Len() > 0)
+			{
+				MissingSurfacesBuilder << TEXTVIEW(", ");
+			}
+
+			PhysicalSurface.Name.AppendString(MissingSurfacesBuilder);
+		}
+	}
+
+	if (MissingSurfacesBuilder.Len() > 0)
+	{
+		FMessageLog{AlsLog::MessageLogName}.Info(FText::Format(
+			                                      LOCTEXT("MissingSurfacesInfo", "{0}: The following surfaces use the default effect: {1}."),
+			                                      FText::AsCultureInvariant(GetName()),
+			                                      FText::AsCultureInvariant(FString{MissingSurfacesBuilder})))
+		                                      ->AddToken(FUObjectToken::Create(this));
+	}
+
+	return Result;
+}
+#endif
+
+int32 UAlsFootstepEffectsSettings::GetEffectIndex(const EPhysicalSurface SurfaceType) const
+{
+	return SurfaceEffectIndices[SurfaceType];
+}
+
+void UAlsFootstepEffectsSettings::CompileEffects()
+{
+	CompiledEffects.Reset(Effects.Num());
+	LoadedEffects.Reset();
+
+	for (auto& EffectIndex : SurfaceEffectIndices)
+	{
+		EffectIndex = INDEX_NONE;
+	}
+
+	for (const auto& Tuple : Effects)
+	{
+		SurfaceEffectIndices[Tuple.Key] = static_cast<int8>(CompiledEffects.Add(Tuple.Value));
+	}
+
+	auto DefaultEffectIndex{SurfaceEffectIndices[DefaultEffectSurface]};
+
+	// Assets created before the default effect surface existed usually don't have an effect for it, so in this case
+	// the effect of the surface with the lowest value is used instead, to keep unmapped surfaces from going silent.
+
+	if (DefaultEffectIndex == INDEX_NONE)
+	{
+		for (const auto EffectIndex : SurfaceEffectIndices)
+		{
+			if (EffectIndex != INDEX_NONE)
+			{
+				DefaultEffectIndex = EffectIndex;
+				break;
+			}
+		}
+	}
+
+	for (auto& EffectIndex : SurfaceEffectIndices)
+	{
+		if (EffectIndex == INDEX_NONE)
+		{
+			EffectIndex = DefaultEffectIndex;
+		}
+	}
+}
+
+void UAlsFootstepEffectsSettings::LoadEffectsAsync()
+{
+	if (EffectsLoadHandle.IsValid() || !UAssetManager::IsInitialized())
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> AssetPaths;
+	AssetPaths.Reserve(CompiledEffects.Num() * 3);
+
+	for (const auto& Effect : CompiledEffects)
+	{
+		if (!Effect.Sound.IsNull())
+		{
+			AssetPaths.Add(Effect.Sound.ToSoftObjectPath());
+		}
+
+		if (!Effect.DecalMaterial.IsNull())
+		{
+			AssetPaths.Add(Effect.DecalMaterial.ToSoftObjectPath());
+		}
+
+		if (!Effect.ParticleSystem.IsNull())
+		{
+			AssetPaths.Add(Effect.ParticleSystem.ToSoftObjectPath());
+		}
+	}
+
+	if (AssetPaths.IsEmpty())
+	{
+		RefreshLoadedEffects();
+		return;
+	}
+
+	EffectsLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(AssetPaths), FStreamableDelegate::CreateUObject(this, &ThisClass::RefreshLoadedEffects));
+}
+
+void UAlsFootstepEffectsSettings::RefreshLoadedEffects()
+{
+	LoadedEffects.SetNum(CompiledEffects.Num());
+
+	for (auto i{0}; i < CompiledEffects.Num(); i++)
+	{
+		LoadedEffects[i].Sound = CompiledEffects[i].Sound.Get();
+		LoadedEffects[i].DecalMaterial = CompiledEffects[i].DecalMaterial.Get();
+		LoadedEffects[i].ParticleSystem = CompiledEffects[i].ParticleSystem.Get();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
+
 FString UAlsAnimNotify_FootstepEffects::GetNotifyName_Implementation() const
 {
 	TStringBuilder<64> NotifyNameBuilder;
@@ -29,6 +221,44 @@ FString UAlsAnimNotify_FootstepEffects::GetNotifyName_Implementation() const
 	return FString{NotifyNameBuilder};
 }
 
+bool UAlsAnimNotify_FootstepEffects::TryGetFootIkGroundHit(const USkeletalMeshComponent* Mesh, const FVector& FootLocation,
+                                                           FHitResult& Hit) const
+{
+	if (!FootstepEffectsSettings->bReuseFootIkGroundHit)
+	{
+		return false;
+	}
+
+	// Foot IK is performed by the ALS animation instance, which traces under each foot
+	// every frame, so in most cases its latest ground hit can be used as is.
+
+	const auto* AnimationInstance{Cast<UAlsAnimationInstance>(Mesh->GetAnimInstance())};
+	if (!IsValid(AnimationInstance))
+	{
+		return false;
+	}
+
+	const auto& FeetState{AnimationInstance->GetFeetState()};
+	const auto& GroundHit{FootBone == EAlsFootBone::Left ? FeetState.Left.GroundHit : FeetState.Right.GroundHit};
+
+	if (!GroundHit.bValid || Mesh->GetWorld()->GetTimeSeconds() - GroundHit.Time > FootstepEffectsSettings->FootIkGroundHitMaxAge ||
+	    FVector::DistSquared2D(GroundHit.ImpactPoint, FootLocation) >
+	    FMath::Square(FootstepEffectsSettings->FootIkGroundHitMaxDistance * Mesh->GetComponentScale().Z))
+	{
+		return false;
+	}
+
+	Hit.bBlockingHit = true;
+	Hit.ImpactPoint = GroundHit.ImpactPoint;
+	Hit.ImpactNormal = GroundHit.ImpactNormal;
+	Hit.Location = GroundHit.ImpactPoint;
+	Hit.Normal = GroundHit.ImpactNormal;
+	Hit.Component = GroundHit.Component;
+	Hit.PhysMaterial = GroundHit.PhysicalMaterial;
+
+	return true;
+}
+
 void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimSequenceBase* Animation,
                                             const FAnimNotifyEventReference& EventReference)
 {
@@ -64,47 +294,59 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 	const auto bDisplayDebug{UAlsUtility::ShouldDisplayDebugForActor(Mesh->GetOwner(), UAlsConstants::TracesDebugDisplayName())};
 #endif
 
-	FCollisionQueryParams QueryParameters{__FUNCTION__, true, Mesh->GetOwner()};
-	QueryParameters.bReturnPhysicalMaterial = true;
-
 	FHitResult Hit;
-	if (World->LineTraceSingleByChannel(Hit, FootTransform.GetLocation(),
-	                                    FootTransform.GetLocation() - FootZAxis *
-	                                    (FootstepEffectsSettings->SurfaceTraceDistance * MeshScale),
-	                                    UEngineTypes::ConvertToCollisionChannel(FootstepEffectsSettings->SurfaceTraceChannel),
-	                                    QueryParameters))
+
+	if (!TryGetFootIkGroundHit(Mesh, FootTransform.GetLocation(), Hit))
 	{
+		FCollisionQueryParams QueryParameters{__FUNCTION__, true, Mesh->GetOwner()};
+		QueryParameters.bReturnPhysicalMaterial = true;
+
+		ALS_SCENE_QUERY(FootstepTraces, IsValid(Character) ? &Character->GetCostTracker() : nullptr);
+
+		if (World->LineTraceSingleByChannel(Hit, FootTransform.GetLocation(),
+		                                    FootTransform.GetLocation() - FootZAxis *
+		                                    (FootstepEffectsSettings->SurfaceTraceDistance * MeshScale),
+		                                    UEngineTypes::ConvertToCollisionChannel(FootstepEffectsSettings->SurfaceTraceChannel),
+		                                    QueryParameters))
+		{
 #if ENABLE_DRAW_DEBUG
-		if (bDisplayDebug)
+			if (bDisplayDebug)
+			{
+				UAlsUtility::DrawDebugLineTraceSingle(World, Hit.TraceStart, Hit.TraceEnd, Hit.bBlockingHit,
+				                                      Hit, {0.333333f, 0.0f, 0.0f}, FLinearColor::Red, 10.0f);
+			}
+#endif
+		}
+		else
 		{
-			UAlsUtility::DrawDebugLineTraceSingle(World, Hit.TraceStart, Hit.TraceEnd, Hit.bBlockingHit,
-			                                      Hit, {0.333333f, 0.0f, 0.0f}, FLinearColor::Red, 10.0f);
+			Hit.ImpactPoint = FootTransform.GetLocation();
+			Hit.ImpactNormal = FVector::UpVector;
 		}
-#endif
 	}
-	else
+
+	const auto EffectIndex{
+		FootstepEffectsSettings->GetEffectIndex(Hit.PhysMaterial.IsValid() ? Hit.PhysMaterial->SurfaceType.GetValue() : SurfaceType_Default)
+	};
+
+	if (EffectIndex == INDEX_NONE)
 	{
-		Hit.ImpactPoint = FootTransform.GetLocation();
-		Hit.ImpactNormal = FVector::UpVector;
+		return;
 	}
 
-	const auto SurfaceType{Hit.PhysMaterial.IsValid() ? Hit.PhysMaterial->SurfaceType.GetValue() : SurfaceType_Default};
-	const auto* EffectSettings{FootstepEffectsSettings->Effects.Find(SurfaceType)};
-
-	if (EffectSettings == nullptr)
+	if (!FootstepEffectsSettings->LoadedEffects.IsValidIndex(EffectIndex))
 	{
-		for (const auto& Tuple : FootstepEffectsSettings->Effects)
-		{
-			EffectSettings = &Tuple.Value;
-			break;
-		}
+		// The effect assets are still being loaded, so skip the effects instead of loading them synchronously.
 
-		if (EffectSettings == nullptr)
-		{
-			return;
-		}
+		INC_DWORD_STAT(STAT_AlsFootstepEffects_Skipped);
+		ALS_CSV_ACCUMULATE(FootstepEffectsSkipped, 1);
+
+		FootstepEffectsSettings->LoadEffectsAsync();
+		return;
 	}
 
+	const auto* EffectSettings{&FootstepEffectsSettings->CompiledEffects[EffectIndex]};
+	const auto* EffectAssets{&FootstepEffectsSettings->LoadedEffects[EffectIndex]};
+
 	const auto FootstepLocation{Hit.ImpactPoint};
 
 	const auto FootstepRotation{
@@ -122,6 +364,21 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 	}
 #endif
 
+	auto* FootstepEffects{World->GetSubsystem<UAlsFootstepEffectsSubsystem>()};
+	if (!IsValid(FootstepEffects))
+	{
+		return;
+	}
+
+	// Effects are not spawned immediately, but are queued and spawned at the end of the frame together
+	// with the effects of other characters, so that they can be prioritized and culled as a whole.
+
+	FAlsFootstepEffectsRequest Request;
+	Request.Mesh = Mesh;
+	Request.FootBoneName = FootBoneName;
+	Request.FootstepLocation = FootstepLocation;
+	Request.FootstepRotation = FootstepRotation.Rotator();
+
 	if (bSpawnSound)
 	{
 		auto VolumeMultiplier{SoundVolumeMultiplier};
@@ -131,41 +388,17 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 			VolumeMultiplier *= 1.0f - UAlsMath::Clamp01(AnimationInstance->GetCurveValue(UAlsConstants::FootstepSoundBlockCurveName()));
 		}
 
-		if (FAnimWeight::IsRelevant(VolumeMultiplier) && IsValid(EffectSettings->Sound.LoadSynchronous()))
+		if (FAnimWeight::IsRelevant(VolumeMultiplier) && IsValid(EffectAssets->Sound))
 		{
-			UAudioComponent* Audio{nullptr};
-
-			switch (EffectSettings->SoundSpawnMode)
-			{
-				case EAlsFootstepSoundSpawnMode::SpawnAtTraceHitLocation:
-					if (World->WorldType == EWorldType::EditorPreview)
-					{
-						UGameplayStatics::PlaySoundAtLocation(World, EffectSettings->Sound.Get(), FootstepLocation,
-						                                      VolumeMultiplier, SoundPitchMultiplier);
-					}
-					else
-					{
-						Audio = UGameplayStatics::SpawnSoundAtLocation(World, EffectSettings->Sound.Get(), FootstepLocation,
-						                                               FootstepRotation.Rotator(),
-						                                               VolumeMultiplier, SoundPitchMultiplier);
-					}
-					break;
-
-				case EAlsFootstepSoundSpawnMode::SpawnAttachedToFootBone:
-					Audio = UGameplayStatics::SpawnSoundAttached(EffectSettings->Sound.Get(), Mesh, FootBoneName, FVector::ZeroVector,
-					                                             FRotator::ZeroRotator, EAttachLocation::SnapToTarget,
-					                                             true, VolumeMultiplier, SoundPitchMultiplier);
-					break;
-			}
-
-			if (IsValid(Audio))
-			{
-				Audio->SetIntParameter(FName{TEXTVIEW("FootstepType")}, static_cast<int32>(SoundType));
-			}
+			Request.Sound = EffectAssets->Sound;
+			Request.SoundSpawnMode = EffectSettings->SoundSpawnMode;
+			Request.SoundType = SoundType;
+			Request.SoundVolumeMultiplier = VolumeMultiplier;
+			Request.SoundPitchMultiplier = SoundPitchMultiplier;
 		}
 	}
 
-	if (bSpawnDecal && IsValid(EffectSettings->DecalMaterial.LoadSynchronous()))
+	if (bSpawnDecal && IsValid(EffectAssets->DecalMaterial))
 	{
 		const auto DecalRotation{
 			FootstepRotation * FQuat{
@@ -175,68 +408,50 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 			}
 		};
 
-		const auto DecalLocation{
-			FootstepLocation + DecalRotation.RotateVector(FVector{EffectSettings->DecalLocationOffset} * MeshScale)
-		};
-
-		UDecalComponent* Decal;
+		Request.DecalMaterial = EffectAssets->DecalMaterial;
+		Request.DecalSize = FVector{EffectSettings->DecalSize} * MeshScale;
+		Request.DecalLocation = FootstepLocation + DecalRotation.RotateVector(FVector{EffectSettings->DecalLocationOffset} * MeshScale);
+		Request.DecalRotation = DecalRotation.Rotator();
+		Request.DecalDuration = EffectSettings->DecalDuration;
+		Request.DecalFadeOutDuration = EffectSettings->DecalFadeOutDuration;
 
-		if (EffectSettings->DecalSpawnMode == EAlsFootstepDecalSpawnMode::SpawnAttachedToTraceHitComponent && Hit.Component.IsValid())
+		if (EffectSettings->DecalSpawnMode == EAlsFootstepDecalSpawnMode::SpawnAttachedToTraceHitComponent)
 		{
-			Decal = UGameplayStatics::SpawnDecalAttached(EffectSettings->DecalMaterial.Get(),
-			                                             FVector{EffectSettings->DecalSize} * MeshScale,
-			                                             Hit.Component.Get(), NAME_None, DecalLocation,
-			                                             DecalRotation.Rotator(), EAttachLocation::KeepWorldPosition);
-		}
-		else
-		{
-			Decal = UGameplayStatics::SpawnDecalAtLocation(World, EffectSettings->DecalMaterial.Get(),
-			                                               FVector{EffectSettings->DecalSize} * MeshScale,
-			                                               DecalLocation, DecalRotation.Rotator());
-		}
-
-		if (IsValid(Decal))
-		{
-			Decal->SetFadeOut(EffectSettings->DecalDuration, EffectSettings->DecalFadeOutDuration, false);
+			Request.DecalAttachParent = Hit.Component.Get();
 		}
 	}
 
-	if (bSpawnParticleSystem && IsValid(EffectSettings->ParticleSystem.LoadSynchronous()))
+	if (bSpawnParticleSystem && IsValid(EffectAssets->ParticleSystem))
 	{
+		Request.ParticleSystem = EffectAssets->ParticleSystem;
+		Request.ParticleSystemSpawnMode = EffectSettings->ParticleSystemSpawnMode;
+		Request.ParticleSystemScale = FVector::OneVector * MeshScale;
+
+		const auto& ParticleSystemRotationOffset{
+			FootBone == EAlsFootBone::Left
+				? EffectSettings->ParticleSystemFootLeftRotationOffset
+				: EffectSettings->ParticleSystemFootRightRotationOffset
+		};
+
 		switch (EffectSettings->ParticleSystemSpawnMode)
 		{
 			case EAlsFootstepParticleEffectSpawnMode::SpawnAtTraceHitLocation:
 			{
-				const auto ParticleSystemRotation{
-					FootstepRotation * FQuat{
-						(FootBone == EAlsFootBone::Left
-							 ? EffectSettings->ParticleSystemFootLeftRotationOffset
-							 : EffectSettings->ParticleSystemFootRightRotationOffset).Quaternion()
-					}
-				};
-
-				const auto ParticleSystemLocation{
-					FootstepLocation +
-					ParticleSystemRotation.RotateVector(FVector{EffectSettings->ParticleSystemLocationOffset} * MeshScale)
-				};
-
-				UNiagaraFunctionLibrary::SpawnSystemAtLocation(World, EffectSettings->ParticleSystem.Get(),
-				                                               ParticleSystemLocation, ParticleSystemRotation.Rotator(),
-				                                               FVector::OneVector * MeshScale, true, true, ENCPoolMethod::AutoRelease);
+				const auto ParticleSystemRotation{FootstepRotation * FQuat{ParticleSystemRotationOffset.Quaternion()}};
+
+				Request.ParticleSystemLocation = FootstepLocation +
+				                                 ParticleSystemRotation.RotateVector(
+					                                 FVector{EffectSettings->ParticleSystemLocationOffset} * MeshScale);
+				Request.ParticleSystemRotation = ParticleSystemRotation.Rotator();
 			}
 			break;
 
 			case EAlsFootstepParticleEffectSpawnMode::SpawnAttachedToFootBone:
-				UNiagaraFunctionLibrary::SpawnSystemAttached(EffectSettings->ParticleSystem.Get(), Mesh, FootBoneName,
-				                                             FVector{EffectSettings->ParticleSystemLocationOffset} * MeshScale,
-				                                             FRotator{
-					                                             FootBone == EAlsFootBone::Left
-						                                             ? EffectSettings->ParticleSystemFootLeftRotationOffset
-						                                             : EffectSettings->ParticleSystemFootRightRotationOffset
-				                                             },
-				                                             FVector::OneVector * MeshScale, EAttachLocation::KeepRelativeOffset,
-				                                             true, ENCPoolMethod::AutoRelease);
+				Request.ParticleSystemLocation = FVector{EffectSettings->ParticleSystemLocationOffset} * MeshScale;
+				Request.ParticleSystemRotation = FRotator{ParticleSystemRotationOffset};
 				break;
 		}
 	}
+
+	FootstepEffects->QueueEffects(Request);
 }
@@ -0,0 +1,70 @@
+#include "Utility/AlsAnimationInstanceRecording.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Utility/AlsLog.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimationInstanceRecording)
+
+namespace AlsAnimationInstanceRecording
+{
+	// Written at the beginning of every recording file, followed by the file version.
+	constexpr uint32 FileMagic{0x52534C41}; // "ALSR"
+}
+
+bool FAlsAnimationInstanceRecording::SaveToFile(const FString& FilePath) const
+{
+	TArray<uint8> Bytes;
+
+	FMemoryWriter Writer{Bytes};
+	FObjectAndNameAsStringProxyArchive Archive{Writer, false};
+
+	auto Magic{AlsAnimationInstanceRecording::FileMagic};
+	auto Version{FileVersion};
+
+	Archive << Magic;
+	Archive << Version;
+
+	StaticStruct()->SerializeItem(Archive, const_cast<FAlsAnimationInstanceRecording*>(this), nullptr);
+
+	return !Archive.IsError() && FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FAlsAnimationInstanceRecording::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader{Bytes};
+	FObjectAndNameAsStringProxyArchive Archive{Reader, true};
+
+	// The recording is serialized without property tags, so files of other versions can't be read.
+
+	uint32 Magic{0};
+	uint32 Version{0};
+
+	Archive << Magic;
+	Archive << Version;
+
+	if (Archive.IsError() || Magic != AlsAnimationInstanceRecording::FileMagic)
+	{
+		UE_LOG(LogAls, Warning, TEXT("%hs: %s is not an ALS animation instance recording."), __FUNCTION__, *FilePath);
+		return false;
+	}
+
+	if (Version != FileVersion)
+	{
+		UE_LOG(LogAls, Warning, TEXT("%hs: %s has version %u, but only version %u is supported."),
+		       __FUNCTION__, *FilePath, Version, FileVersion);
+		return false;
+	}
+
+	StaticStruct()->SerializeItem(Archive, this, nullptr);
+
+	return !Archive.IsError();
+}
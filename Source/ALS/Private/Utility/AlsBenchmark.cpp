@@ -0,0 +1,47 @@
+#include "Utility/AlsBenchmark.h"
+
+FAlsBenchmarkTimer::FAlsBenchmarkTimer(const TCHAR* InName) : Name{InName} {}
+
+void FAlsBenchmarkTimer::Reset()
+{
+	Cycles.store(0, std::memory_order_relaxed);
+	Calls.store(0, std::memory_order_relaxed);
+}
+
+double FAlsBenchmarkTimer::GetMilliseconds() const
+{
+	return FPlatformTime::ToMilliseconds64(Cycles.load(std::memory_order_relaxed));
+}
+
+FAlsBenchmarkTimer FAlsBenchmark::CharacterTick{TEXT("AAlsCharacter::Tick")};
+
+FAlsBenchmarkTimer FAlsBenchmark::NativeUpdateAnimation{TEXT("UAlsAnimationInstance::NativeUpdateAnimation")};
+
+FAlsBenchmarkTimer FAlsBenchmark::NativeThreadSafeUpdateAnimation{TEXT("UAlsAnimationInstance::NativeThreadSafeUpdateAnimation")};
+
+FAlsBenchmarkTimer FAlsBenchmark::CameraTick{TEXT("UAlsCameraComponent::TickCamera")};
+
+FAlsBenchmarkTimer FAlsBenchmark::CameraBatchTick{TEXT("UAlsCameraComponent::TickCamerasParallel")};
+
+std::atomic<bool> FAlsBenchmark::bActive{false};
+
+void FAlsBenchmark::Start()
+{
+	for (auto* Timer : GetTimers())
+	{
+		Timer->Reset();
+	}
+
+	bActive.store(true, std::memory_order_relaxed);
+}
+
+void FAlsBenchmark::Stop()
+{
+	bActive.store(false, std::memory_order_relaxed);
+}
+
+TConstArrayView<FAlsBenchmarkTimer*> FAlsBenchmark::GetTimers()
+{
+	static FAlsBenchmarkTimer* Timers[]{&CharacterTick, &NativeUpdateAnimation, &NativeThreadSafeUpdateAnimation, &CameraTick, &CameraBatchTick};
+	return Timers;
+}
@@ -0,0 +1,104 @@
+#include "Utility/AlsCostTracker.h"
+
+const TCHAR* FAlsCostTracker::GetCategoryName(const EAlsCostCategory Category)
+{
+	switch (Category)
+	{
+		case EAlsCostCategory::CharacterTick:
+			return TEXT("Character Tick");
+
+		case EAlsCostCategory::AnimationUpdate:
+			return TEXT("Animation Update");
+
+		case EAlsCostCategory::AnimationThreadSafeUpdate:
+			return TEXT("Animation Thread Safe Update");
+
+		case EAlsCostCategory::Layering:
+			return TEXT("Layering");
+
+		case EAlsCostCategory::Pose:
+			return TEXT("Pose");
+
+		case EAlsCostCategory::View:
+			return TEXT("View");
+
+		case EAlsCostCategory::Grounded:
+			return TEXT("Grounded");
+
+		case EAlsCostCategory::InAir:
+			return TEXT("In Air");
+
+		case EAlsCostCategory::Feet:
+			return TEXT("Feet");
+
+		case EAlsCostCategory::Transitions:
+			return TEXT("Transitions");
+
+		case EAlsCostCategory::RotateInPlace:
+			return TEXT("Rotate In Place");
+
+		case EAlsCostCategory::TurnInPlace:
+			return TEXT("Turn In Place");
+
+		default:
+			return TEXT("");
+	}
+}
+
+void FAlsCostTracker::Request()
+{
+	if (!IsEnabled())
+	{
+		// Drop counters that may have been accumulated before tracking was previously stopped.
+
+		for (auto i{0}; i < static_cast<int32>(EAlsCostCategory::Count); i++)
+		{
+			Cycles[i].store(0, std::memory_order_relaxed);
+			AverageMilliseconds[i] = 0.0f;
+		}
+
+		SceneQueries.store(0, std::memory_order_relaxed);
+		RemoteFunctionCalls.store(0, std::memory_order_relaxed);
+		RemoteFunctionBytes.store(0, std::memory_order_relaxed);
+		ReplicationUpdates.store(0, std::memory_order_relaxed);
+	}
+
+	LastRequestFrame.store(GFrameCounter, std::memory_order_relaxed);
+}
+
+void FAlsCostTracker::BeginFrame()
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	for (auto i{0}; i < static_cast<int32>(EAlsCostCategory::Count); i++)
+	{
+		const auto Milliseconds{static_cast<float>(FPlatformTime::ToMilliseconds64(Cycles[i].exchange(0, std::memory_order_relaxed)))};
+
+		AverageMilliseconds[i] = FMath::Lerp(AverageMilliseconds[i], Milliseconds, AverageAlpha);
+	}
+
+	LastFrameSceneQueries = SceneQueries.exchange(0, std::memory_order_relaxed);
+	LastFrameRemoteFunctionCalls = RemoteFunctionCalls.exchange(0, std::memory_order_relaxed);
+	LastFrameRemoteFunctionBytes = RemoteFunctionBytes.exchange(0, std::memory_order_relaxed);
+	LastFrameReplicationUpdates = ReplicationUpdates.exchange(0, std::memory_order_relaxed);
+}
+
+void FAlsCostTracker::AddRemoteFunctionCall(const int32 ParametersSize)
+{
+	if (IsEnabled())
+	{
+		RemoteFunctionCalls.fetch_add(1, std::memory_order_relaxed);
+		RemoteFunctionBytes.fetch_add(ParametersSize, std::memory_order_relaxed);
+	}
+}
+
+void FAlsCostTracker::AddReplicationUpdate()
+{
+	if (IsEnabled())
+	{
+		ReplicationUpdates.fetch_add(1, std::memory_order_relaxed);
+	}
+}
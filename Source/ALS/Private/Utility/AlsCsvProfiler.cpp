@@ -0,0 +1,3 @@
+#include "Utility/AlsCsvProfiler.h"
+
+CSV_DEFINE_CATEGORY_MODULE(ALS_API, Als, true);
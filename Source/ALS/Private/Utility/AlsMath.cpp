@@ -37,6 +37,36 @@ FVector UAlsMath::SlerpSkipNormalization(const FVector& From, const FVector& To,
 	return From * Cos + FromPerpendicular * Sin;
 }
 
+bool UAlsMath::TryCalculatePoleVector(const FVector& ALocation, const FVector& BLocation, const FVector& CLocation,
+                                      FVector& ProjectionLocation, FVector& Direction)
+{
+	auto AcVector{CLocation - ALocation};
+	auto AbVector{BLocation - ALocation};
+
+	if (!AcVector.Normalize())
+	{
+		if (!AbVector.Normalize())
+		{
+			return false;
+		}
+
+		ProjectionLocation = ALocation;
+		Direction = AbVector;
+
+		return true;
+	}
+
+	if (AbVector.IsNearlyZero())
+	{
+		return false;
+	}
+
+	ProjectionLocation = ALocation + AbVector.ProjectOnToNormal(AcVector);
+	Direction = (BLocation - ProjectionLocation).GetSafeNormal();
+
+	return true;
+}
+
 EAlsMovementDirection UAlsMath::CalculateMovementDirection(const float Angle, const float ForwardHalfAngle, const float AngleThreshold)
 {
 	if (Angle >= -ForwardHalfAngle - AngleThreshold && Angle <= ForwardHalfAngle + AngleThreshold)
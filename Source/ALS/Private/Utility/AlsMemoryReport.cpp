@@ -0,0 +1,219 @@
+#include "Utility/AlsMemoryReport.h"
+
+#include "AlsCharacter.h"
+#include "EngineUtils.h"
+#include "Animation/AnimInstance.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/DataAsset.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "Utility/AlsLog.h"
+
+namespace AlsMemoryReport
+{
+	TAutoConsoleVariable<int32> CharacterBudget{
+		TEXT("als.MemoryReport.CharacterBudget"), 0,
+		TEXT("Memory budget of a single ALS character in kilobytes, not including shared data assets. 0 disables the check.")
+	};
+
+	TAutoConsoleVariable<int32> TotalBudget{
+		TEXT("als.MemoryReport.TotalBudget"), 0,
+		TEXT("Memory budget of all ALS characters in a world in kilobytes, not including shared data assets. 0 disables the check.")
+	};
+
+	SIZE_T GetObjectBytes(const UObject* Object)
+	{
+		// Neither serialization into a memory counting archive nor GetResourceSizeEx() modify
+		// the object, they are just not const. This is the same measure the "Obj List" command uses.
+
+		auto* MutableObject{const_cast<UObject*>(Object)};
+
+		const FArchiveCountMem MemoryCounter{MutableObject};
+
+		return Object->GetClass()->GetStructureSize() + MemoryCounter.GetMax() +
+		       MutableObject->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	FString GetObjectName(const UObject* Object)
+	{
+		return FString::Printf(TEXT("%s (%s)"), *Object->GetName(), *Object->GetClass()->GetName());
+	}
+
+	void GatherSharedObjects(const UObject* Object, TSet<const UObject*>& SharedObjects)
+	{
+		for (TFieldIterator<FObjectPropertyBase> Iterator{Object->GetClass()}; Iterator; ++Iterator)
+		{
+			for (auto i{0}; i < Iterator->ArrayDim; i++)
+			{
+				const auto* ReferencedObject{Iterator->GetObjectPropertyValue_InContainer(Object, i)};
+				if (IsValid(ReferencedObject) && ReferencedObject->IsA<UDataAsset>())
+				{
+					SharedObjects.Add(ReferencedObject);
+				}
+			}
+		}
+	}
+
+	double ToKilobytes(const SIZE_T Bytes)
+	{
+		return static_cast<double>(Bytes) / 1024.0;
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs ReportCommand{
+		TEXT("als.MemoryReport"),
+		TEXT("Reports the memory used by every ALS character in the world and checks it against the als.MemoryReport budgets. ")
+		TEXT("Arguments: [Detailed = 0]."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Arguments, UWorld* World)
+		{
+			if (!IsValid(World))
+			{
+				return;
+			}
+
+			const auto bDetailed{Arguments.IsValidIndex(0) && FCString::ToBool(*Arguments[0])};
+
+			FAlsMemoryReport Report;
+			TMap<FString, SIZE_T> SharedObjectsBytes;
+
+			auto CharactersCount{0};
+			SIZE_T TotalBytes{0};
+
+			for (TActorIterator<AAlsCharacter> Iterator{World}; Iterator; ++Iterator)
+			{
+				Report.Gather(*Iterator);
+
+				CharactersCount += 1;
+				TotalBytes += Report.TotalBytes;
+
+				for (const auto& Entry : Report.SharedEntries)
+				{
+					SharedObjectsBytes.Add(Entry.Name, Entry.Bytes);
+				}
+
+				UE_LOG(LogAls, Log, TEXT("%hs: %s: %.1f KB."), __FUNCTION__, *Iterator->GetName(), ToKilobytes(Report.TotalBytes));
+
+				if (bDetailed)
+				{
+					for (const auto& Entry : Report.Entries)
+					{
+						UE_LOG(LogAls, Log, TEXT("%hs:     %s%s: %.1f KB."), __FUNCTION__,
+						       FCString::Spc(Entry.Depth * 4), *Entry.Name, ToKilobytes(Entry.Bytes));
+					}
+				}
+
+				if (Report.IsOverBudget())
+				{
+					UE_LOG(LogAls, Warning, TEXT("%hs: %s uses %.1f KB, which exceeds the budget of %.1f KB per character."),
+					       __FUNCTION__, *Iterator->GetName(), ToKilobytes(Report.TotalBytes),
+					       ToKilobytes(FAlsMemoryReport::GetCharacterBudgetBytes()));
+				}
+			}
+
+			SIZE_T SharedBytes{0};
+
+			for (const auto& [Name, Bytes] : SharedObjectsBytes)
+			{
+				SharedBytes += Bytes;
+
+				if (bDetailed)
+				{
+					UE_LOG(LogAls, Log, TEXT("%hs: Shared: %s: %.1f KB."), __FUNCTION__, *Name, ToKilobytes(Bytes));
+				}
+			}
+
+			UE_LOG(LogAls, Log, TEXT("%hs: %d characters use %.1f KB (%.1f KB per character) plus %.1f KB of shared data assets."),
+			       __FUNCTION__, CharactersCount, ToKilobytes(TotalBytes),
+			       CharactersCount > 0 ? ToKilobytes(TotalBytes) / CharactersCount : 0.0, ToKilobytes(SharedBytes));
+
+			const auto TotalBudgetBytes{FAlsMemoryReport::GetTotalBudgetBytes()};
+			if (TotalBudgetBytes > 0 && TotalBytes > TotalBudgetBytes)
+			{
+				UE_LOG(LogAls, Warning, TEXT("%hs: %d characters use %.1f KB, which exceeds the total budget of %.1f KB."),
+				       __FUNCTION__, CharactersCount, ToKilobytes(TotalBytes), ToKilobytes(TotalBudgetBytes));
+			}
+		})
+	};
+}
+
+void FAlsMemoryReport::Gather(const AAlsCharacter* Character)
+{
+	Entries.Reset();
+	SharedEntries.Reset();
+	TotalBytes = 0;
+	SharedBytes = 0;
+
+	if (!IsValid(Character))
+	{
+		return;
+	}
+
+	TSet<const UObject*> SharedObjects;
+
+	const auto AddEntry{
+		[this, &SharedObjects](const UObject* Object, const int32 Depth)
+		{
+			auto& Entry{Entries.Emplace_GetRef()};
+			Entry.Name = AlsMemoryReport::GetObjectName(Object);
+			Entry.Depth = Depth;
+			Entry.Bytes = AlsMemoryReport::GetObjectBytes(Object);
+
+			TotalBytes += Entry.Bytes;
+
+			AlsMemoryReport::GatherSharedObjects(Object, SharedObjects);
+		}
+	};
+
+	AddEntry(Character, 0);
+
+	TInlineComponentArray<UActorComponent*> Components;
+	Character->GetComponents(Components);
+
+	for (const auto* Component : Components)
+	{
+		AddEntry(Component, 1);
+
+		const auto* Mesh{Cast<USkeletalMeshComponent>(Component)};
+		if (!IsValid(Mesh))
+		{
+			continue;
+		}
+
+		if (IsValid(Mesh->GetAnimInstance()))
+		{
+			AddEntry(Mesh->GetAnimInstance(), 2);
+		}
+
+		for (const auto* LinkedAnimationInstance : Mesh->GetLinkedAnimInstances())
+		{
+			if (IsValid(LinkedAnimationInstance))
+			{
+				AddEntry(LinkedAnimationInstance, 2);
+			}
+		}
+
+		if (IsValid(Mesh->GetPostProcessInstance()))
+		{
+			AddEntry(Mesh->GetPostProcessInstance(), 2);
+		}
+	}
+
+	for (const auto* Object : SharedObjects)
+	{
+		auto& Entry{SharedEntries.Emplace_GetRef()};
+		Entry.Name = AlsMemoryReport::GetObjectName(Object);
+		Entry.Bytes = AlsMemoryReport::GetObjectBytes(Object);
+
+		SharedBytes += Entry.Bytes;
+	}
+}
+
+SIZE_T FAlsMemoryReport::GetCharacterBudgetBytes()
+{
+	return static_cast<SIZE_T>(FMath::Max(0, AlsMemoryReport::CharacterBudget.GetValueOnAnyThread())) * 1024;
+}
+
+SIZE_T FAlsMemoryReport::GetTotalBudgetBytes()
+{
+	return static_cast<SIZE_T>(FMath::Max(0, AlsMemoryReport::TotalBudget.GetValueOnAnyThread())) * 1024;
+}
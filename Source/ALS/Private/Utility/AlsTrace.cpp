@@ -0,0 +1,59 @@
+#include "Utility/AlsTrace.h"
+
+#if ALS_TRACE_ENABLED
+
+#include <atomic>
+
+#include "ProfilingDebugging/CountersTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(AlsChannel)
+
+TRACE_DECLARE_INT_COUNTER(AlsSceneQueries, TEXT("ALS/Scene Queries"))
+TRACE_DECLARE_INT_COUNTER(AlsCharactersLod0, TEXT("ALS/Characters/LOD 0"))
+TRACE_DECLARE_INT_COUNTER(AlsCharactersLod1, TEXT("ALS/Characters/LOD 1"))
+TRACE_DECLARE_INT_COUNTER(AlsCharactersLod2, TEXT("ALS/Characters/LOD 2"))
+TRACE_DECLARE_INT_COUNTER(AlsCharactersLod3, TEXT("ALS/Characters/LOD 3+"))
+
+namespace AlsTrace
+{
+	constexpr auto LodsCount{4};
+
+	// Counters are accumulated during the frame and published once at its end,
+	// so that Insights shows per frame values instead of ever-growing totals.
+
+	std::atomic<int32> SceneQueries{0};
+
+	std::atomic<int32> Characters[LodsCount]{};
+
+	void PublishCounters()
+	{
+		if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(AlsChannel))
+		{
+			return;
+		}
+
+		TRACE_COUNTER_SET(AlsSceneQueries, SceneQueries.exchange(0, std::memory_order_relaxed));
+		TRACE_COUNTER_SET(AlsCharactersLod0, Characters[0].exchange(0, std::memory_order_relaxed));
+		TRACE_COUNTER_SET(AlsCharactersLod1, Characters[1].exchange(0, std::memory_order_relaxed));
+		TRACE_COUNTER_SET(AlsCharactersLod2, Characters[2].exchange(0, std::memory_order_relaxed));
+		TRACE_COUNTER_SET(AlsCharactersLod3, Characters[3].exchange(0, std::memory_order_relaxed));
+	}
+
+	void AddSceneQuery()
+	{
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(AlsChannel))
+		{
+			SceneQueries.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void AddCharacter(const int32 LodIndex)
+	{
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(AlsChannel))
+		{
+			Characters[FMath::Clamp(LodIndex, 0, LodsCount - 1)].fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
+
+#endif
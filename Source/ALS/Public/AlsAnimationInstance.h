@@ -16,6 +16,7 @@
 #include "State/AlsTransitionsState.h"
 #include "State/AlsTurnInPlaceState.h"
 #include "State/AlsViewAnimationState.h"
+#include "Utility/AlsAnimationInstanceRecording.h"
 #include "Utility/AlsGameplayTags.h"
 #include "AlsAnimationInstance.generated.h"
 
@@ -114,6 +115,18 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	FAlsRagdollingAnimationState RagdollingState;
 
+private:
+	TUniquePtr<FAlsAnimationInstanceRecording> Recording;
+
+	// Frame being recorded during the current update. Stays valid until the next game thread update,
+	// so that calls to RefreshLook() by the linked animation layers are included in the frame.
+	mutable FAlsAnimationInstanceRecordedFrame* RecordingFrame{nullptr};
+
+	// Frame being replayed during the current update. Scene queries and world time are taken from this frame.
+	const FAlsAnimationInstanceRecordedFrame* ReplayFrame{nullptr};
+
+	mutable int32 ReplaySceneQueryIndex{0};
+
 public:
 	UAlsAnimationInstance();
 
@@ -127,6 +140,8 @@ public:
 
 	virtual void NativePostEvaluateAnimation() override;
 
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 protected:
 	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
 
@@ -237,6 +252,9 @@ private:
 
 	// Feet
 
+public:
+	const FAlsFeetState& GetFeetState() const;
+
 private:
 	void RefreshFeetOnGameThread();
 
@@ -308,6 +326,41 @@ private:
 public:
 	void StopRagdolling();
 
+	// Replay
+
+public:
+	bool IsRecording() const;
+
+	void StartRecording();
+
+	// Stops recording and returns the recorded frames.
+	FAlsAnimationInstanceRecording StopRecording();
+
+	// Re-runs the thread safe update and the look refreshes for every recorded frame the specified number of times using
+	// the recorded inputs and scene query results, then restores the animation instance to its state before the replay.
+	FAlsAnimationInstanceReplayResult Replay(const FAlsAnimationInstanceRecording& SourceRecording, int32 IterationsCount = 1);
+
+private:
+	static uint32 GetStateLayoutHash();
+
+	void SerializeState(FArchive& Archive);
+
+	void SaveState(TArray<uint8>& State);
+
+	void LoadState(const TArray<uint8>& State);
+
+	void BeginRecordingFrame(float DeltaTime);
+
+	void EndRecordingFrame();
+
+	bool TryGetReplaySceneQueryHit(FHitResult& Hit) const;
+
+	void RecordSceneQueryHit(const FHitResult& Hit) const;
+
+	double GetWorldTimeSeconds() const;
+
+	float GetDeltaTimeSeconds() const;
+
 	// Utility
 
 public:
@@ -319,6 +372,11 @@ inline UAlsAnimationInstanceSettings* UAlsAnimationInstance::GetSettingsUnsafe()
 	return Settings;
 }
 
+inline bool UAlsAnimationInstance::IsRecording() const
+{
+	return Recording.IsValid();
+}
+
 inline void UAlsAnimationInstance::MarkPendingUpdate()
 {
 	bPendingUpdate |= true;
@@ -329,6 +387,11 @@ inline void UAlsAnimationInstance::MarkTeleported()
 	TeleportedTime = GetWorld()->GetTimeSeconds();
 }
 
+inline const FAlsFeetState& UAlsAnimationInstance::GetFeetState() const
+{
+	return FeetState;
+}
+
 inline void UAlsAnimationInstance::SetGroundedEntryMode(const FGameplayTag& NewGroundedEntryMode)
 {
 	GroundedEntryMode = NewGroundedEntryMode;
@@ -1,16 +1,19 @@
 #pragma once
 
 #include "GameFramework/Character.h"
+#include "Settings/AlsActionAssets.h"
 #include "State/AlsLocomotionState.h"
 #include "State/AlsMovementBaseState.h"
 #include "State/AlsRagdollingState.h"
 #include "State/AlsRollingState.h"
 #include "State/AlsViewState.h"
+#include "Utility/AlsCostTracker.h"
 #include "Utility/AlsGameplayTags.h"
 #include "AlsCharacter.generated.h"
 
 struct FAlsMantlingParameters;
 struct FAlsMantlingTraceSettings;
+struct FStreamableHandle;
 class UAlsCharacterMovementComponent;
 class UAlsCharacterSettings;
 class UAlsMovementSettings;
@@ -105,6 +108,16 @@ protected:
 
 	FTimerHandle BrakingFrictionFactorResetTimer;
 
+	EAlsActionAssets RequestedActionAssets{EAlsActionAssets::None};
+
+	EAlsActionAssets LoadedActionAssets{EAlsActionAssets::None};
+
+	// Keeps the requested action assets loaded while the character is alive.
+	TArray<TSharedPtr<FStreamableHandle>> ActionAssetsLoadHandles;
+
+	// Diagnostics only, so it can be updated from const functions and other objects that only have a const character.
+	mutable FAlsCostTracker CostTracker;
+
 public:
 	explicit AAlsCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
@@ -114,6 +127,10 @@ public:
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+	virtual bool CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParameters, FFrame* Stack) override;
+
 	virtual void PreRegisterAllComponents() override;
 
 	virtual void PostInitializeComponents() override;
@@ -419,6 +436,19 @@ protected:
 
 	void RefreshViewRelativeTargetYawAngle();
 
+	// Action Assets
+
+public:
+	bool AreActionAssetsLoaded(EAlsActionAssets Assets) const;
+
+	// Starts loading the specified action assets asynchronously, unless they are already requested.
+	void LoadActionAssetsAsync(EAlsActionAssets Assets);
+
+private:
+	void GatherActionAssets(EAlsActionAssets Assets, TArray<FSoftObjectPath>& AssetPaths);
+
+	void OnActionAssetsLoaded(EAlsActionAssets Assets);
+
 	// Rolling
 
 public:
@@ -542,6 +572,8 @@ private:
 	// Debug
 
 public:
+	FAlsCostTracker& GetCostTracker() const;
+
 	virtual void DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DisplayInfo, float& Unused, float& VerticalLocation) override;
 
 private:
@@ -557,6 +589,10 @@ private:
 	void DisplayDebugTraces(const UCanvas* Canvas, float Scale, float HorizontalLocation, float& VerticalLocation) const;
 
 	void DisplayDebugMantling(const UCanvas* Canvas, float Scale, float HorizontalLocation, float& VerticalLocation) const;
+
+	void DisplayDebugCost(const UCanvas* Canvas, float Scale, float HorizontalLocation, float& VerticalLocation) const;
+
+	void DisplayDebugMemory(const UCanvas* Canvas, float Scale, float HorizontalLocation, float& VerticalLocation) const;
 };
 
 inline const FGameplayTag& AAlsCharacter::GetViewMode() const
@@ -628,3 +664,13 @@ inline const FAlsLocomotionState& AAlsCharacter::GetLocomotionState() const
 {
 	return LocomotionState;
 }
+
+inline FAlsCostTracker& AAlsCharacter::GetCostTracker() const
+{
+	return CostTracker;
+}
+
+inline bool AAlsCharacter::AreActionAssetsLoaded(const EAlsActionAssets Assets) const
+{
+	return EnumHasAllFlags(LoadedActionAssets, Assets);
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Notifies/AlsAnimNotify_FootstepEffects.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsFootstepEffectsSubsystem.generated.h"
+
+class UAudioComponent;
+class UDecalComponent;
+class UNiagaraComponent;
+class USkeletalMeshComponent;
+
+USTRUCT()
+struct ALS_API FAlsFootstepEffectsRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+
+	FName FootBoneName;
+
+	FVector FootstepLocation{ForceInit};
+
+	FRotator FootstepRotation{ForceInit};
+
+	// Sound
+
+	UPROPERTY(Transient)
+	TObjectPtr<USoundBase> Sound;
+
+	EAlsFootstepSoundSpawnMode SoundSpawnMode{EAlsFootstepSoundSpawnMode::SpawnAtTraceHitLocation};
+
+	EAlsFootstepSoundType SoundType{EAlsFootstepSoundType::Step};
+
+	float SoundVolumeMultiplier{1.0f};
+
+	float SoundPitchMultiplier{1.0f};
+
+	// Decal
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInterface> DecalMaterial;
+
+	UPROPERTY(Transient)
+	TWeakObjectPtr<USceneComponent> DecalAttachParent;
+
+	FVector DecalSize{ForceInit};
+
+	FVector DecalLocation{ForceInit};
+
+	FRotator DecalRotation{ForceInit};
+
+	float DecalDuration{0.0f};
+
+	float DecalFadeOutDuration{0.0f};
+
+	// Particle System
+
+	UPROPERTY(Transient)
+	TObjectPtr<UNiagaraSystem> ParticleSystem;
+
+	EAlsFootstepParticleEffectSpawnMode ParticleSystemSpawnMode{EAlsFootstepParticleEffectSpawnMode::SpawnAtTraceHitLocation};
+
+	// Relative to the foot bone if the particle system is attached to it.
+	FVector ParticleSystemLocation{ForceInit};
+
+	// Relative to the foot bone if the particle system is attached to it.
+	FRotator ParticleSystemRotation{ForceInit};
+
+	FVector ParticleSystemScale{FVector::OneVector};
+
+	// Scheduling
+
+	// Distance to the nearest view, scaled by the significance of the character. Lower values mean higher priority.
+	float Priority{0.0f};
+
+	int32 ViewIndex{0};
+};
+
+struct ALS_API FAlsActiveFootstepEffect
+{
+	TWeakObjectPtr<UActorComponent> Component;
+
+	int32 ViewIndex{0};
+};
+
+USTRUCT()
+struct ALS_API FAlsPooledFootstepDecal
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TObjectPtr<UDecalComponent> Decal;
+
+	double ExpirationTime{0.0};
+
+	bool bActive{false};
+};
+
+// Manages footstep effects of all characters in a world.
+//
+// Footstep effects are not spawned immediately by animation notifies, but are queued and spawned together at the end
+// of the frame. Queued effects are ranked by distance to the nearest local view and by significance of the character,
+// and the number of spawned and concurrently playing footstep sounds and particle systems is limited per frame and
+// per view. Distant effects are downgraded to sound only, and effects that are too far away are dropped entirely.
+//
+// Footstep decals are taken from a fixed-size ring of recycled decal components, so decal components are not
+// constantly created and destroyed, and the number of live footstep decals never exceeds the budget. When the
+// budget is exhausted, the oldest decal is reused for the new footstep.
+UCLASS()
+class ALS_API UAlsFootstepEffectsSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	UPROPERTY(Transient)
+	TArray<FAlsFootstepEffectsRequest> Requests;
+
+	TArray<FAlsActiveFootstepEffect> ActiveSounds;
+
+	TArray<FAlsActiveFootstepEffect> ActiveParticleSystems;
+
+	UPROPERTY(Transient)
+	TArray<FAlsPooledFootstepDecal> Decals;
+
+	int32 NextDecalIndex{0};
+
+	int32 ActiveDecalsCount{0};
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual bool IsTickableInEditor() const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	void QueueEffects(const FAlsFootstepEffectsRequest& Request);
+
+	bool IsWithinViewDistance(const FVector& Location, float MaxDistance) const;
+
+	UDecalComponent* SpawnDecal(UMaterialInterface* Material, const FVector& Size, const FVector& Location,
+	                            const FRotator& Rotation, USceneComponent* AttachParent, float Duration, float FadeOutDuration);
+
+private:
+	void ProcessRequests();
+
+	UAudioComponent* SpawnSound(const FAlsFootstepEffectsRequest& Request) const;
+
+	UNiagaraComponent* SpawnParticleSystem(const FAlsFootstepEffectsRequest& Request) const;
+
+	void ResizeDecalsPool(int32 NewSize);
+
+	void DeactivateDecal(FAlsPooledFootstepDecal& PooledDecal);
+};
@@ -24,6 +24,8 @@ public:
 
 	virtual void NativeBeginPlay() override;
 
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 protected:
 	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
 
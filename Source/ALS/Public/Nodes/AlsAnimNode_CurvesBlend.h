@@ -3,6 +3,8 @@
 #include "Animation/AnimNodeBase.h"
 #include "AlsAnimNode_CurvesBlend.generated.h"
 
+struct FAnimNode_AssetPlayerBase;
+
 UENUM(BlueprintType)
 enum class EAlsCurvesBlendMode : uint8
 {
@@ -40,6 +42,14 @@ public:
 	EAlsCurvesBlendMode BlendMode{EAlsCurvesBlendMode::BlendByAmount};
 #endif
 
+	// If checked and the curves pose is directly connected to a sequence player or a sequence evaluator, then only the
+	// curves of its sequence are evaluated, without allocating and evaluating the whole pose, which is then discarded anyway.
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	bool bEvaluateCurvesOnly{false};
+
+protected:
+	FAnimNode_AssetPlayerBase* CurvesAssetPlayer{nullptr};
+
 public:
 	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
 
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "BoneContainer.h"
+#include "BoneControllers/AnimNode_SkeletalControlBase.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "State/AlsControlRigInput.h"
+#include "Utility/AlsConstants.h"
+#include "AlsAnimNode_FootIk.generated.h"
+
+USTRUCT()
+struct ALS_API FAlsFootIkLimbBones
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FBoneReference UpperBone;
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FBoneReference LowerBone;
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FBoneReference EndBone;
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FVector PrimaryAxis{FVector::ForwardVector};
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FVector SecondaryAxis{FVector::RightVector};
+
+	// Calculated from the reference pose.
+	float UpperLength{0.0f};
+
+	// Calculated from the reference pose.
+	float LowerLength{0.0f};
+
+public:
+	void Initialize(const FBoneContainer& RequiredBones);
+
+	bool IsValidToEvaluate(const FBoneContainer& RequiredBones) const;
+
+	float GetLength() const;
+};
+
+inline float FAlsFootIkLimbBones::GetLength() const
+{
+	return UpperLength + LowerLength;
+}
+
+// Native alternative to the ALS control rig (CR_Als). Runs the same steps as the rig, in the same order and with the same
+// constants: foot root diagonal scaling, pelvis offset, spine rotation, hand ik and foot ik. The control rig input is taken
+// from the ALS animation instance, and all bone indices and curve identifiers are resolved once when bone references are initialized.
+USTRUCT(BlueprintInternalUseOnly)
+struct ALS_API FAlsAnimNode_FootIk : public FAnimNode_SkeletalControlBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FBoneReference PelvisBone{UAlsConstants::PelvisBoneName()};
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FAlsFootIkLimbBones LeftLeg{
+		FBoneReference{FName{TEXTVIEW("thigh_l")}}, FBoneReference{FName{TEXTVIEW("calf_l")}},
+		FBoneReference{UAlsConstants::FootLeftBoneName()}, -FVector::ForwardVector, FVector::RightVector
+	};
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FAlsFootIkLimbBones RightLeg{
+		FBoneReference{FName{TEXTVIEW("thigh_r")}}, FBoneReference{FName{TEXTVIEW("calf_r")}},
+		FBoneReference{UAlsConstants::FootRightBoneName()}, FVector::ForwardVector, -FVector::RightVector
+	};
+
+	// The spine yaw angle is evenly distributed between these bones. Bones must be listed from parent to child.
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	TArray<FBoneReference> SpineBones{
+		FBoneReference{UAlsConstants::PelvisBoneName()}, FBoneReference{FName{TEXTVIEW("spine_01")}},
+		FBoneReference{FName{TEXTVIEW("spine_02")}}, FBoneReference{UAlsConstants::Spine03BoneName()}
+	};
+
+	// Scaled during diagonal movement when foot ik bones are not used.
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FBoneReference FootRootBone{FName{TEXTVIEW("VB foot_root")}};
+
+	// Scaled during diagonal movement when foot ik bones are used.
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FBoneReference FootIkRootBone{FName{TEXTVIEW("ik_foot_root")}};
+
+	UPROPERTY(EditAnywhere, Category = "Hand Ik")
+	FAlsFootIkLimbBones LeftArm{
+		FBoneReference{FName{TEXTVIEW("upperarm_l")}}, FBoneReference{FName{TEXTVIEW("lowerarm_l")}},
+		FBoneReference{FName{TEXTVIEW("hand_l")}}, FVector::ForwardVector, -FVector::RightVector
+	};
+
+	UPROPERTY(EditAnywhere, Category = "Hand Ik")
+	FAlsFootIkLimbBones RightArm{
+		FBoneReference{FName{TEXTVIEW("upperarm_r")}}, FBoneReference{FName{TEXTVIEW("lowerarm_r")}},
+		FBoneReference{FName{TEXTVIEW("hand_r")}}, -FVector::ForwardVector, FVector::RightVector
+	};
+
+	// Pole vector location relative to the lower bone of the left arm.
+	UPROPERTY(EditAnywhere, Category = "Hand Ik")
+	FVector LeftArmPoleLocation{0.0f, -30.0f, 0.0f};
+
+	// Pole vector location relative to the lower bone of the right arm.
+	UPROPERTY(EditAnywhere, Category = "Hand Ik")
+	FVector RightArmPoleLocation{0.0f, 30.0f, 0.0f};
+
+	// Hand ik target when hand ik bones are not used.
+	UPROPERTY(EditAnywhere, Category = "Hand Ik")
+	FBoneReference HandLeftTargetBone{FName{TEXTVIEW("VB hand_l")}};
+
+	// Hand ik target when hand ik bones are used.
+	UPROPERTY(EditAnywhere, Category = "Hand Ik")
+	FBoneReference HandLeftIkTargetBone{FName{TEXTVIEW("VB ik_hand_l")}};
+
+	// Hand ik target when hand ik bones are not used.
+	UPROPERTY(EditAnywhere, Category = "Hand Ik")
+	FBoneReference HandRightTargetBone{FName{TEXTVIEW("VB hand_r")}};
+
+	// Hand ik target when hand ik bones are used.
+	UPROPERTY(EditAnywhere, Category = "Hand Ik")
+	FBoneReference HandRightIkTargetBone{FName{TEXTVIEW("VB ik_hand_r")}};
+
+	UPROPERTY(VisibleAnywhere, Category = "State", Transient)
+	FAlsControlRigInput Input;
+
+protected:
+	float DeltaTime{0.0f};
+
+	float PelvisOffsetZ{0.0f};
+
+	FFloatSpringState PelvisOffsetSpringState;
+
+	bool bLegPoleLocationsInitialized{false};
+
+	FVector LeftLegPoleLocation{ForceInit};
+
+	FVector RightLegPoleLocation{ForceInit};
+
+	SmartName::UID_Type PoseMovingCurveUid{SmartName::MaxUID};
+
+	SmartName::UID_Type LayerArmLeftCurveUid{SmartName::MaxUID};
+
+	SmartName::UID_Type LayerArmRightCurveUid{SmartName::MaxUID};
+
+	SmartName::UID_Type HandLeftIkCurveUid{SmartName::MaxUID};
+
+	SmartName::UID_Type HandRightIkCurveUid{SmartName::MaxUID};
+
+	// Reused between evaluations to avoid allocations.
+	TArray<FBoneTransform> BoneTransforms;
+
+public:
+	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+
+	virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+
+	virtual void EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms) override;
+
+	virtual bool IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones) override;
+
+protected:
+	virtual void UpdateInternal(const FAnimationUpdateContext& Context) override;
+
+	void InitializeRig(const FBoneContainer& RequiredBones);
+
+	void EvaluateRig(FCSPose<FCompactPose>& Pose, const FBlendedCurve& Curve);
+
+private:
+	virtual void InitializeBoneReferences(const FBoneContainer& RequiredBones) override;
+
+	void ApplyTransforms(FCSPose<FCompactPose>& Pose);
+
+	void RefreshDiagonalScaling(FCSPose<FCompactPose>& Pose, const FBlendedCurve& Curve);
+
+	void RefreshPelvisOffset(FCSPose<FCompactPose>& Pose);
+
+	void RefreshSpineRotation(FCSPose<FCompactPose>& Pose);
+
+	void RefreshHandIk(FCSPose<FCompactPose>& Pose, const FBlendedCurve& Curve);
+
+	void RefreshFootIk(FCSPose<FCompactPose>& Pose);
+
+	void SolveTwoBoneIk(FCSPose<FCompactPose>& Pose, const FAlsFootIkLimbBones& Limb,
+	                    const FTransform& EffectorTransform, const FVector& PoleLocation, float Weight);
+};
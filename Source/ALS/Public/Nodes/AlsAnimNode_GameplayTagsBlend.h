@@ -4,6 +4,9 @@
 #include "AnimNodes/AnimNode_BlendListBase.h"
 #include "AlsAnimNode_GameplayTagsBlend.generated.h"
 
+// Selects a child pose by gameplay tag. Set the transition type to inertialization to switch between poses by
+// evaluating only the new pose and a decaying offset instead of crossfading two poses. This requires an
+// inertialization node somewhere after this node in the animation graph.
 USTRUCT()
 struct ALS_API FAlsAnimNode_GameplayTagsBlend : public FAnimNode_BlendListBase
 {
@@ -18,6 +21,14 @@ public:
 	TArray<FGameplayTag> Tags;
 #endif
 
+protected:
+	// Maps tags to the indices of their child poses. Built once on initialization, so the active child
+	// index can be found without a linear search through the tags on every update.
+	TMap<FGameplayTag, int32> TagIndices;
+
+public:
+	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+
 protected:
 	virtual int32 GetActiveChildIndex() override;
 
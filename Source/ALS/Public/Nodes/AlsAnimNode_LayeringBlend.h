@@ -0,0 +1,105 @@
+#pragma once
+
+#include "BoneContainer.h"
+#include "Animation/AnimNodeBase.h"
+#include "State/AlsLayeringState.h"
+#include "Utility/AlsConstants.h"
+#include "AlsAnimNode_LayeringBlend.generated.h"
+
+enum class EAlsLayeringBoneRegion : uint8
+{
+	None,
+	Pelvis,
+	Legs,
+	Spine,
+	Head,
+	ArmLeft,
+	ArmRight,
+	HandLeft,
+	HandRight
+};
+
+// Combines the base, overlay and slot poses using the layering state in a single pass over the bones, replacing
+// the chain of layered blend per bone, additive and blend nodes that is otherwise needed for each body region.
+// Each bone is assigned to the body region of its nearest region root bone once when bones are cached, so no
+// per-bone blend masks have to be built or sampled during evaluation.
+USTRUCT(BlueprintInternalUseOnly)
+struct ALS_API FAlsAnimNode_LayeringBlend : public FAnimNode_Base
+{
+	GENERATED_BODY()
+
+public:
+	// Locomotion pose without overlay.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
+	FPoseLink BasePose;
+
+	// Overlay base pose for the current stance. The difference between the base pose and this pose
+	// is the additive that is applied on top of the overlay pose by the additive blend amounts.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
+	FPoseLink BaseReferencePose;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
+	FPoseLink OverlayPose;
+
+	// Usually a slot node that plays layering montages. Blended on top of the layered pose by the slot blend amounts.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
+	FPoseLink SlotPose;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings", Meta = (PinShownByDefault))
+	FAlsLayeringState LayeringState;
+
+	// Name of the slot used by the slot pose. The slot pose is evaluated only while a montage is playing in this slot.
+	UPROPERTY(EditAnywhere, Category = "Settings", Meta = (NeverAsPin))
+	FName SlotName{TEXTVIEW("Layering")};
+
+	UPROPERTY(EditAnywhere, Category = "Bone Regions", Meta = (NeverAsPin))
+	FBoneReference PelvisBone{UAlsConstants::PelvisBoneName()};
+
+	UPROPERTY(EditAnywhere, Category = "Bone Regions", Meta = (NeverAsPin))
+	FBoneReference LegLeftBone{FName{TEXTVIEW("thigh_l")}};
+
+	UPROPERTY(EditAnywhere, Category = "Bone Regions", Meta = (NeverAsPin))
+	FBoneReference LegRightBone{FName{TEXTVIEW("thigh_r")}};
+
+	UPROPERTY(EditAnywhere, Category = "Bone Regions", Meta = (NeverAsPin))
+	FBoneReference SpineBone{FName{TEXTVIEW("spine_01")}};
+
+	UPROPERTY(EditAnywhere, Category = "Bone Regions", Meta = (NeverAsPin))
+	FBoneReference HeadBone{FName{TEXTVIEW("neck_01")}};
+
+	UPROPERTY(EditAnywhere, Category = "Bone Regions", Meta = (NeverAsPin))
+	FBoneReference ArmLeftBone{FName{TEXTVIEW("clavicle_l")}};
+
+	UPROPERTY(EditAnywhere, Category = "Bone Regions", Meta = (NeverAsPin))
+	FBoneReference ArmRightBone{FName{TEXTVIEW("clavicle_r")}};
+
+	UPROPERTY(EditAnywhere, Category = "Bone Regions", Meta = (NeverAsPin))
+	FBoneReference HandLeftBone{FName{TEXTVIEW("hand_l")}};
+
+	UPROPERTY(EditAnywhere, Category = "Bone Regions", Meta = (NeverAsPin))
+	FBoneReference HandRightBone{FName{TEXTVIEW("hand_r")}};
+
+protected:
+	// Body region of each bone, indexed by compact pose bone index.
+	TArray<EAlsLayeringBoneRegion> BoneRegions;
+
+	float SlotWeight{0.0f};
+
+public:
+	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+
+	virtual void CacheBones_AnyThread(const FAnimationCacheBonesContext& Context) override;
+
+	virtual void Update_AnyThread(const FAnimationUpdateContext& Context) override;
+
+	virtual void Evaluate_AnyThread(FPoseContext& Output) override;
+
+	virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+
+private:
+	float GetMaxOverlayBlendAmount() const;
+
+	float GetMaxAdditiveBlendAmount() const;
+
+	float GetMaxSlotBlendAmount() const;
+};
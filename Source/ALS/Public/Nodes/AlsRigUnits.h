@@ -134,3 +134,71 @@ public:
 	RIGVM_METHOD()
 	virtual void Execute() override;
 };
+
+// Moves the same bones by the same offset as the Hand Ik Retargeting node, but all global transforms are read before any bone
+// is moved, so they are not recalculated between the moves. Each write still marks the children of the bone as dirty when
+// propagating to children. Bones must be listed from parent to child. Unlike the Hand Ik Retargeting node, a bone is moved
+// by the offset exactly once even if its parent is also listed and children are propagated, since the Hand Ik Retargeting
+// node moves such a bone once along with its parent and once more on its own.
+USTRUCT(DisplayName = "Hand Ik Retargeting (Batched)", Meta = (Category = "ALS", NodeColor = "0 0.36 1.0"))
+struct ALS_API FAlsRigUnit_HandIkRetargetingBatched : public FRigUnitMutable
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(Meta = (Input, ExpandByDefault))
+	FRigElementKey LeftHandBone;
+
+	UPROPERTY(Meta = (Input, ExpandByDefault))
+	FRigElementKey LeftHandIkBone;
+
+	UPROPERTY(Meta = (Input, ExpandByDefault))
+	FRigElementKey RightHandBone;
+
+	UPROPERTY(Meta = (Input, ExpandByDefault))
+	FRigElementKey RightHandIkBone;
+
+	UPROPERTY(Meta = (Input, ExpandByDefault))
+	TArray<FRigElementKey> BonesToMove;
+
+	// Which hand to favor. 0.5 is equal weight for both, 1 - right hand, 0 - left hand.
+	UPROPERTY(Meta = (Input))
+	float RetargetingWeight{0.5f};
+
+	UPROPERTY(Meta = (Input))
+	float Weight{1.0f};
+
+	UPROPERTY(Meta = (Input, Constant))
+	bool bPropagateToChildren{false};
+
+	UPROPERTY(Transient)
+	bool bInitialized{false};
+
+	UPROPERTY(Transient)
+	FCachedRigElement CachedLeftHandBone;
+
+	UPROPERTY(Transient)
+	FCachedRigElement CachedLeftHandIkBone;
+
+	UPROPERTY(Transient)
+	FCachedRigElement CachedRightHandBone;
+
+	UPROPERTY(Transient)
+	FCachedRigElement CachedRightHandIkBone;
+
+	UPROPERTY(Transient)
+	TArray<FCachedRigElement> CachedBonesToMove;
+
+	// Indices of valid elements in CachedBonesToMove, gathered on each execution.
+	UPROPERTY(Transient)
+	TArray<int32> ValidBoneIndices;
+
+	UPROPERTY(Transient)
+	TArray<FTransform> BoneTransforms;
+
+public:
+	virtual void Initialize() override;
+
+	RIGVM_METHOD()
+	virtual void Execute() override;
+};
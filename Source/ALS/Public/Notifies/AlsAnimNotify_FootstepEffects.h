@@ -1,14 +1,16 @@
 #pragma once
 
 #include "Animation/AnimNotifies/AnimNotify.h"
+#include "Chaos/ChaosEngineInterface.h"
 #include "Engine/DataAsset.h"
 #include "AlsAnimNotify_FootstepEffects.generated.h"
 
 enum ETraceTypeQuery : int;
-enum EPhysicalSurface : int;
 class USoundBase;
 class UMaterialInterface;
 class UNiagaraSystem;
+struct FStreamableHandle;
+struct FHitResult;
 
 UENUM(BlueprintType)
 enum class EAlsFootBone : uint8
@@ -97,6 +99,21 @@ struct ALS_API FAlsFootstepEffectSettings
 	FRotator3f ParticleSystemFootRightRotationOffset{ForceInit};
 };
 
+USTRUCT(BlueprintType)
+struct ALS_API FAlsFootstepEffectAssets
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Transient)
+	TObjectPtr<USoundBase> Sound;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Transient)
+	TObjectPtr<UMaterialInterface> DecalMaterial;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Transient)
+	TObjectPtr<UNiagaraSystem> ParticleSystem;
+};
+
 UCLASS(Blueprintable, BlueprintType)
 class ALS_API UAlsFootstepEffectsSettings : public UDataAsset
 {
@@ -109,6 +126,20 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 0, ForceUnits = "cm"))
 	float SurfaceTraceDistance{50.0f};
 
+	// If checked, the latest foot IK ground hit of the ALS animation instance is used instead of the surface trace when it
+	// is recent and close enough to the foot. The foot IK trace channel should block the same geometry as the surface trace channel.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	bool bReuseFootIkGroundHit{true};
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings",
+		Meta = (ClampMin = 0, ForceUnits = "s", EditCondition = "bReuseFootIkGroundHit"))
+	float FootIkGroundHitMaxAge{0.1f};
+
+	// Maximum horizontal distance between the foot IK ground hit and the foot bone.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings",
+		Meta = (ClampMin = 0, ForceUnits = "cm", EditCondition = "bReuseFootIkGroundHit"))
+	float FootIkGroundHitMaxDistance{10.0f};
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", DisplayName = "Foot Left Y Axis")
 	FVector3f FootLeftYAxis{0.0f, 0.0f, 1.0f};
 
@@ -123,6 +154,48 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ForceInlineRow))
 	TMap<TEnumAsByte<EPhysicalSurface>, FAlsFootstepEffectSettings> Effects;
+
+	// The effect of this surface is used for all surfaces that don't have their own effect. If this surface doesn't
+	// have an effect either, the effect of the surface with the lowest value is used instead.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	TEnumAsByte<EPhysicalSurface> DefaultEffectSurface;
+
+	// Effects compiled from the effects map when the settings are loaded or changed, so that the
+	// effect of any surface can be found by a simple lookup in the surface effect indices array.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	TArray<FAlsFootstepEffectSettings> CompiledEffects;
+
+	// Index of the compiled effect for each surface type, or INDEX_NONE if the surface doesn't have any effect.
+	TStaticArray<int8, SurfaceType_Max> SurfaceEffectIndices{InPlace, static_cast<int8>(INDEX_NONE)};
+
+	// Already loaded assets of each compiled effect. All assets are streamed asynchronously, and
+	// effects whose assets are not loaded yet are skipped instead of being loaded synchronously.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	TArray<FAlsFootstepEffectAssets> LoadedEffects;
+
+private:
+	TSharedPtr<FStreamableHandle> EffectsLoadHandle;
+
+public:
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	virtual EDataValidationResult IsDataValid(TArray<FText>& ValidationErrors) override;
+#endif
+
+	int32 GetEffectIndex(EPhysicalSurface SurfaceType) const;
+
+	// Starts asynchronous loading of all effect assets. This is done automatically when the settings are
+	// loaded, but can also be called manually, for example, when a level that uses these settings is loaded.
+	UFUNCTION(BlueprintCallable, Category = "ALS|Footstep Effects Settings")
+	void LoadEffectsAsync();
+
+private:
+	void CompileEffects();
+
+	void RefreshLoadedEffects();
 };
 
 UCLASS(DisplayName = "Als Footstep Effects Animation Notify",
@@ -167,4 +240,7 @@ public:
 
 	virtual void Notify(USkeletalMeshComponent* Mesh, UAnimSequenceBase* Animation,
 	                    const FAnimNotifyEventReference& EventReference) override;
+
+private:
+	bool TryGetFootIkGroundHit(const USkeletalMeshComponent* Mesh, const FVector& FootLocation, FHitResult& Hit) const;
 };
@@ -0,0 +1,15 @@
+﻿#pragma once
+
+#include "AlsActionAssets.generated.h"
+
+// Groups of assets used by rarely performed actions that can be loaded on demand instead of with the character.
+UENUM(BlueprintType, Meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EAlsActionAssets : uint8
+{
+	None = 0 UMETA(Hidden),
+	Rolling = 1 << 0,
+	GettingUp = 1 << 1,
+	Mantling = 1 << 2
+};
+
+ENUM_CLASS_FLAGS(EAlsActionAssets)
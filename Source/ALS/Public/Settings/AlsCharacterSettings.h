@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "AlsActionAssets.h"
 #include "AlsInAirRotationMode.h"
 #include "AlsMantlingSettings.h"
 #include "AlsRagdollingSettings.h"
@@ -49,6 +50,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	FAlsRollingSettings Rolling;
 
+	// Action assets that are loaded as soon as a character begins play. Other action assets are loaded on demand, and
+	// their actions are not allowed to start until the assets are loaded, so characters that rarely perform some
+	// actions, such as crowd characters, can leave them out to avoid keeping their assets in memory.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (Bitmask, BitmaskEnum = "/Script/ALS.EAlsActionAssets"))
+	int32 PreloadedActionAssets{
+		static_cast<int32>(EAlsActionAssets::Rolling | EAlsActionAssets::GettingUp | EAlsActionAssets::Mantling)
+	};
+
 public:
 	UAlsCharacterSettings();
 
@@ -45,7 +45,7 @@ class ALS_API UAlsMantlingSettings : public UDataAsset
 
 public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
-	TObjectPtr<UAnimMontage> Montage;
+	TSoftObjectPtr<UAnimMontage> Montage;
 
 	// Mantling time to blend in amount curve.
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
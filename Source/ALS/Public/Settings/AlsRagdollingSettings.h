@@ -32,10 +32,10 @@ public:
 	FCollisionResponseContainer GroundTraceResponses{ECR_Ignore};
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
-	TObjectPtr<UAnimMontage> GetUpFrontMontage{nullptr};
+	TSoftObjectPtr<UAnimMontage> GetUpFrontMontage;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
-	TObjectPtr<UAnimMontage> GetUpBackMontage{nullptr};
+	TSoftObjectPtr<UAnimMontage> GetUpBackMontage;
 
 public:
 #if WITH_EDITOR
@@ -3,6 +3,33 @@
 #include "Utility/AlsMath.h"
 #include "AlsFeetState.generated.h"
 
+class UPrimitiveComponent;
+class UPhysicalMaterial;
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsFootGroundHit
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	bool bValid{false};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ForceUnits = "s"))
+	float Time{0.0f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	FVector ImpactPoint{ForceInit};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	FVector ImpactNormal{FVector::UpVector};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	TWeakObjectPtr<UPhysicalMaterial> PhysicalMaterial;
+};
+
 USTRUCT(BlueprintType)
 struct ALS_API FAlsFootState
 {
@@ -58,6 +85,11 @@ struct ALS_API FAlsFootState
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	FQuat IkRotation{ForceInit};
+
+	// The latest ground hit of the foot offset trace. Can be reused by other systems, such as
+	// footstep effects, to avoid performing additional traces under the same foot.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	FAlsFootGroundHit GroundHit;
 };
 
 USTRUCT(BlueprintType)
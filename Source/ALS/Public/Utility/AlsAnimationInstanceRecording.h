@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Engine/HitResult.h"
+#include "AlsAnimationInstanceRecording.generated.h"
+
+// Everything that UAlsAnimationInstance::NativeThreadSafeUpdateAnimation() and UAlsAnimationInstance::RefreshLook() consumed during a single frame.
+USTRUCT()
+struct ALS_API FAlsAnimationInstanceRecordedFrame
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	float DeltaTime{0.0f};
+
+	UPROPERTY()
+	double WorldTime{0.0};
+
+	UPROPERTY()
+	FTransform ComponentTransform;
+
+	UPROPERTY()
+	TMap<FName, float> Curves;
+
+	// Results of the scene queries in the order in which they were issued.
+	UPROPERTY()
+	TArray<FHitResult> SceneQueryHits;
+
+	// Number of times UAlsAnimationInstance::RefreshLook() was called by the linked animation layers after the thread safe update.
+	UPROPERTY()
+	int32 LookRefreshesCount{0};
+
+	// Serialized animation instance state before the update.
+	UPROPERTY()
+	TArray<uint8> InputState;
+
+	// Serialized animation instance state after the update. Used to check that a replay produces bit-for-bit identical results.
+	UPROPERTY()
+	TArray<uint8> OutputState;
+};
+
+USTRUCT()
+struct ALS_API FAlsAnimationInstanceRecording
+{
+	GENERATED_BODY()
+
+	// Must be incremented whenever the format of the recording changes. Files of other versions are refused when loading.
+	static constexpr uint32 FileVersion{1};
+
+	// Hash of the layout of the serialized animation instance state. A recording is refused
+	// by animation instances whose state layout differs from the one it was recorded with.
+	UPROPERTY()
+	uint32 StateLayoutHash{0};
+
+	UPROPERTY()
+	TArray<FAlsAnimationInstanceRecordedFrame> Frames;
+
+public:
+	bool SaveToFile(const FString& FilePath) const;
+
+	bool LoadFromFile(const FString& FilePath);
+};
+
+struct ALS_API FAlsAnimationInstanceReplayResult
+{
+	int32 FramesCount{0};
+
+	int32 MismatchedFramesCount{0};
+
+	int32 FirstMismatchedFrameIndex{INDEX_NONE};
+
+	double TotalMilliseconds{0.0};
+
+	double MinIterationMilliseconds{0.0};
+};
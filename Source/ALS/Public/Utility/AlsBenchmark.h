@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+
+// Lightweight timers for the ALS hot paths, independent of the stats system, so that their cost can be measured in
+// shipping-like builds and on headless build agents. Timers only record anything while a benchmark is running.
+struct ALS_API FAlsBenchmarkTimer
+{
+	const TCHAR* Name{nullptr};
+
+	std::atomic<uint64> Cycles{0};
+
+	std::atomic<uint32> Calls{0};
+
+public:
+	explicit FAlsBenchmarkTimer(const TCHAR* InName);
+
+	void Reset();
+
+	double GetMilliseconds() const;
+};
+
+class ALS_API FAlsBenchmark
+{
+public:
+	static FAlsBenchmarkTimer CharacterTick;
+
+	static FAlsBenchmarkTimer NativeUpdateAnimation;
+
+	static FAlsBenchmarkTimer NativeThreadSafeUpdateAnimation;
+
+	static FAlsBenchmarkTimer CameraTick;
+
+	static FAlsBenchmarkTimer CameraBatchTick;
+
+private:
+	static std::atomic<bool> bActive;
+
+public:
+	static bool IsActive();
+
+	static void Start();
+
+	static void Stop();
+
+	static TConstArrayView<FAlsBenchmarkTimer*> GetTimers();
+};
+
+inline bool FAlsBenchmark::IsActive()
+{
+	return bActive.load(std::memory_order_relaxed);
+}
+
+class FAlsBenchmarkScope
+{
+private:
+	FAlsBenchmarkTimer* Timer;
+
+	uint64 StartCycles;
+
+public:
+	explicit FAlsBenchmarkScope(FAlsBenchmarkTimer& InTimer)
+		: Timer{FAlsBenchmark::IsActive() ? &InTimer : nullptr},
+		  StartCycles{Timer != nullptr ? FPlatformTime::Cycles64() : 0} {}
+
+	~FAlsBenchmarkScope()
+	{
+		if (Timer != nullptr)
+		{
+			Timer->Cycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+			Timer->Calls.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+};
+
+#define ALS_BENCHMARK_SCOPE(Timer) const FAlsBenchmarkScope ANONYMOUS_VARIABLE(AlsBenchmarkScope){FAlsBenchmark::Timer};
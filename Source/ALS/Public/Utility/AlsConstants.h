@@ -211,6 +211,12 @@ public:
 
 	UFUNCTION(BlueprintPure, Category = "ALS|Als Constants", Meta = (ReturnDisplayName = "Display Name"))
 	static const FName& MantlingDebugDisplayName();
+
+	UFUNCTION(BlueprintPure, Category = "ALS|Als Constants", Meta = (ReturnDisplayName = "Display Name"))
+	static const FName& CostDebugDisplayName();
+
+	UFUNCTION(BlueprintPure, Category = "ALS|Als Constants", Meta = (ReturnDisplayName = "Display Name"))
+	static const FName& MemoryDebugDisplayName();
 };
 
 inline const FName& UAlsConstants::RootBoneName()
@@ -590,3 +596,15 @@ inline const FName& UAlsConstants::MantlingDebugDisplayName()
 	static const FName Name{TEXTVIEW("ALS.Mantling")};
 	return Name;
 }
+
+inline const FName& UAlsConstants::CostDebugDisplayName()
+{
+	static const FName Name{TEXTVIEW("ALS.Cost")};
+	return Name;
+}
+
+inline const FName& UAlsConstants::MemoryDebugDisplayName()
+{
+	static const FName Name{TEXTVIEW("ALS.Memory")};
+	return Name;
+}
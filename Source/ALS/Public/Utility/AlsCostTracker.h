@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+
+enum class EAlsCostCategory : uint8
+{
+	// Game thread.
+
+	CharacterTick,
+	AnimationUpdate,
+
+	// Animation worker thread.
+
+	AnimationThreadSafeUpdate,
+	Layering,
+	Pose,
+	View,
+	Grounded,
+	InAir,
+	Feet,
+	Transitions,
+	RotateInPlace,
+	TurnInPlace,
+
+	Count
+};
+
+// Per-character cost counters for the Als.Cost debug page. Nothing is recorded unless the page was drawn for the
+// character during the previous frame, so the tracker costs a single atomic load per scope the rest of the time.
+struct ALS_API FAlsCostTracker
+{
+	// Smoothing factor of the rolling averages. Lower values produce more stable but slower reacting numbers.
+	static constexpr auto AverageAlpha{0.05f};
+
+private:
+	std::atomic<uint64> LastRequestFrame{0};
+
+	std::atomic<uint64> Cycles[static_cast<int32>(EAlsCostCategory::Count)]{};
+
+	std::atomic<int32> SceneQueries{0};
+
+	std::atomic<int32> RemoteFunctionCalls{0};
+
+	std::atomic<int32> RemoteFunctionBytes{0};
+
+	std::atomic<int32> ReplicationUpdates{0};
+
+	float AverageMilliseconds[static_cast<int32>(EAlsCostCategory::Count)]{};
+
+	int32 LastFrameSceneQueries{0};
+
+	int32 LastFrameRemoteFunctionCalls{0};
+
+	int32 LastFrameRemoteFunctionBytes{0};
+
+	int32 LastFrameReplicationUpdates{0};
+
+public:
+	static const TCHAR* GetCategoryName(EAlsCostCategory Category);
+
+	bool IsEnabled() const;
+
+	// Must be called every frame while the cost should be recorded, usually by the debug page itself.
+	void Request();
+
+	// Folds the counters of the previous frame into the rolling averages. Must be called once per frame on the game thread.
+	void BeginFrame();
+
+	void AddCycles(EAlsCostCategory Category, uint64 NewCycles);
+
+	void AddSceneQuery();
+
+	void AddRemoteFunctionCall(int32 ParametersSize);
+
+	void AddReplicationUpdate();
+
+	float GetAverageMilliseconds(EAlsCostCategory Category) const;
+
+	int32 GetSceneQueries() const;
+
+	int32 GetRemoteFunctionCalls() const;
+
+	int32 GetRemoteFunctionBytes() const;
+
+	int32 GetReplicationUpdates() const;
+};
+
+inline bool FAlsCostTracker::IsEnabled() const
+{
+	return GFrameCounter - LastRequestFrame.load(std::memory_order_relaxed) <= 1;
+}
+
+inline void FAlsCostTracker::AddCycles(const EAlsCostCategory Category, const uint64 NewCycles)
+{
+	Cycles[static_cast<int32>(Category)].fetch_add(NewCycles, std::memory_order_relaxed);
+}
+
+inline void FAlsCostTracker::AddSceneQuery()
+{
+	if (IsEnabled())
+	{
+		SceneQueries.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+inline float FAlsCostTracker::GetAverageMilliseconds(const EAlsCostCategory Category) const
+{
+	return AverageMilliseconds[static_cast<int32>(Category)];
+}
+
+inline int32 FAlsCostTracker::GetSceneQueries() const
+{
+	return LastFrameSceneQueries;
+}
+
+inline int32 FAlsCostTracker::GetRemoteFunctionCalls() const
+{
+	return LastFrameRemoteFunctionCalls;
+}
+
+inline int32 FAlsCostTracker::GetRemoteFunctionBytes() const
+{
+	return LastFrameRemoteFunctionBytes;
+}
+
+inline int32 FAlsCostTracker::GetReplicationUpdates() const
+{
+	return LastFrameReplicationUpdates;
+}
+
+class FAlsCostScope
+{
+private:
+	FAlsCostTracker* Tracker;
+
+	EAlsCostCategory Category;
+
+	uint64 StartCycles;
+
+public:
+	FAlsCostScope(FAlsCostTracker& InTracker, const EAlsCostCategory InCategory)
+		: Tracker{InTracker.IsEnabled() ? &InTracker : nullptr},
+		  Category{InCategory},
+		  StartCycles{Tracker != nullptr ? FPlatformTime::Cycles64() : 0} {}
+
+	~FAlsCostScope()
+	{
+		if (Tracker != nullptr)
+		{
+			Tracker->AddCycles(Category, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+};
+
+#define ALS_COST_SCOPE(Tracker, Category) const FAlsCostScope ANONYMOUS_VARIABLE(AlsCostScope){Tracker, EAlsCostCategory::Category};
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "ProfilingDebugging/CsvProfiler.h"
+
+// Per frame ALS counters for the CSV profiler, captured with csvprofile start / stop or -csvCaptureFrames.
+// Counters compile to nothing when the CSV profiler is disabled, and their values are only evaluated while capturing.
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ALS_API, Als);
+
+#define ALS_CSV_ACCUMULATE(StatName, Value) CSV_CUSTOM_STAT(Als, StatName, Value, ECsvCustomStatOp::Accumulate)
@@ -138,6 +138,10 @@ public:
 		DisplayName = "Slerp (Skip Normalization)", Meta = (AutoCreateRefTerm = "From, To", ReturnDisplayName = "Direction"))
 	static FVector SlerpSkipNormalization(const FVector& From, const FVector& To, float Alpha);
 
+	// Calculates the direction from the projection of B onto the line AC to B. Falls back to the AB direction if A and C overlap.
+	static bool TryCalculatePoleVector(const FVector& ALocation, const FVector& BLocation, const FVector& CLocation,
+	                                   FVector& ProjectionLocation, FVector& Direction);
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Als Math|Input", Meta = (ReturnDisplayName = "Direction"))
 	static EAlsMovementDirection CalculateMovementDirection(float Angle, float ForwardHalfAngle, float AngleThreshold);
 };
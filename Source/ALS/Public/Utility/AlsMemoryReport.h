@@ -0,0 +1,46 @@
+#pragma once
+
+class AAlsCharacter;
+
+struct ALS_API FAlsMemoryReportEntry
+{
+	FString Name;
+
+	// Nesting level, used to indent the entry.
+	int32 Depth{0};
+
+	SIZE_T Bytes{0};
+};
+
+// Approximate memory footprint of a single ALS character: the actor, its components (including the camera component and the
+// saved moves of the character movement component) and the animation instances of its skeletal meshes (including linked layer
+// instances). Each object is measured by its class size, the allocations behind its properties, and its exclusive resource size.
+// Data assets referenced by these objects, such as settings, are shared between characters, so they are listed separately and
+// are not counted against the character budget.
+struct ALS_API FAlsMemoryReport
+{
+	TArray<FAlsMemoryReportEntry> Entries;
+
+	TArray<FAlsMemoryReportEntry> SharedEntries;
+
+	SIZE_T TotalBytes{0};
+
+	SIZE_T SharedBytes{0};
+
+public:
+	void Gather(const AAlsCharacter* Character);
+
+	bool IsOverBudget() const;
+
+	// Budget of a single character in bytes, or 0 if there is no budget.
+	static SIZE_T GetCharacterBudgetBytes();
+
+	// Budget of all characters in a world in bytes, or 0 if there is no budget.
+	static SIZE_T GetTotalBudgetBytes();
+};
+
+inline bool FAlsMemoryReport::IsOverBudget() const
+{
+	const auto BudgetBytes{GetCharacterBudgetBytes()};
+	return BudgetBytes > 0 && TotalBytes > BudgetBytes;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Utility/AlsBenchmark.h"
+#include "Utility/AlsCostTracker.h"
+#include "Utility/AlsCsvProfiler.h"
+#include "Utility/AlsTrace.h"
+#include "Utility/AlsUtility.h"
+
+// Helpers that feed every ALS profiling sink at once, so that call sites can't forget one of them.
+
+namespace AlsProfiling
+{
+	inline void AddSceneQuery(FAlsCostTracker& Tracker)
+	{
+		Tracker.AddSceneQuery();
+	}
+
+	// Overload for queries that may be performed on behalf of actors other than ALS characters.
+	inline void AddSceneQuery(FAlsCostTracker* Tracker)
+	{
+		if (Tracker != nullptr)
+		{
+			Tracker->AddSceneQuery();
+		}
+	}
+}
+
+// Profiles a scope with the stats system, Unreal Insights, the given benchmark timer and the given category of the cost
+// tracker. Like other ALS stats, the stat name gets the "()" suffix, while the Unreal Insights event name is used as is.
+#define ALS_PROFILE_SCOPE(Name, StatName, BenchmarkTimer, Tracker, CostCategory) \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT(Name) TEXT("()"), STAT_##StatName, STATGROUP_Als) \
+	ALS_TRACE_SCOPE(Name) \
+	ALS_BENCHMARK_SCOPE(BenchmarkTimer) \
+	ALS_COST_SCOPE(Tracker, CostCategory)
+
+// Counts a scene query (trace, sweep or overlap) towards the ALS scene queries per frame counter of Unreal Insights, the
+// given CSV profiler stat and the cost tracker (reference or nullable pointer) of the character that performs the query.
+#define ALS_SCENE_QUERY(CsvStatName, Tracker) \
+	do \
+	{ \
+		ALS_TRACE_SCENE_QUERY(); \
+		ALS_CSV_ACCUMULATE(CsvStatName, 1); \
+		AlsProfiling::AddSceneQuery(Tracker); \
+	} \
+	while (false)
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+// Fine-grained ALS events for Unreal Insights. Enable with -trace=cpu,als or with the Trace.Enable als console command.
+// Events and counters compile to nothing in shipping builds or when tracing is disabled.
+
+#define ALS_TRACE_ENABLED (UE_TRACE_ENABLED && CPUPROFILERTRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+#if ALS_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_EXTERN(AlsChannel, ALS_API)
+
+namespace AlsTrace
+{
+	ALS_API void AddSceneQuery();
+
+	ALS_API void AddCharacter(int32 LodIndex);
+
+	// Called at the end of each frame by the ALS module.
+	void PublishCounters();
+}
+
+#define ALS_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, AlsChannel)
+
+// Counts a scene query (trace, sweep or overlap) towards the ALS scene queries per frame counter.
+#define ALS_TRACE_SCENE_QUERY() AlsTrace::AddSceneQuery()
+
+// Counts a character towards the ALS characters per LOD counters.
+#define ALS_TRACE_CHARACTER(LodIndex) AlsTrace::AddCharacter(LodIndex)
+
+#else
+
+#define ALS_TRACE_SCOPE(Name)
+#define ALS_TRACE_SCENE_QUERY()
+#define ALS_TRACE_CHARACTER(LodIndex)
+
+#endif
@@ -35,6 +35,13 @@ void UAlsCameraAnimationInstance::NativeUpdateAnimation(const float DeltaTime)
 {
 	Super::NativeUpdateAnimation(DeltaTime);
 
+#if WITH_EDITORONLY_DATA
+	if (bStateOverridden)
+	{
+		return;
+	}
+#endif
+
 	if (!IsValid(Character) || !IsValid(Camera))
 	{
 		return;
@@ -49,3 +56,19 @@ void UAlsCameraAnimationInstance::NativeUpdateAnimation(const float DeltaTime)
 
 	bRightShoulder = Camera->IsRightShoulder();
 }
+
+#if WITH_EDITOR
+void UAlsCameraAnimationInstance::OverrideState(const FAlsCameraCurvesContext& State)
+{
+	bStateOverridden = true;
+
+	ViewMode = State.ViewMode;
+	LocomotionMode = State.LocomotionMode;
+	RotationMode = State.RotationMode;
+	Stance = State.Stance;
+	Gait = State.Gait;
+	LocomotionAction = State.LocomotionAction;
+
+	bRightShoulder = State.bRightShoulder;
+}
+#endif
@@ -1,23 +1,76 @@
 #include "AlsCameraComponent.h"
 
 #include "AlsCameraSettings.h"
+#include "AlsCharacter.h"
 #include "DrawDebugHelpers.h"
 #include "Animation/AnimInstance.h"
+#include "Async/ParallelFor.h"
+#include "Engine/SkeletalMesh.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/WorldSettings.h"
+#include "Utility/AlsBenchmark.h"
 #include "Utility/AlsCameraConstants.h"
 #include "Utility/AlsMacros.h"
+#include "Utility/AlsProfiling.h"
 #include "Utility/AlsUtility.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsCameraComponent)
 
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Camera Tick Deferral Time (ms)"),
+                               STAT_AlsCamera_TickDeferralTime, STATGROUP_Als)
+
+void FAlsCameraTickFunction::ExecuteTick(const float DeltaTime, const ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                                         const FGraphEventRef& CompletionGraphEvent)
+{
+	FActorComponentTickFunction::ExecuteTickHelper(Camera, false, DeltaTime, TickType, [this](float)
+	{
+		if (!Camera->IsComponentTickEnabled())
+		{
+			return;
+		}
+
+		if (Camera->ParallelEvaluationStartTime > 0.0)
+		{
+			// Time between the start of the parallel animation evaluation and the camera update. This is not the stall time
+			// actually saved, but its upper bound, since the game thread may have been idle for part of this time.
+
+			INC_FLOAT_STAT_BY(STAT_AlsCamera_TickDeferralTime,
+			                  (FPlatformTime::Seconds() - Camera->ParallelEvaluationStartTime) * 1000.0);
+
+			Camera->ParallelEvaluationStartTime = 0.0;
+		}
+
+		Camera->TickCamera(Camera->CameraDeltaTime);
+	});
+}
+
+FString FAlsCameraTickFunction::DiagnosticMessage()
+{
+	return Camera->GetFullName() + TEXT("[TickCamera]");
+}
+
+FName FAlsCameraTickFunction::DiagnosticContext(const bool bDetailed)
+{
+	return Camera->GetClass()->GetFName();
+}
+
 UAlsCameraComponent::UAlsCameraComponent()
 {
 	PrimaryComponentTick.bStartWithTickEnabled = false;
 	PrimaryComponentTick.TickGroup = TG_PostPhysics;
 
+	// The camera view is read by APlayerController::UpdateCameraManager() right after the post physics tick group,
+	// so the camera tick must be completed within that group, otherwise the view will be one frame behind.
+
+	CameraTickFunction.bCanEverTick = true;
+	CameraTickFunction.bStartWithTickEnabled = true;
+	CameraTickFunction.TickGroup = TG_PostPhysics;
+	CameraTickFunction.EndTickGroup = TG_PostPhysics;
+
 	bTickInEditor = false;
 	bHiddenInGame = true;
+
+	OverlapsBuffer.Reserve(8);
 }
 
 void UAlsCameraComponent::OnRegister()
@@ -34,6 +87,33 @@ void UAlsCameraComponent::RegisterComponentTickFunctions(const bool bRegister)
 	// Tick after the owner to have access to the most up-to-date character state.
 
 	AddTickPrerequisiteActor(GetOwner());
+
+	if (!bRegister)
+	{
+		if (CameraTickFunction.IsTickFunctionRegistered())
+		{
+			CameraTickFunction.UnRegisterTickFunction();
+		}
+
+		return;
+	}
+
+	if (SetupActorComponentTickFunction(&CameraTickFunction))
+	{
+		CameraTickFunction.Camera = this;
+
+		CameraTickFunction.AddPrerequisite(this, PrimaryComponentTick);
+
+		if (IsValid(Character) && IsValid(Character->GetMesh()))
+		{
+			CameraTickFunction.AddPrerequisite(Character->GetMesh(), Character->GetMesh()->PrimaryComponentTick);
+		}
+
+		if (bBatchedTick)
+		{
+			CameraTickFunction.SetTickFunctionEnable(false);
+		}
+	}
 }
 
 void UAlsCameraComponent::Activate(const bool bReset)
@@ -54,11 +134,14 @@ void UAlsCameraComponent::InitAnim(const bool bForceReinitialize)
 	Super::InitAnim(bForceReinitialize);
 
 	AnimationInstance = GetAnimInstance();
+
+	const auto* Mesh{GetSkeletalMeshAsset()};
+	CurveHandles.Resolve(IsValid(Mesh) ? Mesh->GetSkeleton() : nullptr);
 }
 
 void UAlsCameraComponent::BeginPlay()
 {
-	ALS_ENSURE(IsValid(GetAnimInstance()));
+	ALS_ENSURE(IsUsingNativeCurves() || IsValid(GetAnimInstance()));
 	ALS_ENSURE(IsValid(Settings));
 	ALS_ENSURE(IsValid(Character));
 
@@ -79,21 +162,27 @@ void UAlsCameraComponent::TickComponent(float DeltaTime, const ELevelTick TickTy
 
 	PreviousGlobalTimeDilation = GetWorld()->GetWorldSettings()->GetEffectiveTimeDilation();
 
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	// The camera itself is updated later by the camera tick function.
 
-	// Skip camera tick until parallel animation evaluation completes.
+	CameraDeltaTime = DeltaTime;
 
-	if (!IsRunningParallelEvaluation())
+	if (IsUsingNativeCurves())
 	{
-		TickCamera(DeltaTime);
+		// Camera curves are evaluated natively, so skip the skeletal mesh component tick
+		// to avoid updating the animation instance and refreshing bone transforms.
+
+		UMeshComponent::TickComponent(DeltaTime, TickType, ThisTickFunction);
+		return;
 	}
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	ParallelEvaluationStartTime = IsRunningParallelEvaluation() ? FPlatformTime::Seconds() : 0.0;
 }
 
-void UAlsCameraComponent::CompleteParallelAnimationEvaluation(const bool bDoPostAnimationEvaluation)
+bool UAlsCameraComponent::IsUsingNativeCurves() const
 {
-	Super::CompleteParallelAnimationEvaluation(bDoPostAnimationEvaluation);
-
-	TickCamera(GetAnimInstance()->GetDeltaSeconds());
+	return IsValid(Settings) && IsValid(Settings->NativeCurves);
 }
 
 FVector UAlsCameraComponent::GetFirstPersonCameraLocation() const
@@ -128,11 +217,73 @@ void UAlsCameraComponent::GetViewInfo(FMinimalViewInfo& ViewInfo) const
 	}
 }
 
-void UAlsCameraComponent::TickCamera(const float DeltaTime, bool bAllowLag)
+void UAlsCameraComponent::SetBatchedTick(const bool bNewBatchedTick)
+{
+	bBatchedTick = bNewBatchedTick;
+
+	if (CameraTickFunction.IsTickFunctionRegistered())
+	{
+		CameraTickFunction.SetTickFunctionEnable(!bBatchedTick);
+	}
+}
+
+void UAlsCameraComponent::TickCamerasParallel(const TConstArrayView<UAlsCameraComponent*> Cameras, const float DeltaTime)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsCameraComponent::TickCamerasParallel()"),
+	                            STAT_UAlsCameraComponent_TickCamerasParallel, STATGROUP_Als)
+	ALS_BENCHMARK_SCOPE(CameraBatchTick)
+
+	check(IsInGameThread())
+
+	TArray<UAlsCameraComponent*, TInlineAllocator<8>> BatchedCameras;
+	BatchedCameras.Reserve(Cameras.Num());
+
+	for (auto* Camera : Cameras)
+	{
+		if (IsValid(Camera) &&
+		    ALS_ENSURE_MESSAGE(Camera->bBatchedTick, TEXT("%s must have batched tick enabled to avoid being ticked twice per frame."),
+		                       *Camera->GetFullName()))
+		{
+			BatchedCameras.Add(Camera);
+		}
+	}
+
+	TArray<FAlsCameraPendingTrace, TInlineAllocator<8>> PendingTraces;
+	PendingTraces.SetNum(BatchedCameras.Num());
+
+	ParallelFor(BatchedCameras.Num(), [&BatchedCameras, &PendingTraces, DeltaTime](const int32 Index)
+	{
+		BatchedCameras[Index]->PrepareCameraTick(DeltaTime, true, PendingTraces[Index]);
+	});
+
+	for (auto i{0}; i < BatchedCameras.Num(); i++)
+	{
+		if (PendingTraces[i].bValid)
+		{
+			BatchedCameras[i]->FinishCameraTick(PendingTraces[i]);
+		}
+	}
+}
+
+void UAlsCameraComponent::TickCamera(const float DeltaTime, const bool bAllowLag)
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsCameraComponent::TickCamera()"), STAT_UAlsCameraComponent_TickCamera, STATGROUP_Als)
+	ALS_BENCHMARK_SCOPE(CameraTick)
 
-	if (!IsValid(GetAnimInstance()) || !IsValid(Settings) || !IsValid(Character))
+	FAlsCameraPendingTrace PendingTrace;
+	PrepareCameraTick(DeltaTime, bAllowLag, PendingTrace);
+
+	if (PendingTrace.bValid)
+	{
+		FinishCameraTick(PendingTrace);
+	}
+}
+
+void UAlsCameraComponent::PrepareCameraTick(const float DeltaTime, bool bAllowLag, FAlsCameraPendingTrace& PendingTrace)
+{
+	PendingTrace.bValid = false;
+
+	if (!IsValid(Settings) || !IsValid(Character) || (!IsValid(Settings->NativeCurves) && !IsValid(GetAnimInstance())))
 	{
 		return;
 	}
@@ -143,8 +294,10 @@ void UAlsCameraComponent::TickCamera(const float DeltaTime, bool bAllowLag)
 	                   __FUNCTION__);
 
 #if ENABLE_DRAW_DEBUG
+	// Debug drawing is not thread-safe, so skip it if the camera is ticked in parallel.
+
 	const auto bDisplayDebugCameraShapes{
-		UAlsUtility::ShouldDisplayDebugForActor(GetOwner(), UAlsCameraConstants::CameraShapesDebugDisplayName())
+		IsInGameThread() && UAlsUtility::ShouldDisplayDebugForActor(GetOwner(), UAlsCameraConstants::CameraShapesDebugDisplayName())
 	};
 #else
 	const auto bDisplayDebugCameraShapes{false};
@@ -183,15 +336,15 @@ void UAlsCameraComponent::TickCamera(const float DeltaTime, bool bAllowLag)
 		}
 	}
 
+	RefreshCurves(DeltaTime, bAllowLag);
+
 	const auto CameraTargetRotation{Character->GetViewRotation()};
 
 	const auto PreviousPivotTargetLocation{PivotTargetLocation};
 
 	PivotTargetLocation = GetThirdPersonPivotLocation();
 
-	const auto FirstPersonOverride{
-		UAlsMath::Clamp01(GetAnimInstance()->GetCurveValue(UAlsCameraConstants::FirstPersonOverrideCurveName()))
-	};
+	const auto FirstPersonOverride{UAlsMath::Clamp01(Curves.FirstPersonOverride)};
 
 	if (FAnimWeight::IsFullWeight(FirstPersonOverride))
 	{
@@ -217,13 +370,13 @@ void UAlsCameraComponent::TickCamera(const float DeltaTime, bool bAllowLag)
 	{
 		CameraRotation = (MovementBaseRotation * CameraMovementBaseRelativeRotation).Rotator();
 
-		CameraRotation = CalculateCameraRotation(CameraTargetRotation, DeltaTime, bAllowLag);
+		CameraRotation = CalculateCameraRotation(*Settings, Curves, CameraRotation, CameraTargetRotation, DeltaTime, bAllowLag);
 
 		CameraMovementBaseRelativeRotation = MovementBaseRotation.Inverse() * CameraRotation.Quaternion();
 	}
 	else
 	{
-		CameraRotation = CalculateCameraRotation(CameraTargetRotation, DeltaTime, bAllowLag);
+		CameraRotation = CalculateCameraRotation(*Settings, Curves, CameraRotation, CameraTargetRotation, DeltaTime, bAllowLag);
 	}
 
 	const FRotator CameraYawRotation{0.0f, CameraRotation.Yaw, 0.0f};
@@ -241,13 +394,15 @@ void UAlsCameraComponent::TickCamera(const float DeltaTime, bool bAllowLag)
 	{
 		PivotLagLocation = MovementBaseLocation + MovementBaseRotation.RotateVector(PivotMovementBaseRelativeLagLocation);
 
-		PivotLagLocation = CalculatePivotLagLocation(CameraYawRotation.Quaternion(), DeltaTime, bAllowLag);
+		PivotLagLocation = CalculatePivotLagLocation(*Settings, Curves, PivotLagLocation, PivotTargetLocation,
+		                                             CameraYawRotation.Quaternion(), DeltaTime, bAllowLag);
 
 		PivotMovementBaseRelativeLagLocation = MovementBaseRotation.UnrotateVector(PivotLagLocation - MovementBaseLocation);
 	}
 	else
 	{
-		PivotLagLocation = CalculatePivotLagLocation(CameraYawRotation.Quaternion(), DeltaTime, bAllowLag);
+		PivotLagLocation = CalculatePivotLagLocation(*Settings, Curves, PivotLagLocation, PivotTargetLocation,
+		                                             CameraYawRotation.Quaternion(), DeltaTime, bAllowLag);
 	}
 
 #if ENABLE_DRAW_DEBUG
@@ -263,7 +418,7 @@ void UAlsCameraComponent::TickCamera(const float DeltaTime, bool bAllowLag)
 
 	// Calculate pivot location.
 
-	const auto PivotOffset{CalculatePivotOffset()};
+	const auto PivotOffset{CalculatePivotOffset(Curves, Character->GetMesh()->GetComponentTransform())};
 
 	PivotLocation = PivotLagLocation + PivotOffset;
 
@@ -280,11 +435,31 @@ void UAlsCameraComponent::TickCamera(const float DeltaTime, bool bAllowLag)
 
 	// Calculate target camera location.
 
-	const auto CameraTargetLocation{PivotLocation + CalculateCameraOffset()};
+	const auto CameraTargetLocation{
+		PivotLocation + CalculateCameraOffset(Curves, CameraRotation, Character->GetMesh()->GetComponentScale().Z)
+	};
+
+	// The camera trace is performed later, on the game thread.
+
+	PendingTrace.CameraTargetLocation = CameraTargetLocation;
+	PendingTrace.PivotOffset = PivotOffset;
+	PendingTrace.DeltaTime = DeltaTime;
+	PendingTrace.bAllowLag = bAllowLag;
+	PendingTrace.bValid = true;
+}
+
+void UAlsCameraComponent::FinishCameraTick(const FAlsCameraPendingTrace& PendingTrace)
+{
+	check(IsInGameThread())
 
 	// Trace for an object between the camera and character to apply a corrective offset.
 
-	const auto CameraResultLocation{CalculateCameraTrace(CameraTargetLocation, PivotOffset, DeltaTime, bAllowLag, TraceDistanceRatio)};
+	const auto CameraResultLocation{
+		CalculateCameraTrace(Curves, PendingTrace.CameraTargetLocation, PendingTrace.PivotOffset,
+		                     PendingTrace.DeltaTime, PendingTrace.bAllowLag, TraceDistanceRatio)
+	};
+
+	const auto FirstPersonOverride{UAlsMath::Clamp01(Curves.FirstPersonOverride)};
 
 	if (!FAnimWeight::IsRelevant(FirstPersonOverride))
 	{
@@ -298,32 +473,61 @@ void UAlsCameraComponent::TickCamera(const float DeltaTime, bool bAllowLag)
 	}
 }
 
-FRotator UAlsCameraComponent::CalculateCameraRotation(const FRotator& CameraTargetRotation,
-                                                      const float DeltaTime, const bool bAllowLag) const
+void UAlsCameraComponent::RefreshCurves(const float DeltaTime, const bool bAllowLag)
+{
+	if (IsValid(Settings->NativeCurves))
+	{
+		FAlsCameraCurvesContext Context;
+		Context.bRightShoulder = bRightShoulder;
+
+		const auto* AlsCharacter{Cast<AAlsCharacter>(Character)};
+		if (IsValid(AlsCharacter))
+		{
+			Context.ViewMode = AlsCharacter->GetViewMode();
+			Context.LocomotionMode = AlsCharacter->GetLocomotionMode();
+			Context.RotationMode = AlsCharacter->GetRotationMode();
+			Context.Stance = AlsCharacter->GetStance();
+			Context.Gait = AlsCharacter->GetGait();
+			Context.LocomotionAction = AlsCharacter->GetLocomotionAction();
+		}
+
+		Settings->NativeCurves->Evaluate(Context, DeltaTime, bAllowLag, NativeCurvesEntryWeights, Curves);
+		return;
+	}
+
+	// Read all curves at once directly from the evaluated curves of this component, using
+	// pre-resolved curve handles instead of looking up each curve by name in the animation instance.
+
+	CurveHandles.Read(GetAnimationCurves(), Curves);
+}
+
+FRotator UAlsCameraComponent::CalculateCameraRotation(const UAlsCameraSettings& CameraSettings, const FAlsCameraCurves& CameraCurves,
+                                                      const FRotator& CurrentCameraRotation, const FRotator& CameraTargetRotation,
+                                                      const float DeltaTime, const bool bAllowLag)
 {
 	if (!bAllowLag)
 	{
 		return CameraTargetRotation;
 	}
 
-	const auto RotationLag{GetAnimInstance()->GetCurveValue(UAlsCameraConstants::RotationLagCurveName())};
+	const auto RotationLag{CameraCurves.RotationLag};
 
-	if (!Settings->bEnableCameraLagSubstepping ||
-	    DeltaTime <= Settings->CameraLagSubstepping.LagSubstepDeltaTime ||
+	if (!CameraSettings.bEnableCameraLagSubstepping ||
+	    DeltaTime <= CameraSettings.CameraLagSubstepping.LagSubstepDeltaTime ||
 	    RotationLag <= 0.0f)
 	{
-		return UAlsMath::ExponentialDecay(CameraRotation, CameraTargetRotation, DeltaTime, RotationLag);
+		return UAlsMath::ExponentialDecay(CurrentCameraRotation, CameraTargetRotation, DeltaTime, RotationLag);
 	}
 
-	const auto CameraInitialRotation{CameraRotation};
+	const auto CameraInitialRotation{CurrentCameraRotation};
 	const auto SubstepRotationSpeed{(CameraTargetRotation - CameraInitialRotation).GetNormalized() * (1.0f / DeltaTime)};
 
-	auto NewCameraRotation{CameraRotation};
+	auto NewCameraRotation{CurrentCameraRotation};
 	auto PreviousSubstepTime{0.0f};
 
 	for (auto SubstepNumber{1};; SubstepNumber++)
 	{
-		const auto SubstepTime{SubstepNumber * Settings->CameraLagSubstepping.LagSubstepDeltaTime};
+		const auto SubstepTime{SubstepNumber * CameraSettings.CameraLagSubstepping.LagSubstepDeltaTime};
 		if (SubstepTime < DeltaTime - UE_SMALL_NUMBER)
 		{
 			NewCameraRotation = FMath::RInterpTo(NewCameraRotation, CameraInitialRotation + SubstepRotationSpeed * SubstepTime,
@@ -338,22 +542,24 @@ FRotator UAlsCameraComponent::CalculateCameraRotation(const FRotator& CameraTarg
 	}
 }
 
-FVector UAlsCameraComponent::CalculatePivotLagLocation(const FQuat& CameraYawRotation, const float DeltaTime, const bool bAllowLag) const
+FVector UAlsCameraComponent::CalculatePivotLagLocation(const UAlsCameraSettings& CameraSettings, const FAlsCameraCurves& CameraCurves,
+                                                       const FVector& CurrentPivotLagLocation, const FVector& CurrentPivotTargetLocation,
+                                                       const FQuat& CameraYawRotation, const float DeltaTime, const bool bAllowLag)
 {
 	if (!bAllowLag)
 	{
-		return PivotTargetLocation;
+		return CurrentPivotTargetLocation;
 	}
 
-	const auto RelativePivotInitialLagLocation{CameraYawRotation.UnrotateVector(PivotLagLocation)};
-	const auto RelativePivotTargetLocation{CameraYawRotation.UnrotateVector(PivotTargetLocation)};
+	const auto RelativePivotInitialLagLocation{CameraYawRotation.UnrotateVector(CurrentPivotLagLocation)};
+	const auto RelativePivotTargetLocation{CameraYawRotation.UnrotateVector(CurrentPivotTargetLocation)};
 
-	const auto LocationLagX{GetAnimInstance()->GetCurveValue(UAlsCameraConstants::LocationLagXCurveName())};
-	const auto LocationLagY{GetAnimInstance()->GetCurveValue(UAlsCameraConstants::LocationLagYCurveName())};
-	const auto LocationLagZ{GetAnimInstance()->GetCurveValue(UAlsCameraConstants::LocationLagZCurveName())};
+	const auto LocationLagX{CameraCurves.LocationLag.X};
+	const auto LocationLagY{CameraCurves.LocationLag.Y};
+	const auto LocationLagZ{CameraCurves.LocationLag.Z};
 
-	if (!Settings->bEnableCameraLagSubstepping ||
-	    DeltaTime <= Settings->CameraLagSubstepping.LagSubstepDeltaTime ||
+	if (!CameraSettings.bEnableCameraLagSubstepping ||
+	    DeltaTime <= CameraSettings.CameraLagSubstepping.LagSubstepDeltaTime ||
 	    (LocationLagX <= 0.0f && LocationLagY <= 0.0f && LocationLagZ <= 0.0f))
 	{
 		return CameraYawRotation.RotateVector({
@@ -370,7 +576,7 @@ FVector UAlsCameraComponent::CalculatePivotLagLocation(const FQuat& CameraYawRot
 
 	for (auto SubstepNumber{1};; SubstepNumber++)
 	{
-		const auto SubstepTime{SubstepNumber * Settings->CameraLagSubstepping.LagSubstepDeltaTime};
+		const auto SubstepTime{SubstepNumber * CameraSettings.CameraLagSubstepping.LagSubstepDeltaTime};
 		if (SubstepTime < DeltaTime - UE_SMALL_NUMBER)
 		{
 			const auto SubstepRelativePivotTargetLocation{RelativePivotInitialLagLocation + SubstepMovementSpeed * SubstepTime};
@@ -401,32 +607,24 @@ FVector UAlsCameraComponent::CalculatePivotLagLocation(const FQuat& CameraYawRot
 	}
 }
 
-FVector UAlsCameraComponent::CalculatePivotOffset() const
+FVector UAlsCameraComponent::CalculatePivotOffset(const FAlsCameraCurves& CameraCurves, const FTransform& MeshTransform)
 {
-	return Character->GetMesh()->GetComponentQuat().RotateVector(
-		FVector{
-			GetAnimInstance()->GetCurveValue(UAlsCameraConstants::PivotOffsetXCurveName()),
-			GetAnimInstance()->GetCurveValue(UAlsCameraConstants::PivotOffsetYCurveName()),
-			GetAnimInstance()->GetCurveValue(UAlsCameraConstants::PivotOffsetZCurveName())
-		} * Character->GetMesh()->GetComponentScale().Z);
+	return MeshTransform.GetRotation().RotateVector(FVector{CameraCurves.PivotOffset} * MeshTransform.GetScale3D().Z);
 }
 
-FVector UAlsCameraComponent::CalculateCameraOffset() const
+FVector UAlsCameraComponent::CalculateCameraOffset(const FAlsCameraCurves& CameraCurves, const FRotator& CurrentCameraRotation,
+                                                   const float MeshScale)
 {
-	return CameraRotation.RotateVector(
-		FVector{
-			GetAnimInstance()->GetCurveValue(UAlsCameraConstants::CameraOffsetXCurveName()),
-			GetAnimInstance()->GetCurveValue(UAlsCameraConstants::CameraOffsetYCurveName()),
-			GetAnimInstance()->GetCurveValue(UAlsCameraConstants::CameraOffsetZCurveName())
-		} * Character->GetMesh()->GetComponentScale().Z);
+	return CurrentCameraRotation.RotateVector(FVector{CameraCurves.CameraOffset} * MeshScale);
 }
 
-FVector UAlsCameraComponent::CalculateCameraTrace(const FVector& CameraTargetLocation, const FVector& PivotOffset,
-                                                  const float DeltaTime, const bool bAllowLag, float& NewTraceDistanceRatio) const
+FVector UAlsCameraComponent::CalculateCameraTrace(const FAlsCameraCurves& CameraCurves, const FVector& CameraTargetLocation,
+                                                  const FVector& PivotOffset, const float DeltaTime, const bool bAllowLag,
+                                                  float& NewTraceDistanceRatio)
 {
 #if ENABLE_DRAW_DEBUG
 	const auto bDisplayDebugCameraTraces{
-		UAlsUtility::ShouldDisplayDebugForActor(GetOwner(), UAlsCameraConstants::CameraTracesDebugDisplayName())
+		IsInGameThread() && UAlsUtility::ShouldDisplayDebugForActor(GetOwner(), UAlsCameraConstants::CameraTracesDebugDisplayName())
 	};
 #else
 	const auto bDisplayDebugCameraTraces{false};
@@ -434,13 +632,16 @@ FVector UAlsCameraComponent::CalculateCameraTrace(const FVector& CameraTargetLoc
 
 	const auto MeshScale{Character->GetMesh()->GetComponentScale().Z};
 
+	const auto* AlsCharacter{Cast<AAlsCharacter>(Character)};
+	auto* CostTracker{IsValid(AlsCharacter) ? &AlsCharacter->GetCostTracker() : nullptr};
+
 	static const FName MainTraceTag{FString::Printf(TEXT("%hs (Main Trace)"), __FUNCTION__)};
 
 	auto TraceStart{
 		FMath::Lerp(
 			GetThirdPersonTraceStartLocation(),
 			PivotTargetLocation + PivotOffset + FVector{Settings->ThirdPerson.TraceOverrideOffset},
-			UAlsMath::Clamp01(GetAnimInstance()->GetCurveValue(UAlsCameraConstants::TraceOverrideCurveName())))
+			UAlsMath::Clamp01(CameraCurves.TraceOverride))
 	};
 
 	const auto TraceEnd{CameraTargetLocation};
@@ -450,24 +651,46 @@ FVector UAlsCameraComponent::CalculateCameraTrace(const FVector& CameraTargetLoc
 
 	auto TraceResult{TraceEnd};
 
+	const auto bAsyncTraceEnabled{Settings->ThirdPerson.bEnableAsyncTrace};
+
 	FHitResult Hit;
-	if (GetWorld()->SweepSingleByChannel(Hit, TraceStart, TraceEnd, FQuat::Identity, TraceChanel,
-	                                     CollisionShape, {MainTraceTag, false, GetOwner()}))
+	const auto bAsyncTraceHitValid{bAsyncTraceEnabled && TryGetAsyncTraceHit(TraceStart, TraceEnd, Hit)};
+
+	if (bAsyncTraceEnabled)
 	{
-		if (!Hit.bStartPenetrating)
+		StartAsyncTrace(TraceStart, TraceEnd, TraceChanel, CollisionShape);
+	}
+
+	if (bAsyncTraceHitValid)
+	{
+		if (Hit.bBlockingHit)
 		{
-			TraceResult = Hit.Location;
+			TraceResult = TraceStart + (TraceEnd - TraceStart) * Hit.Time;
 		}
-		else if (TryAdjustLocationBlockedByGeometry(TraceStart, bDisplayDebugCameraTraces))
-		{
-			static const FName AdjustedTraceTag{FString::Printf(TEXT("%hs (Adjusted Trace)"), __FUNCTION__)};
+	}
+	else
+	{
+		ALS_SCENE_QUERY(CameraTraces, CostTracker);
 
-			GetWorld()->SweepSingleByChannel(Hit, TraceStart, TraceEnd, FQuat::Identity, TraceChanel,
-			                                 CollisionShape, {AdjustedTraceTag, false, GetOwner()});
-			if (Hit.IsValidBlockingHit())
+		if (GetWorld()->SweepSingleByChannel(Hit, TraceStart, TraceEnd, FQuat::Identity, TraceChanel,
+		                                     CollisionShape, {MainTraceTag, false, GetOwner()}))
+		{
+			if (!Hit.bStartPenetrating)
 			{
 				TraceResult = Hit.Location;
 			}
+			else if (TryAdjustLocationBlockedByGeometry(TraceStart, bDisplayDebugCameraTraces))
+			{
+				static const FName AdjustedTraceTag{FString::Printf(TEXT("%hs (Adjusted Trace)"), __FUNCTION__)};
+
+				ALS_SCENE_QUERY(CameraTraces, CostTracker);
+				GetWorld()->SweepSingleByChannel(Hit, TraceStart, TraceEnd, FQuat::Identity, TraceChanel,
+				                                 CollisionShape, {AdjustedTraceTag, false, GetOwner()});
+				if (Hit.IsValidBlockingHit())
+				{
+					TraceResult = Hit.Location;
+				}
+			}
 		}
 	}
 
@@ -506,26 +729,94 @@ FVector UAlsCameraComponent::CalculateCameraTrace(const FVector& CameraTargetLoc
 	return TraceStart + TraceVector * TraceDistanceRatio;
 }
 
-bool UAlsCameraComponent::TryAdjustLocationBlockedByGeometry(FVector& Location, const bool bDisplayDebugCameraTraces) const
+bool UAlsCameraComponent::TryGetAsyncTraceHit(const FVector& TraceStart, const FVector& TraceEnd, FHitResult& Hit) const
+{
+	FTraceDatum TraceDatum;
+	if (!GetWorld()->QueryTraceData(AsyncTraceHandle, TraceDatum))
+	{
+		return false;
+	}
+
+	const auto DivergenceThresholdSquared{FMath::Square(Settings->ThirdPerson.AsyncTrace.DivergenceThreshold)};
+
+	if (FVector::DistSquared(TraceDatum.Start, TraceStart) > DivergenceThresholdSquared ||
+	    FVector::DistSquared(TraceDatum.End, TraceEnd) > DivergenceThresholdSquared)
+	{
+		return false;
+	}
+
+	const auto* AsyncHit{
+		TraceDatum.OutHits.FindByPredicate([](const FHitResult& OutHit)
+		{
+			return OutHit.bBlockingHit;
+		})
+	};
+
+	if (AsyncHit == nullptr)
+	{
+		Hit.Init(TraceStart, TraceEnd);
+		return true;
+	}
+
+	// Penetrating hits require the blocking geometry adjustment, so let the synchronous trace handle them.
+
+	if (AsyncHit->bStartPenetrating)
+	{
+		return false;
+	}
+
+	Hit = *AsyncHit;
+	return true;
+}
+
+void UAlsCameraComponent::StartAsyncTrace(const FVector& TraceStart, const FVector& TraceEnd,
+                                          const ECollisionChannel TraceChannel, const FCollisionShape& CollisionShape)
+{
+	// Predict the next frame trace by extrapolating the current trace movement and
+	// issue it now, so that its result will be ready by the time the camera ticks again.
+
+	const auto PredictedTraceStart{TraceStart * 2.0f - PreviousTraceStartLocation};
+	const auto PredictedTraceEnd{TraceEnd * 2.0f - PreviousTraceEndLocation};
+
+	PreviousTraceStartLocation = TraceStart;
+	PreviousTraceEndLocation = TraceEnd;
+
+	static const FName AsyncTraceTag{FString::Printf(TEXT("%hs (Async Trace)"), __FUNCTION__)};
+
+	const auto* AlsCharacter{Cast<AAlsCharacter>(Character)};
+	auto* CostTracker{IsValid(AlsCharacter) ? &AlsCharacter->GetCostTracker() : nullptr};
+
+	ALS_SCENE_QUERY(CameraTraces, CostTracker);
+
+	AsyncTraceHandle = GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, PredictedTraceStart, PredictedTraceEnd,
+	                                                   FQuat::Identity, TraceChannel, CollisionShape,
+	                                                   {AsyncTraceTag, false, GetOwner()});
+}
+
+bool UAlsCameraComponent::TryAdjustLocationBlockedByGeometry(FVector& Location, const bool bDisplayDebugCameraTraces)
 {
 	// Based on ComponentEncroachesBlockingGeometry_WithAdjustment().
 
 	const auto MeshScale{Character->GetMesh()->GetComponentScale().Z};
 
+	const auto* AlsCharacter{Cast<AAlsCharacter>(Character)};
+	auto* CostTracker{IsValid(AlsCharacter) ? &AlsCharacter->GetCostTracker() : nullptr};
+
 	const auto TraceChanel{UEngineTypes::ConvertToCollisionChannel(Settings->ThirdPerson.TraceChannel)};
 	const auto CollisionShape{FCollisionShape::MakeSphere((Settings->ThirdPerson.TraceRadius + 1.0f) * MeshScale)};
 
-	static TArray<FOverlapResult> Overlaps;
-	check(Overlaps.IsEmpty())
+	check(OverlapsBuffer.IsEmpty())
 
 	ON_SCOPE_EXIT
 	{
-		Overlaps.Reset();
+		OverlapsBuffer.Reset();
 	};
 
 	static const FName OverlapMultiTraceTag{FString::Printf(TEXT("%hs (Overlap Multi)"), __FUNCTION__)};
 
-	if (!GetWorld()->OverlapMultiByChannel(Overlaps, Location, FQuat::Identity, TraceChanel,
+	ALS_SCENE_QUERY(CameraTraces, CostTracker);
+
+	if (!GetWorld()->OverlapMultiByChannel(OverlapsBuffer, Location, FQuat::Identity, TraceChanel,
 	                                       CollisionShape, {OverlapMultiTraceTag, false, GetOwner()}))
 	{
 		return false;
@@ -536,7 +827,7 @@ bool UAlsCameraComponent::TryAdjustLocationBlockedByGeometry(FVector& Location,
 
 	FMTDResult MtdResult;
 
-	for (const auto& Overlap : Overlaps)
+	for (const auto& Overlap : OverlapsBuffer)
 	{
 		if (!Overlap.Component.IsValid() || Overlap.Component->GetCollisionResponseToChannel(TraceChanel) != ECR_Block)
 		{
@@ -585,6 +876,8 @@ bool UAlsCameraComponent::TryAdjustLocationBlockedByGeometry(FVector& Location,
 
 	static const FName FreeSpaceTraceTag{FString::Printf(TEXT("%hs (Free Space Overlap)"), __FUNCTION__)};
 
+	ALS_SCENE_QUERY(CameraTraces, CostTracker);
+
 	return !GetWorld()->OverlapBlockingTestByChannel(Location, FQuat::Identity, TraceChanel,
 	                                                 FCollisionShape::MakeSphere(Settings->ThirdPerson.TraceRadius * MeshScale),
 	                                                 {FreeSpaceTraceTag, false, GetOwner()});
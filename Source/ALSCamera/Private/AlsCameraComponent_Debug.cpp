@@ -118,24 +118,56 @@ void UAlsCameraComponent::DisplayDebugCurves(const UCanvas* Canvas, const float
 	const auto RowOffset{12.0f * Scale};
 	const auto ColumnOffset{145.0f * Scale};
 
-	static TArray<FName> CurveNames;
-	check(CurveNames.IsEmpty())
+	static TArray<TPair<FName, float>> CurveNamesAndValues;
+	check(CurveNamesAndValues.IsEmpty())
 
 	ON_SCOPE_EXIT
 	{
-		CurveNames.Reset();
+		CurveNamesAndValues.Reset();
 	};
 
-	GetAnimInstance()->GetAllCurveNames(CurveNames);
+	if (IsUsingNativeCurves())
+	{
+		CurveNamesAndValues.Emplace(UAlsCameraConstants::CameraOffsetXCurveName(), Curves.CameraOffset.X);
+		CurveNamesAndValues.Emplace(UAlsCameraConstants::CameraOffsetYCurveName(), Curves.CameraOffset.Y);
+		CurveNamesAndValues.Emplace(UAlsCameraConstants::CameraOffsetZCurveName(), Curves.CameraOffset.Z);
+		CurveNamesAndValues.Emplace(UAlsCameraConstants::FirstPersonOverrideCurveName(), Curves.FirstPersonOverride);
+		CurveNamesAndValues.Emplace(UAlsCameraConstants::LocationLagXCurveName(), Curves.LocationLag.X);
+		CurveNamesAndValues.Emplace(UAlsCameraConstants::LocationLagYCurveName(), Curves.LocationLag.Y);
+		CurveNamesAndValues.Emplace(UAlsCameraConstants::LocationLagZCurveName(), Curves.LocationLag.Z);
+		CurveNamesAndValues.Emplace(UAlsCameraConstants::PivotOffsetXCurveName(), Curves.PivotOffset.X);
+		CurveNamesAndValues.Emplace(UAlsCameraConstants::PivotOffsetYCurveName(), Curves.PivotOffset.Y);
+		CurveNamesAndValues.Emplace(UAlsCameraConstants::PivotOffsetZCurveName(), Curves.PivotOffset.Z);
+		CurveNamesAndValues.Emplace(UAlsCameraConstants::RotationLagCurveName(), Curves.RotationLag);
+		CurveNamesAndValues.Emplace(UAlsCameraConstants::TraceOverrideCurveName(), Curves.TraceOverride);
+	}
+	else if (IsValid(GetAnimInstance()))
+	{
+		static TArray<FName> CurveNames;
+		check(CurveNames.IsEmpty())
+
+		ON_SCOPE_EXIT
+		{
+			CurveNames.Reset();
+		};
 
-	CurveNames.Sort([](const FName& A, const FName& B) { return A.LexicalLess(B); });
+		GetAnimInstance()->GetAllCurveNames(CurveNames);
+
+		for (const auto& CurveName : CurveNames)
+		{
+			CurveNamesAndValues.Emplace(CurveName, GetAnimInstance()->GetCurveValue(CurveName));
+		}
+
+		CurveNamesAndValues.Sort([](const TPair<FName, float>& A, const TPair<FName, float>& B)
+		{
+			return A.Key.LexicalLess(B.Key);
+		});
+	}
 
 	TStringBuilder<32> CurveValueBuilder;
 
-	for (const auto& CurveName : CurveNames)
+	for (const auto& [CurveName, CurveValue] : CurveNamesAndValues)
 	{
-		const auto CurveValue{GetAnimInstance()->GetCurveValue(CurveName)};
-
 		Text.SetColor(FMath::Lerp(FLinearColor::Gray, FLinearColor::White, UAlsMath::Clamp01(FMath::Abs(CurveValue))));
 
 		Text.Text = FText::AsCultureInvariant(FName::NameToDisplayString(CurveName.ToString(), false));
@@ -0,0 +1,124 @@
+#include "AlsCameraCurvesSettings.h"
+
+#include "Animation/AnimTypes.h"
+#include "Animation/Skeleton.h"
+#include "Utility/AlsCameraConstants.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsCameraCurvesSettings)
+
+FAlsCameraCurves FAlsCameraCurves::Lerp(const FAlsCameraCurves& From, const FAlsCameraCurves& To, const float Alpha)
+{
+	FAlsCameraCurves Result;
+
+	Result.FirstPersonOverride = FMath::Lerp(From.FirstPersonOverride, To.FirstPersonOverride, Alpha);
+	Result.TraceOverride = FMath::Lerp(From.TraceOverride, To.TraceOverride, Alpha);
+	Result.RotationLag = FMath::Lerp(From.RotationLag, To.RotationLag, Alpha);
+	Result.LocationLag = FMath::Lerp(From.LocationLag, To.LocationLag, Alpha);
+	Result.PivotOffset = FMath::Lerp(From.PivotOffset, To.PivotOffset, Alpha);
+	Result.CameraOffset = FMath::Lerp(From.CameraOffset, To.CameraOffset, Alpha);
+
+	return Result;
+}
+
+bool FAlsCameraCurves::Equals(const FAlsCameraCurves& Other, const float Tolerance) const
+{
+	return FMath::IsNearlyEqual(FirstPersonOverride, Other.FirstPersonOverride, Tolerance) &&
+	       FMath::IsNearlyEqual(TraceOverride, Other.TraceOverride, Tolerance) &&
+	       FMath::IsNearlyEqual(RotationLag, Other.RotationLag, Tolerance) &&
+	       LocationLag.Equals(Other.LocationLag, Tolerance) &&
+	       PivotOffset.Equals(Other.PivotOffset, Tolerance) &&
+	       CameraOffset.Equals(Other.CameraOffset, Tolerance);
+}
+
+void FAlsCameraCurveHandles::Resolve(const USkeleton* Skeleton)
+{
+	if (!IsValid(Skeleton))
+	{
+		*this = {};
+		return;
+	}
+
+	const auto ResolveUid{
+		[Skeleton](const FName& CurveName)
+		{
+			return Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, CurveName);
+		}
+	};
+
+	FirstPersonOverride = ResolveUid(UAlsCameraConstants::FirstPersonOverrideCurveName());
+	TraceOverride = ResolveUid(UAlsCameraConstants::TraceOverrideCurveName());
+	RotationLag = ResolveUid(UAlsCameraConstants::RotationLagCurveName());
+
+	LocationLag[0] = ResolveUid(UAlsCameraConstants::LocationLagXCurveName());
+	LocationLag[1] = ResolveUid(UAlsCameraConstants::LocationLagYCurveName());
+	LocationLag[2] = ResolveUid(UAlsCameraConstants::LocationLagZCurveName());
+
+	PivotOffset[0] = ResolveUid(UAlsCameraConstants::PivotOffsetXCurveName());
+	PivotOffset[1] = ResolveUid(UAlsCameraConstants::PivotOffsetYCurveName());
+	PivotOffset[2] = ResolveUid(UAlsCameraConstants::PivotOffsetZCurveName());
+
+	CameraOffset[0] = ResolveUid(UAlsCameraConstants::CameraOffsetXCurveName());
+	CameraOffset[1] = ResolveUid(UAlsCameraConstants::CameraOffsetYCurveName());
+	CameraOffset[2] = ResolveUid(UAlsCameraConstants::CameraOffsetZCurveName());
+}
+
+void FAlsCameraCurveHandles::Read(const FBlendedHeapCurve& AnimationCurves, FAlsCameraCurves& Curves) const
+{
+	// Curves that don't exist on the skeleton or were not evaluated are treated as zero, just like in UAnimInstance::GetCurveValue().
+
+	Curves.FirstPersonOverride = AnimationCurves.Get(FirstPersonOverride);
+	Curves.TraceOverride = AnimationCurves.Get(TraceOverride);
+	Curves.RotationLag = AnimationCurves.Get(RotationLag);
+
+	for (auto i{0}; i < 3; i++)
+	{
+		Curves.LocationLag[i] = AnimationCurves.Get(LocationLag[i]);
+		Curves.PivotOffset[i] = AnimationCurves.Get(PivotOffset[i]);
+		Curves.CameraOffset[i] = AnimationCurves.Get(CameraOffset[i]);
+	}
+}
+
+bool FAlsCameraCurvesEntry::IsMatching(const FAlsCameraCurvesContext& Context) const
+{
+	if (Shoulder != EAlsCameraCurvesShoulder::Any &&
+	    Context.bRightShoulder != (Shoulder == EAlsCameraCurvesShoulder::Right))
+	{
+		return false;
+	}
+
+	return (!ViewMode.IsValid() || Context.ViewMode.MatchesTag(ViewMode)) &&
+	       (!LocomotionMode.IsValid() || Context.LocomotionMode.MatchesTag(LocomotionMode)) &&
+	       (!RotationMode.IsValid() || Context.RotationMode.MatchesTag(RotationMode)) &&
+	       (!Stance.IsValid() || Context.Stance.MatchesTag(Stance)) &&
+	       (!Gait.IsValid() || Context.Gait.MatchesTag(Gait)) &&
+	       (!LocomotionAction.IsValid() || Context.LocomotionAction.MatchesTag(LocomotionAction));
+}
+
+void UAlsCameraCurvesSettings::Evaluate(const FAlsCameraCurvesContext& Context, const float DeltaTime, const bool bAllowBlending,
+                                        TArray<float>& EntryWeights, FAlsCameraCurves& Curves) const
+{
+	EntryWeights.SetNumZeroed(Entries.Num());
+
+	Curves = DefaultCurves;
+
+	for (auto i{0}; i < Entries.Num(); i++)
+	{
+		const auto& Entry{Entries[i]};
+		auto& EntryWeight{EntryWeights[i]};
+
+		const auto TargetWeight{Entry.IsMatching(Context) ? 1.0f : 0.0f};
+
+		EntryWeight = bAllowBlending && Entry.BlendDuration > UE_SMALL_NUMBER
+			              ? FMath::FInterpConstantTo(EntryWeight, TargetWeight, DeltaTime, 1.0f / Entry.BlendDuration)
+			              : TargetWeight;
+
+		if (FAnimWeight::IsFullWeight(EntryWeight))
+		{
+			Curves = Entry.Curves;
+		}
+		else if (FAnimWeight::IsRelevant(EntryWeight))
+		{
+			Curves = FAlsCameraCurves::Lerp(Curves, Entry.Curves, EntryWeight);
+		}
+	}
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "AlsCameraCurvesSettings.h"
 #include "Animation/AnimInstance.h"
 #include "Utility/AlsGameplayTags.h"
 #include "AlsCameraAnimationInstance.generated.h"
@@ -40,8 +41,18 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	bool bRightShoulder{true};
 
+#if WITH_EDITORONLY_DATA
+	bool bStateOverridden{false};
+#endif
+
 public:
 	virtual void NativeInitializeAnimation() override;
 
 	virtual void NativeUpdateAnimation(float DeltaTime) override;
+
+#if WITH_EDITOR
+	// Overrides the state that is normally read from the character and camera. Used
+	// by editor tools to sample the camera animation blueprint in arbitrary states.
+	void OverrideState(const FAlsCameraCurvesContext& State);
+#endif
 };
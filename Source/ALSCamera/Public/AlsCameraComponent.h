@@ -1,12 +1,58 @@
 #pragma once
 
+#include "AlsCameraCurvesSettings.h"
+#include "WorldCollision.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Utility/AlsMath.h"
 #include "AlsCameraComponent.generated.h"
 
 class UAlsCameraSettings;
+class UAlsCameraComponent;
 class ACharacter;
 
+// Runs the camera update as a separate task that depends on the camera and character mesh ticks. Since skeletal mesh
+// ticks are not completed until their parallel animation evaluation is completed, the camera update doesn't need
+// to wait for the animation evaluation on the game thread, and other game thread work can be done in the meantime.
+USTRUCT()
+struct ALSCAMERA_API FAlsCameraTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UAlsCameraComponent* Camera{nullptr};
+
+public:
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& CompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FAlsCameraTickFunction> : public TStructOpsTypeTraitsBase2<FAlsCameraTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+// Camera state passed from the part of the camera update that only reads the character state, and thus can be executed on
+// any thread, to the camera trace, which accesses the physics scene and therefore must be executed on the game thread.
+struct FAlsCameraPendingTrace
+{
+	FVector CameraTargetLocation{ForceInit};
+
+	FVector PivotOffset{ForceInit};
+
+	float DeltaTime{0.0f};
+
+	bool bAllowLag{false};
+
+	bool bValid{false};
+};
+
 UCLASS(HideCategories = ("ComponentTick", "Clothing", "Physics", "MasterPoseComponent", "Collision", "AnimationRig",
 	"Lighting", "Deformer", "Rendering", "PathTracing", "HLOD", "Navigation", "VirtualTexture", "SkeletalMesh",
 	"LeaderPoseComponent", "Optimization", "LOD", "MaterialParameters", "TextureStreaming", "Mobile", "RayTracing"))
@@ -14,6 +60,8 @@ class ALSCAMERA_API UAlsCameraComponent : public USkeletalMeshComponent
 {
 	GENERATED_BODY()
 
+	friend FAlsCameraTickFunction;
+
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	TObjectPtr<UAlsCameraSettings> Settings;
@@ -30,6 +78,19 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient, Meta = (ForceUnits = "x"))
 	float PreviousGlobalTimeDilation{1.0f};
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient, Meta = (ForceUnits = "s"))
+	float CameraDeltaTime{0.0f};
+
+	FAlsCameraTickFunction CameraTickFunction;
+
+	double ParallelEvaluationStartTime{0.0};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	FAlsCameraCurves Curves;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	TArray<float> NativeCurvesEntryWeights;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	FVector PivotTargetLocation;
 
@@ -60,12 +121,29 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient, Meta = (ClampMin = 0, ClampMax = 1, ForceUnits = "%"))
 	float TraceDistanceRatio{1.0f};
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	FVector PreviousTraceStartLocation;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	FVector PreviousTraceEndLocation;
+
+	FAlsCameraCurveHandles CurveHandles;
+
+	FTraceHandle AsyncTraceHandle;
+
+	// Reused between camera ticks to avoid allocations.
+	TArray<FOverlapResult> OverlapsBuffer;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient, Meta = (ClampMin = 5, ClampMax = 360, ForceUnits = "deg"))
 	float CameraFov{90.0f};
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	bool bRightShoulder{true};
 
+	// If true, the camera tick function is disabled and the camera is updated only by TickCamerasParallel().
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	bool bBatchedTick{false};
+
 public:
 	UAlsCameraComponent();
 
@@ -81,9 +159,9 @@ public:
 
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
-	virtual void CompleteParallelAnimationEvaluation(bool bDoPostAnimationEvaluation) override;
-
 public:
+	bool IsUsingNativeCurves() const;
+
 	float GetPostProcessWeight() const;
 
 	void SetPostProcessWeight(float NewPostProcessWeight);
@@ -105,21 +183,52 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Als Camera")
 	void GetViewInfo(FMinimalViewInfo& ViewInfo) const;
 
+	bool IsBatchedTick() const;
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Als Camera")
+	void SetBatchedTick(bool bNewBatchedTick);
+
+	// Ticks multiple cameras in parallel, which can be useful for split-screen or spectator cameras. Must be called
+	// from the game thread after the animation evaluation of these cameras and their characters has been completed.
+	// Only cameras with batched tick enabled are ticked, so that they are not also ticked by their own tick functions.
+	// Everything except the camera traces is updated on worker threads, after which the camera traces are performed
+	// on the game thread, since scene queries and async trace requests are not allowed from worker threads.
+	static void TickCamerasParallel(TConstArrayView<UAlsCameraComponent*> Cameras, float DeltaTime);
+
+	// These functions depend only on their arguments, so they can be used outside of the camera component.
+
+	static FRotator CalculateCameraRotation(const UAlsCameraSettings& CameraSettings, const FAlsCameraCurves& CameraCurves,
+	                                        const FRotator& CurrentCameraRotation, const FRotator& CameraTargetRotation,
+	                                        float DeltaTime, bool bAllowLag);
+
+	static FVector CalculatePivotLagLocation(const UAlsCameraSettings& CameraSettings, const FAlsCameraCurves& CameraCurves,
+	                                         const FVector& CurrentPivotLagLocation, const FVector& CurrentPivotTargetLocation,
+	                                         const FQuat& CameraYawRotation, float DeltaTime, bool bAllowLag);
+
+	static FVector CalculatePivotOffset(const FAlsCameraCurves& CameraCurves, const FTransform& MeshTransform);
+
+	static FVector CalculateCameraOffset(const FAlsCameraCurves& CameraCurves, const FRotator& CurrentCameraRotation, float MeshScale);
+
 private:
 	void TickCamera(float DeltaTime, bool bAllowLag = true);
 
-	FRotator CalculateCameraRotation(const FRotator& CameraTargetRotation, float DeltaTime, bool bAllowLag) const;
+	// Updates the camera up to the camera trace. Doesn't access the physics scene, so it can be called from any thread.
+	void PrepareCameraTick(float DeltaTime, bool bAllowLag, FAlsCameraPendingTrace& PendingTrace);
+
+	// Performs the camera trace and calculates the final camera location. Must be called from the game thread.
+	void FinishCameraTick(const FAlsCameraPendingTrace& PendingTrace);
 
-	FVector CalculatePivotLagLocation(const FQuat& CameraYawRotation, float DeltaTime, bool bAllowLag) const;
+	void RefreshCurves(float DeltaTime, bool bAllowLag);
 
-	FVector CalculatePivotOffset() const;
+	FVector CalculateCameraTrace(const FAlsCameraCurves& CameraCurves, const FVector& CameraTargetLocation,
+	                             const FVector& PivotOffset, float DeltaTime, bool bAllowLag, float& NewTraceDistanceRatio);
 
-	FVector CalculateCameraOffset() const;
+	bool TryGetAsyncTraceHit(const FVector& TraceStart, const FVector& TraceEnd, FHitResult& Hit) const;
 
-	FVector CalculateCameraTrace(const FVector& CameraTargetLocation, const FVector& PivotOffset,
-	                             float DeltaTime, bool bAllowLag, float& NewTraceDistanceRatio) const;
+	void StartAsyncTrace(const FVector& TraceStart, const FVector& TraceEnd,
+	                     ECollisionChannel TraceChannel, const FCollisionShape& CollisionShape);
 
-	bool TryAdjustLocationBlockedByGeometry(FVector& Location, bool bDisplayDebugCameraTraces) const;
+	bool TryAdjustLocationBlockedByGeometry(FVector& Location, bool bDisplayDebugCameraTraces);
 
 	// Debug
 
@@ -156,3 +265,8 @@ inline void UAlsCameraComponent::SetRightShoulder(const bool bNewRightShoulder)
 {
 	bRightShoulder = bNewRightShoulder;
 }
+
+inline bool UAlsCameraComponent::IsBatchedTick() const
+{
+	return bBatchedTick;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Animation/AnimCurveTypes.h"
+#include "Animation/SmartName.h"
+#include "Engine/DataAsset.h"
+#include "AlsCameraCurvesSettings.generated.h"
+
+class USkeleton;
+
+USTRUCT(BlueprintType)
+struct ALSCAMERA_API FAlsCameraCurves
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ClampMax = 1))
+	float FirstPersonOverride{0.0f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ClampMax = 1))
+	float TraceOverride{0.0f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0))
+	float RotationLag{0.0f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	FVector3f LocationLag{ForceInit};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ForceUnits = "cm"))
+	FVector3f PivotOffset{ForceInit};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ForceUnits = "cm"))
+	FVector3f CameraOffset{ForceInit};
+
+public:
+	static FAlsCameraCurves Lerp(const FAlsCameraCurves& From, const FAlsCameraCurves& To, float Alpha);
+
+	bool Equals(const FAlsCameraCurves& Other, float Tolerance = UE_KINDA_SMALL_NUMBER) const;
+};
+
+// Camera curve identifiers resolved once per skeleton, which allows all camera
+// curves to be read from the evaluated animation curves without name lookups.
+struct ALSCAMERA_API FAlsCameraCurveHandles
+{
+	SmartName::UID_Type FirstPersonOverride{SmartName::MaxUID};
+
+	SmartName::UID_Type TraceOverride{SmartName::MaxUID};
+
+	SmartName::UID_Type RotationLag{SmartName::MaxUID};
+
+	SmartName::UID_Type LocationLag[3]{SmartName::MaxUID, SmartName::MaxUID, SmartName::MaxUID};
+
+	SmartName::UID_Type PivotOffset[3]{SmartName::MaxUID, SmartName::MaxUID, SmartName::MaxUID};
+
+	SmartName::UID_Type CameraOffset[3]{SmartName::MaxUID, SmartName::MaxUID, SmartName::MaxUID};
+
+public:
+	void Resolve(const USkeleton* Skeleton);
+
+	void Read(const FBlendedHeapCurve& AnimationCurves, FAlsCameraCurves& Curves) const;
+};
+
+USTRUCT(BlueprintType)
+struct ALSCAMERA_API FAlsCameraCurvesContext
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (Categories = "Als.ViewMode"))
+	FGameplayTag ViewMode;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (Categories = "Als.LocomotionMode"))
+	FGameplayTag LocomotionMode;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (Categories = "Als.RotationMode"))
+	FGameplayTag RotationMode;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (Categories = "Als.Stance"))
+	FGameplayTag Stance;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (Categories = "Als.Gait"))
+	FGameplayTag Gait;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (Categories = "Als.LocomotionAction"))
+	FGameplayTag LocomotionAction;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	bool bRightShoulder{true};
+};
+
+UENUM(BlueprintType)
+enum class EAlsCameraCurvesShoulder : uint8
+{
+	Any,
+	Left,
+	Right
+};
+
+USTRUCT(BlueprintType)
+struct ALSCAMERA_API FAlsCameraCurvesEntry
+{
+	GENERATED_BODY()
+
+	// Empty tags match any state.
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (Categories = "Als.ViewMode"))
+	FGameplayTag ViewMode;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (Categories = "Als.LocomotionMode"))
+	FGameplayTag LocomotionMode;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (Categories = "Als.RotationMode"))
+	FGameplayTag RotationMode;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (Categories = "Als.Stance"))
+	FGameplayTag Stance;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (Categories = "Als.Gait"))
+	FGameplayTag Gait;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (Categories = "Als.LocomotionAction"))
+	FGameplayTag LocomotionAction;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	EAlsCameraCurvesShoulder Shoulder{EAlsCameraCurvesShoulder::Any};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "s"))
+	float BlendDuration{0.3f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	FAlsCameraCurves Curves;
+
+public:
+	bool IsMatching(const FAlsCameraCurvesContext& Context) const;
+};
+
+// Replaces the camera animation blueprint with a compact state-to-curves blend table. The table is evaluated
+// natively by the camera component, so the camera skeletal mesh doesn't need to be updated and evaluated at all.
+UCLASS(Blueprintable, BlueprintType)
+class ALSCAMERA_API UAlsCameraCurvesSettings : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Curves used when no entry matches the current state.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	FAlsCameraCurves DefaultCurves;
+
+	// Entries are blended on top of each other in order, so later matching entries override earlier ones.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (TitleProperty = "{ViewMode} {RotationMode} {Stance} {Gait} {LocomotionAction}"))
+	TArray<FAlsCameraCurvesEntry> Entries;
+
+public:
+	void Evaluate(const FAlsCameraCurvesContext& Context, float DeltaTime, bool bAllowBlending,
+	              TArray<float>& EntryWeights, FAlsCameraCurves& Curves) const;
+};
@@ -5,6 +5,8 @@
 #include "Utility/AlsConstants.h"
 #include "AlsCameraSettings.generated.h"
 
+class UAlsCameraCurvesSettings;
+
 USTRUCT(BlueprintType)
 struct ALSCAMERA_API FAlsFirstPersonCameraSettings
 {
@@ -26,6 +28,17 @@ struct ALSCAMERA_API FAlsTraceDistanceSmoothingSettings
 	float InterpolationSpeed{3.0f};
 };
 
+USTRUCT(BlueprintType)
+struct ALSCAMERA_API FAlsAsyncCameraTraceSettings
+{
+	GENERATED_BODY()
+
+	// If the actual trace start or end location diverges from the predicted one by more than
+	// this distance, then the asynchronous trace result is discarded and a synchronous trace is used.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float DivergenceThreshold{5.0f};
+};
+
 USTRUCT(BlueprintType)
 struct ALSCAMERA_API FAlsThirdPersonCameraSettings
 {
@@ -61,6 +74,15 @@ struct ALSCAMERA_API FAlsThirdPersonCameraSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS",
 		DisplayName = "Enable Trace Distance Smoothing", Meta = (EditCondition = "bEnableTraceDistanceSmoothing"))
 	FAlsTraceDistanceSmoothingSettings TraceDistanceSmoothing;
+
+	// If enabled, the camera trace will be performed asynchronously along the trace predicted for the next
+	// frame, and the synchronous trace will only be used if the prediction turns out to be inaccurate.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (InlineEditConditionToggle))
+	bool bEnableAsyncTrace{false};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS",
+		DisplayName = "Enable Async Trace", Meta = (EditCondition = "bEnableAsyncTrace"))
+	FAlsAsyncCameraTraceSettings AsyncTrace;
 };
 
 USTRUCT(BlueprintType)
@@ -86,6 +108,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 0, ForceUnits = "cm"))
 	float TeleportDistanceThreshold{200.0f};
 
+	// If set, camera curves will be evaluated natively from this asset instead of the camera animation
+	// instance, and the animation update and evaluation of the camera skeletal mesh will be skipped.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	TObjectPtr<UAlsCameraCurvesSettings> NativeCurves;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	FAlsFirstPersonCameraSettings FirstPerson;
 
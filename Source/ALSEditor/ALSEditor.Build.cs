@@ -11,14 +11,15 @@ public class ALSEditor : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new[]
 		{
-			"Core", "CoreUObject", "Engine", "AnimationModifiers", "AnimationBlueprintLibrary", "ALS"
+			"Core", "CoreUObject", "Engine", "GameplayTags", "AnimationModifiers", "AnimationBlueprintLibrary", "DataValidation",
+			"Json", "JsonUtilities", "ALS", "ALSCamera"
 		});
 
 		if (Target.bBuildEditor)
 		{
 			PrivateDependencyModuleNames.AddRange(new[]
 			{
-				"AnimGraph", "AnimGraphRuntime", "BlueprintGraph"
+				"AnimGraph", "AnimGraphRuntime", "BlueprintGraph", "ControlRig"
 			});
 		}
 	}
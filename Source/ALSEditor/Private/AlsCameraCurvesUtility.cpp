@@ -0,0 +1,220 @@
+#include "AlsCameraCurvesUtility.h"
+
+#include "AlsCameraAnimationInstance.h"
+#include "AlsCameraCurvesSettings.h"
+#include "PreviewScene.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Logging/MessageLog.h"
+#include "Misc/UObjectToken.h"
+#include "Utility/AlsCameraConstants.h"
+#include "Utility/AlsGameplayTags.h"
+#include "Utility/AlsLog.h"
+#include "Utility/AlsMacros.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsCameraCurvesUtility)
+
+#define LOCTEXT_NAMESPACE "AlsCameraCurvesUtility"
+
+namespace AlsCameraCurvesUtility
+{
+	FAlsCameraCurves SampleCurves(USkeletalMeshComponent* Mesh, UAlsCameraAnimationInstance* AnimationInstance,
+	                              const FAlsCameraCurvesContext& Context, const float SampleDuration)
+	{
+		static constexpr auto SampleDeltaTime{1.0f / 30.0f};
+
+		AnimationInstance->OverrideState(Context);
+
+		// Tick the animation long enough for all blends to complete.
+
+		for (auto Time{0.0f}; Time < SampleDuration; Time += SampleDeltaTime)
+		{
+			Mesh->TickAnimation(SampleDeltaTime, false);
+			Mesh->RefreshBoneTransforms();
+		}
+
+		FAlsCameraCurves Curves;
+
+		Curves.FirstPersonOverride = AnimationInstance->GetCurveValue(UAlsCameraConstants::FirstPersonOverrideCurveName());
+		Curves.TraceOverride = AnimationInstance->GetCurveValue(UAlsCameraConstants::TraceOverrideCurveName());
+		Curves.RotationLag = AnimationInstance->GetCurveValue(UAlsCameraConstants::RotationLagCurveName());
+
+		Curves.LocationLag.X = AnimationInstance->GetCurveValue(UAlsCameraConstants::LocationLagXCurveName());
+		Curves.LocationLag.Y = AnimationInstance->GetCurveValue(UAlsCameraConstants::LocationLagYCurveName());
+		Curves.LocationLag.Z = AnimationInstance->GetCurveValue(UAlsCameraConstants::LocationLagZCurveName());
+
+		Curves.PivotOffset.X = AnimationInstance->GetCurveValue(UAlsCameraConstants::PivotOffsetXCurveName());
+		Curves.PivotOffset.Y = AnimationInstance->GetCurveValue(UAlsCameraConstants::PivotOffsetYCurveName());
+		Curves.PivotOffset.Z = AnimationInstance->GetCurveValue(UAlsCameraConstants::PivotOffsetZCurveName());
+
+		Curves.CameraOffset.X = AnimationInstance->GetCurveValue(UAlsCameraConstants::CameraOffsetXCurveName());
+		Curves.CameraOffset.Y = AnimationInstance->GetCurveValue(UAlsCameraConstants::CameraOffsetYCurveName());
+		Curves.CameraOffset.Z = AnimationInstance->GetCurveValue(UAlsCameraConstants::CameraOffsetZCurveName());
+
+		return Curves;
+	}
+
+	FAlsCameraCurves ResolveCurves(const FAlsCameraCurves& DefaultCurves, const TArray<FAlsCameraCurvesEntry>& Entries,
+	                               const FAlsCameraCurvesContext& Context)
+	{
+		// Same as UAlsCameraCurvesSettings::Evaluate() with fully blended entries: the last matching entry wins.
+
+		for (auto i{Entries.Num() - 1}; i >= 0; i--)
+		{
+			if (Entries[i].IsMatching(Context))
+			{
+				return Entries[i].Curves;
+			}
+		}
+
+		return DefaultCurves;
+	}
+
+	void DestroyMesh(FPreviewScene& PreviewScene, USkeletalMeshComponent* Mesh)
+	{
+		PreviewScene.RemoveComponent(Mesh);
+		Mesh->DestroyComponent();
+	}
+}
+
+void UAlsCameraCurvesUtility::BakeCameraCurvesFromAnimationBlueprint(UAlsCameraCurvesSettings* CurvesSettings, USkeletalMesh* CameraMesh,
+                                                                     const TSubclassOf<UAlsCameraAnimationInstance> AnimationClass,
+                                                                     const float SampleDuration, const float BlendDuration)
+{
+	if (!ALS_ENSURE(IsValid(CurvesSettings)) || !ALS_ENSURE(IsValid(CameraMesh)) || !ALS_ENSURE(IsValid(AnimationClass)))
+	{
+		return;
+	}
+
+	if (SampleDuration <= 0.0f)
+	{
+		FMessageLog MessageLog{AlsLog::MessageLogName};
+
+		MessageLog.Error(FText::Format(
+			          LOCTEXT("InvalidSampleDurationError", "{FunctionName}: Sample duration must be greater than zero, but is {SampleDuration}!"),
+			          {
+				          {FString{TEXTVIEW("FunctionName")}, FText::AsCultureInvariant(__FUNCTION__)},
+				          {FString{TEXTVIEW("SampleDuration")}, FText::AsNumber(SampleDuration)}
+			          }))
+		          ->AddToken(FUObjectToken::Create(CurvesSettings));
+
+		MessageLog.Open(EMessageSeverity::Error);
+		return;
+	}
+
+	FPreviewScene PreviewScene{FPreviewScene::ConstructionValues{}};
+
+	auto* Mesh{NewObject<USkeletalMeshComponent>(GetTransientPackage())};
+	Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	Mesh->SetSkeletalMeshAsset(CameraMesh);
+	Mesh->SetAnimInstanceClass(AnimationClass);
+
+	PreviewScene.AddComponent(Mesh, FTransform::Identity);
+
+	auto* AnimationInstance{Cast<UAlsCameraAnimationInstance>(Mesh->GetAnimInstance())};
+	if (!IsValid(AnimationInstance))
+	{
+		FMessageLog MessageLog{AlsLog::MessageLogName};
+
+		MessageLog.Warning(FText::Format(
+			          LOCTEXT("InvalidAnimationInstanceWarning", "{FunctionName}: Failed to initialize the {AnimationClassName} animation instance!"),
+			          {
+				          {FString{TEXTVIEW("FunctionName")}, FText::AsCultureInvariant(__FUNCTION__)},
+				          {FString{TEXTVIEW("AnimationClassName")}, FText::AsCultureInvariant(AnimationClass->GetName())}
+			          }))
+		          ->AddToken(FUObjectToken::Create(CurvesSettings));
+
+		MessageLog.Open(EMessageSeverity::Warning);
+
+		AlsCameraCurvesUtility::DestroyMesh(PreviewScene, Mesh);
+		return;
+	}
+
+	static const FGameplayTag ViewModes[]{AlsViewModeTags::ThirdPerson, AlsViewModeTags::FirstPerson};
+	static const FGameplayTag LocomotionModes[]{AlsLocomotionModeTags::Grounded, AlsLocomotionModeTags::InAir};
+	static const FGameplayTag RotationModes[]
+	{
+		AlsRotationModeTags::ViewDirection, AlsRotationModeTags::VelocityDirection, AlsRotationModeTags::Aiming
+	};
+	static const FGameplayTag Stances[]{AlsStanceTags::Standing, AlsStanceTags::Crouching};
+	static const FGameplayTag Gaits[]{AlsGaitTags::Walking, AlsGaitTags::Running, AlsGaitTags::Sprinting};
+	static const bool RightShoulders[]{true, false};
+
+	// An empty locomotion action tag stands for no action. Entries with an empty tag match any locomotion
+	// action, so locomotion actions are iterated in the outermost loop, which places their entries last.
+
+	static const FGameplayTag LocomotionActions[]
+	{
+		FGameplayTag::EmptyTag, AlsLocomotionActionTags::Ragdolling, AlsLocomotionActionTags::Mantling, AlsLocomotionActionTags::Rolling
+	};
+
+	// The first combination is used as the default state. Entries are omitted when the already
+	// added entries (or the default curves) resolve to the same curves for their combination.
+
+	FAlsCameraCurvesContext Context;
+	Context.ViewMode = ViewModes[0];
+	Context.LocomotionMode = LocomotionModes[0];
+	Context.RotationMode = RotationModes[0];
+	Context.Stance = Stances[0];
+	Context.Gait = Gaits[0];
+	Context.LocomotionAction = LocomotionActions[0];
+	Context.bRightShoulder = RightShoulders[0];
+
+	const auto DefaultCurves{AlsCameraCurvesUtility::SampleCurves(Mesh, AnimationInstance, Context, SampleDuration)};
+
+	TArray<FAlsCameraCurvesEntry> Entries;
+
+	for (const auto& LocomotionAction : LocomotionActions)
+	{
+		for (const auto& ViewMode : ViewModes)
+		{
+			for (const auto& LocomotionMode : LocomotionModes)
+			{
+				for (const auto& RotationMode : RotationModes)
+				{
+					for (const auto& Stance : Stances)
+					{
+						for (const auto& Gait : Gaits)
+						{
+							for (const auto bRightShoulder : RightShoulders)
+							{
+								Context.ViewMode = ViewMode;
+								Context.LocomotionMode = LocomotionMode;
+								Context.RotationMode = RotationMode;
+								Context.Stance = Stance;
+								Context.Gait = Gait;
+								Context.LocomotionAction = LocomotionAction;
+								Context.bRightShoulder = bRightShoulder;
+
+								const auto Curves{AlsCameraCurvesUtility::SampleCurves(Mesh, AnimationInstance, Context, SampleDuration)};
+								if (Curves.Equals(AlsCameraCurvesUtility::ResolveCurves(DefaultCurves, Entries, Context)))
+								{
+									continue;
+								}
+
+								auto& Entry{Entries.Emplace_GetRef()};
+								Entry.ViewMode = ViewMode;
+								Entry.LocomotionMode = LocomotionMode;
+								Entry.RotationMode = RotationMode;
+								Entry.Stance = Stance;
+								Entry.Gait = Gait;
+								Entry.LocomotionAction = LocomotionAction;
+								Entry.Shoulder = bRightShoulder ? EAlsCameraCurvesShoulder::Right : EAlsCameraCurvesShoulder::Left;
+								Entry.BlendDuration = BlendDuration;
+								Entry.Curves = Curves;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	AlsCameraCurvesUtility::DestroyMesh(PreviewScene, Mesh);
+
+	CurvesSettings->Modify();
+	CurvesSettings->DefaultCurves = DefaultCurves;
+	CurvesSettings->Entries = MoveTemp(Entries);
+}
+
+#undef LOCTEXT_NAMESPACE
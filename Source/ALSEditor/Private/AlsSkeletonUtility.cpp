@@ -303,6 +303,75 @@ void UAlsSkeletonUtility::AddOrReplaceWeightBlendProfile(USkeleton* Skeleton, FN
 	}
 }
 
+TArray<FName> UAlsSkeletonUtility::GetMissingAnimationCurves(const USkeleton* Skeleton, const TArray<FName>& CurveNames)
+{
+	TArray<FName> MissingCurveNames;
+
+	if (!ALS_ENSURE(IsValid(Skeleton)))
+	{
+		return MissingCurveNames;
+	}
+
+	const auto* CurveMapping{Skeleton->GetSmartNameContainer(USkeleton::AnimCurveMappingName)};
+
+	for (const auto& CurveName : CurveNames)
+	{
+		if (CurveMapping == nullptr || !CurveMapping->Exists(CurveName))
+		{
+			MissingCurveNames.Add(CurveName);
+		}
+	}
+
+	return MissingCurveNames;
+}
+
+TArray<FName> UAlsSkeletonUtility::GetMissingSlots(const USkeleton* Skeleton, const TArray<FName>& SlotNames)
+{
+	TArray<FName> MissingSlotNames;
+
+	if (!ALS_ENSURE(IsValid(Skeleton)))
+	{
+		return MissingSlotNames;
+	}
+
+	for (const auto& SlotName : SlotNames)
+	{
+		if (!Skeleton->ContainsSlotName(SlotName))
+		{
+			MissingSlotNames.Add(SlotName);
+		}
+	}
+
+	return MissingSlotNames;
+}
+
+TArray<FName> UAlsSkeletonUtility::GetMissingVirtualBones(const USkeleton* Skeleton, const TArray<FName>& VirtualBoneNames)
+{
+	TArray<FName> MissingVirtualBoneNames;
+
+	if (!ALS_ENSURE(IsValid(Skeleton)))
+	{
+		return MissingVirtualBoneNames;
+	}
+
+	for (const auto& VirtualBoneName : VirtualBoneNames)
+	{
+		const auto bVirtualBoneExists{
+			Skeleton->GetVirtualBones().ContainsByPredicate([&VirtualBoneName](const FVirtualBone& VirtualBone)
+			{
+				return VirtualBone.VirtualBoneName == VirtualBoneName;
+			})
+		};
+
+		if (!bVirtualBoneExists)
+		{
+			MissingVirtualBoneNames.Add(VirtualBoneName);
+		}
+	}
+
+	return MissingVirtualBoneNames;
+}
+
 void UAlsSkeletonUtility::SetBoneRetargetingMode(USkeleton* Skeleton, const FName& BoneName,
                                                  const EBoneTranslationRetargetingMode::Type RetargetingMode,
                                                  const bool bIncludeDescendants)
@@ -0,0 +1,404 @@
+#include "Commandlets/AlsApplyAnimationModifiersCommandlet.h"
+
+#include "AnimationModifier.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/AnimData/IAnimationDataController.h"
+#include "Animation/AnimData/IAnimationDataModel.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Hash/Blake3.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "UObject/MetaData.h"
+#include "UObject/SavePackage.h"
+#include "Utility/AlsLog.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsApplyAnimationModifiersCommandlet)
+
+#define LOCTEXT_NAMESPACE "AlsApplyAnimationModifiersCommandlet"
+
+namespace AlsApplyAnimationModifiersCommandlet
+{
+	// Package metadata key under which the source data hash of the last modifiers application is stored.
+	const FName SourceDataHashMetaDataKey{TEXTVIEW("AlsAnimationModifiersSourceDataHash")};
+
+	// Number of the slowest sequences listed in the final report.
+	constexpr auto ReportedSequencesCount{20};
+
+	struct FSequenceTiming
+	{
+		FName PackageName;
+
+		double ApplyMilliseconds{0.0};
+
+		double SaveMilliseconds{0.0};
+	};
+
+	UClass* FindModifierClass(const FString& ClassName)
+	{
+		auto* Class{
+			ClassName.StartsWith(TEXT("/"))
+				? LoadClass<UAnimationModifier>(nullptr, *ClassName)
+				: UClass::TryFindTypeSlow<UClass>(ClassName)
+		};
+
+		return IsValid(Class) && Class->IsChildOf<UAnimationModifier>() && !Class->HasAnyClassFlags(CLASS_Abstract) ? Class : nullptr;
+	}
+
+	// Finds the animation sequences referenced by the modifier settings, such as the source sequence of
+	// UAlsAnimationModifier_CopyCurves, since modifiers can read data from them in addition to the modified sequence.
+	void LoadReferencedSequences(const UAnimationModifier* Modifier, TArray<const UAnimSequence*>& Sequences)
+	{
+		for (TFieldIterator<FObjectPropertyBase> Iterator{Modifier->GetClass()}; Iterator; ++Iterator)
+		{
+			if (Iterator->GetOwnerClass() == UAnimationModifier::StaticClass() || Iterator->HasAnyPropertyFlags(CPF_Transient) ||
+			    !Iterator->PropertyClass->IsChildOf<UAnimSequence>())
+			{
+				continue;
+			}
+
+			const auto* SoftProperty{CastField<FSoftObjectProperty>(*Iterator)};
+
+			const auto* Sequence{
+				SoftProperty != nullptr
+					? Cast<UAnimSequence>(SoftProperty->GetPropertyValue_InContainer(Modifier).LoadSynchronous())
+					: Cast<UAnimSequence>(Iterator->GetObjectPropertyValue_InContainer(Modifier))
+			};
+
+			if (IsValid(Sequence))
+			{
+				Sequences.Add(Sequence);
+			}
+		}
+	}
+
+	void HashFloatCurves(FBlake3& Hasher, const UAnimSequence* Sequence)
+	{
+		for (const auto& Curve : Sequence->GetDataModel()->GetFloatCurves())
+		{
+			const auto CurveName{Curve.Name.DisplayName.ToString()};
+			Hasher.Update(*CurveName, CurveName.Len() * sizeof(TCHAR));
+
+			for (const auto& Key : Curve.FloatCurve.GetConstRefOfKeys())
+			{
+				Hasher.Update(&Key.InterpMode, sizeof(Key.InterpMode));
+				Hasher.Update(&Key.TangentMode, sizeof(Key.TangentMode));
+				Hasher.Update(&Key.Time, sizeof(Key.Time));
+				Hasher.Update(&Key.Value, sizeof(Key.Value));
+				Hasher.Update(&Key.ArriveTangent, sizeof(Key.ArriveTangent));
+				Hasher.Update(&Key.LeaveTangent, sizeof(Key.LeaveTangent));
+			}
+		}
+	}
+}
+
+UAlsApplyAnimationModifiersCommandlet::UAlsApplyAnimationModifiersCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Applies animation modifiers to all animation sequences matching the filter and saves the modified packages.");
+	HelpUsage = TEXT("-Run=AlsApplyAnimationModifiers -Modifiers=<Class>[,<Class>...] [-Paths=/Game[,<Path>...]] ")
+		TEXT("[-Filter=<Substring>] [-Force] [-BatchSize=64] [-Shards=1 -Shard=0]");
+}
+
+int32 UAlsApplyAnimationModifiersCommandlet::Main(const FString& Parameters)
+{
+	const auto bForce{FParse::Param(*Parameters, TEXT("Force"))};
+
+	auto BatchSize{64};
+	FParse::Value(*Parameters, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(1, BatchSize);
+
+	auto ShardsCount{1};
+	FParse::Value(*Parameters, TEXT("Shards="), ShardsCount);
+	ShardsCount = FMath::Max(1, ShardsCount);
+
+	auto ShardIndex{0};
+	FParse::Value(*Parameters, TEXT("Shard="), ShardIndex);
+	ShardIndex = FMath::Clamp(ShardIndex, 0, ShardsCount - 1);
+
+	FString NameFilter;
+	FParse::Value(*Parameters, TEXT("Filter="), NameFilter);
+
+	FString ModifierClassNamesString;
+	FParse::Value(*Parameters, TEXT("Modifiers="), ModifierClassNamesString, false);
+
+	TArray<FString> ModifierClassNames;
+	ModifierClassNamesString.ParseIntoArray(ModifierClassNames, TEXT(","));
+
+	FString PackagePathsString{TEXT("/Game")};
+	FParse::Value(*Parameters, TEXT("Paths="), PackagePathsString, false);
+
+	TArray<FString> PackagePaths;
+	PackagePathsString.ParseIntoArray(PackagePaths, TEXT(","));
+
+	// Modifier settings are exported once as text and hashed together with the source data of each sequence, so that
+	// changing the modifiers, their settings or the curves of the sequences they reference invalidates all previous results.
+
+	FString ModifiersSettings;
+	TArray<const UAnimSequence*> ReferencedSequences;
+
+	for (const auto& ModifierClassName : ModifierClassNames)
+	{
+		auto* ModifierClass{AlsApplyAnimationModifiersCommandlet::FindModifierClass(ModifierClassName)};
+		if (!IsValid(ModifierClass))
+		{
+			UE_LOG(LogAls, Error, TEXT("%hs: %s is not a valid animation modifier class."), __FUNCTION__, *ModifierClassName);
+			return 1;
+		}
+
+		const auto* Modifier{Modifiers.Add_GetRef(NewObject<UAnimationModifier>(this, ModifierClass)).Get()};
+
+		ModifiersSettings += ModifierClass->GetPathName();
+
+		for (TFieldIterator<FProperty> Iterator{ModifierClass}; Iterator; ++Iterator)
+		{
+			if (Iterator->GetOwnerClass() != UAnimationModifier::StaticClass() && !Iterator->HasAnyPropertyFlags(CPF_Transient))
+			{
+				Iterator->ExportTextItem_InContainer(ModifiersSettings, Modifier, nullptr, nullptr, PPF_None);
+			}
+		}
+
+		ReferencedSequences.Reset();
+		AlsApplyAnimationModifiersCommandlet::LoadReferencedSequences(Modifier, ReferencedSequences);
+
+		for (const auto* ReferencedSequence : ReferencedSequences)
+		{
+			FBlake3 Hasher;
+			AlsApplyAnimationModifiersCommandlet::HashFloatCurves(Hasher, ReferencedSequence);
+
+			ModifiersSettings += LexToString(Hasher.Finalize());
+		}
+	}
+
+	if (Modifiers.Num() <= 0)
+	{
+		UE_LOG(LogAls, Error, TEXT("%hs: No animation modifiers specified. Usage: %s"), __FUNCTION__, *HelpUsage);
+		return 1;
+	}
+
+	auto& AssetRegistry{IAssetRegistry::GetChecked()};
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UAnimSequence::StaticClass()->GetClassPathName());
+	Filter.bRecursivePaths = true;
+
+	for (const auto& PackagePath : PackagePaths)
+	{
+		Filter.PackagePaths.Emplace(*PackagePath);
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	if (!NameFilter.IsEmpty())
+	{
+		Assets.RemoveAllSwap([&NameFilter](const FAssetData& Asset)
+		{
+			return !Asset.AssetName.ToString().Contains(NameFilter);
+		});
+	}
+
+	// Sort the assets so that each shard always gets the same subset of them.
+
+	Assets.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.PackageName.LexicalLess(B.PackageName);
+	});
+
+	if (ShardsCount > 1)
+	{
+		TArray<FAssetData> ShardAssets;
+		ShardAssets.Reserve(Assets.Num() / ShardsCount + 1);
+
+		for (auto i{ShardIndex}; i < Assets.Num(); i += ShardsCount)
+		{
+			ShardAssets.Add(MoveTemp(Assets[i]));
+		}
+
+		Assets = MoveTemp(ShardAssets);
+	}
+
+	UE_LOG(LogAls, Display, TEXT("%hs: Applying %d animation modifiers to %d animation sequences."),
+	       __FUNCTION__, Modifiers.Num(), Assets.Num());
+
+	const auto StartTime{FPlatformTime::Seconds()};
+
+	TArray<AlsApplyAnimationModifiersCommandlet::FSequenceTiming> Timings;
+	Timings.Reserve(Assets.Num());
+
+	auto SkippedCount{0};
+	auto FailedCount{0};
+
+	TArray<UAnimSequence*> Sequences;
+	TArray<FString> Hashes;
+
+	for (auto BatchStartIndex{0}; BatchStartIndex < Assets.Num(); BatchStartIndex += BatchSize)
+	{
+		const auto BatchEndIndex{FMath::Min(BatchStartIndex + BatchSize, Assets.Num())};
+
+		// Request the whole batch at once, so that the packages are read and deserialized by the async loading thread in parallel.
+
+		for (auto i{BatchStartIndex}; i < BatchEndIndex; i++)
+		{
+			LoadPackageAsync(Assets[i].PackageName.ToString());
+		}
+
+		FlushAsyncLoading();
+
+		Sequences.Reset();
+
+		for (auto i{BatchStartIndex}; i < BatchEndIndex; i++)
+		{
+			Sequences.Add(Cast<UAnimSequence>(Assets[i].GetAsset()));
+		}
+
+		// Hashing the source data only reads the sequences, so it is safe to do it in parallel.
+
+		Hashes.Reset();
+		Hashes.SetNum(Sequences.Num());
+
+		ParallelFor(Sequences.Num(), [&Sequences, &Hashes, &ModifiersSettings](const int32 Index)
+		{
+			if (IsValid(Sequences[Index]))
+			{
+				Hashes[Index] = CalculateSourceDataHash(Sequences[Index], ModifiersSettings);
+			}
+		});
+
+		for (auto i{0}; i < Sequences.Num(); i++)
+		{
+			auto* Sequence{Sequences[i]};
+			if (!IsValid(Sequence))
+			{
+				UE_LOG(LogAls, Warning, TEXT("%hs: Failed to load %s."), __FUNCTION__, *Assets[BatchStartIndex + i].GetObjectPathString());
+				FailedCount += 1;
+				continue;
+			}
+
+			auto* Package{Sequence->GetPackage()};
+			auto* MetaData{Package->GetMetaData()};
+
+			if (!bForce && MetaData->GetValue(Sequence, AlsApplyAnimationModifiersCommandlet::SourceDataHashMetaDataKey) == Hashes[i])
+			{
+				SkippedCount += 1;
+				continue;
+			}
+
+			const auto FileName{FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension())};
+			if (IFileManager::Get().IsReadOnly(*FileName))
+			{
+				UE_LOG(LogAls, Warning, TEXT("%hs: %s is read only."), __FUNCTION__, *FileName);
+				FailedCount += 1;
+				continue;
+			}
+
+			auto& Timing{Timings.Emplace_GetRef()};
+			Timing.PackageName = Package->GetFName();
+
+			const auto ApplyStartTime{FPlatformTime::Seconds()};
+
+			{
+				// Group all changes into a single bracket, so that the sequence is rebuilt only once after all modifiers are applied.
+
+				IAnimationDataController::FScopedBracket Bracket{
+					Sequence->GetController(), LOCTEXT("ApplyModifiers", "Applying ALS animation modifiers"), false
+				};
+
+				for (auto* Modifier : Modifiers)
+				{
+					Modifier->OnApply(Sequence);
+				}
+			}
+
+			MetaData->SetValue(Sequence, AlsApplyAnimationModifiersCommandlet::SourceDataHashMetaDataKey, *Hashes[i]);
+			Package->MarkPackageDirty();
+
+			const auto SaveStartTime{FPlatformTime::Seconds()};
+
+			FSavePackageArgs SaveArguments;
+			SaveArguments.TopLevelFlags = RF_Public | RF_Standalone;
+			SaveArguments.Error = GWarn;
+
+			if (!UPackage::SavePackage(Package, nullptr, *FileName, SaveArguments))
+			{
+				UE_LOG(LogAls, Warning, TEXT("%hs: Failed to save %s."), __FUNCTION__, *FileName);
+				FailedCount += 1;
+			}
+
+			Timing.ApplyMilliseconds = (SaveStartTime - ApplyStartTime) * 1000.0;
+			Timing.SaveMilliseconds = (FPlatformTime::Seconds() - SaveStartTime) * 1000.0;
+
+			UE_LOG(LogAls, Display, TEXT("%hs: %s: applied in %.2f ms, saved in %.2f ms."),
+			       __FUNCTION__, *Timing.PackageName.ToString(), Timing.ApplyMilliseconds, Timing.SaveMilliseconds);
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	Timings.Sort([](const AlsApplyAnimationModifiersCommandlet::FSequenceTiming& A,
+	                const AlsApplyAnimationModifiersCommandlet::FSequenceTiming& B)
+	{
+		return A.ApplyMilliseconds + A.SaveMilliseconds > B.ApplyMilliseconds + B.SaveMilliseconds;
+	});
+
+	for (auto i{0}; i < FMath::Min(Timings.Num(), AlsApplyAnimationModifiersCommandlet::ReportedSequencesCount); i++)
+	{
+		UE_LOG(LogAls, Display, TEXT("%hs: Slowest #%d: %s: %.2f ms."), __FUNCTION__,
+		       i + 1, *Timings[i].PackageName.ToString(), Timings[i].ApplyMilliseconds + Timings[i].SaveMilliseconds);
+	}
+
+	UE_LOG(LogAls, Display, TEXT("%hs: Processed %d, skipped %d and failed %d animation sequences in %.2f s."),
+	       __FUNCTION__, Timings.Num(), SkippedCount, FailedCount, FPlatformTime::Seconds() - StartTime);
+
+	return FailedCount > 0 ? 1 : 0;
+}
+
+FString UAlsApplyAnimationModifiersCommandlet::CalculateSourceDataHash(const UAnimSequence* Sequence, const FString& ModifiersSettings)
+{
+	FBlake3 Hasher;
+	Hasher.Update(*ModifiersSettings, ModifiersSettings.Len() * sizeof(TCHAR));
+
+	const auto FrameRate{Sequence->GetSamplingFrameRate()};
+	const auto KeysCount{Sequence->GetNumberOfSampledKeys()};
+
+	Hasher.Update(&FrameRate.Numerator, sizeof(FrameRate.Numerator));
+	Hasher.Update(&FrameRate.Denominator, sizeof(FrameRate.Denominator));
+	Hasher.Update(&KeysCount, sizeof(KeysCount));
+	Hasher.Update(&Sequence->RateScale, sizeof(Sequence->RateScale));
+
+	const auto* DataModel{Sequence->GetDataModel()};
+
+	TArray<FName> BoneTrackNames;
+	DataModel->GetBoneTrackNames(BoneTrackNames);
+
+	TArray<FTransform> BoneTrackTransforms;
+
+	for (const auto& BoneTrackName : BoneTrackNames)
+	{
+		const auto BoneName{BoneTrackName.ToString()};
+		Hasher.Update(*BoneName, BoneName.Len() * sizeof(TCHAR));
+
+		DataModel->GetBoneTrackTransforms(BoneTrackName, BoneTrackTransforms);
+
+		for (const auto& Transform : BoneTrackTransforms)
+		{
+			const auto Rotation{Transform.GetRotation()};
+			const auto Location{Transform.GetLocation()};
+			const auto Scale{Transform.GetScale3D()};
+
+			Hasher.Update(&Rotation, sizeof(Rotation));
+			Hasher.Update(&Location, sizeof(Location));
+			Hasher.Update(&Scale, sizeof(Scale));
+		}
+	}
+
+	return LexToString(Hasher.Finalize());
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,355 @@
+#include "Commandlets/AlsOptimizeAnimationCurvesCommandlet.h"
+
+#include "AnimationBlueprintLibrary.h"
+#include "JsonObjectConverter.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/AnimData/IAnimationDataController.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Modifiers/AlsAnimationModifierUtility.h"
+#include "UObject/SavePackage.h"
+#include "Utility/AlsLog.h"
+#include "Validation/AlsAnimationValidator.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsOptimizeAnimationCurvesCommandlet)
+
+#define LOCTEXT_NAMESPACE "AlsOptimizeAnimationCurvesCommandlet"
+
+namespace AlsOptimizeAnimationCurvesCommandlet
+{
+	struct FCurveChange
+	{
+		FName CurveName;
+
+		bool bRemove{false};
+
+		TArray<FRichCurveKey> Keys;
+	};
+
+	struct FSequenceChanges
+	{
+		TArray<FCurveChange> Curves;
+
+		FAlsCurvesOptimizationReport Report;
+	};
+
+	bool IsWithinTolerance(const FRichCurve& Curve, const TArray<float>& SampleTimes,
+	                       const TArray<float>& SampleValues, const float Tolerance)
+	{
+		for (auto i{0}; i < SampleTimes.Num(); i++)
+		{
+			if (FMath::Abs(Curve.Eval(SampleTimes[i]) - SampleValues[i]) > Tolerance)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	TArray<FRichCurveKey> ReduceKeys(const FRichCurve& Curve, const TArray<float>& SampleTimes, const float Tolerance)
+	{
+		// Every removal is checked against the original curve rather than the previous
+		// reduction result, so that the error cannot accumulate beyond the tolerance.
+
+		TArray<float> SampleValues;
+		SampleValues.Reserve(SampleTimes.Num());
+
+		for (const auto SampleTime : SampleTimes)
+		{
+			SampleValues.Add(Curve.Eval(SampleTime));
+		}
+
+		auto Keys{Curve.GetCopyOfKeys()};
+		TArray<FRichCurveKey> CandidateKeys;
+
+		FRichCurve CandidateCurve;
+		CandidateCurve.PreInfinityExtrap = Curve.PreInfinityExtrap;
+		CandidateCurve.PostInfinityExtrap = Curve.PostInfinityExtrap;
+		CandidateCurve.DefaultValue = Curve.DefaultValue;
+
+		// The first and the last keys are always kept.
+
+		for (auto i{Keys.Num() - 2}; i >= 1; i--)
+		{
+			CandidateKeys = Keys;
+			CandidateKeys.RemoveAt(i);
+
+			CandidateCurve.SetKeys(CandidateKeys);
+			CandidateCurve.AutoSetTangents();
+
+			if (IsWithinTolerance(CandidateCurve, SampleTimes, SampleValues, Tolerance))
+			{
+				Swap(Keys, CandidateKeys);
+			}
+		}
+
+		return Keys;
+	}
+
+	void AnalyzeSequence(const UAnimSequence* Sequence, const TSet<FName>& CurveNames, const bool bAllCurves,
+	                     const float Tolerance, const bool bRemoveDefaultCurves, FSequenceChanges& Changes)
+	{
+		Changes.Report.AssetPath = Sequence->GetPathName();
+
+		TArray<float> SampleTimes;
+		SampleTimes.Reserve(Sequence->GetNumberOfSampledKeys());
+
+		for (auto i{0}; i < Sequence->GetNumberOfSampledKeys(); i++)
+		{
+			SampleTimes.Add(Sequence->GetTimeAtFrame(i));
+		}
+
+		for (const auto& Curve : Sequence->GetCurveData().FloatCurves)
+		{
+			if (!bAllCurves && !CurveNames.Contains(Curve.Name.DisplayName))
+			{
+				continue;
+			}
+
+			const auto& Keys{Curve.FloatCurve.GetConstRefOfKeys()};
+
+			auto MinValue{Curve.FloatCurve.Eval(0.0f)};
+			auto MaxValue{MinValue};
+
+			for (const auto SampleTime : SampleTimes)
+			{
+				const auto Value{Curve.FloatCurve.Eval(SampleTime)};
+
+				MinValue = FMath::Min(MinValue, Value);
+				MaxValue = FMath::Max(MaxValue, Value);
+			}
+
+			if (MaxValue - MinValue <= Tolerance)
+			{
+				if (bRemoveDefaultCurves && FMath::Abs(MinValue) <= Tolerance)
+				{
+					auto& Change{Changes.Curves.Emplace_GetRef()};
+					Change.CurveName = Curve.Name.DisplayName;
+					Change.bRemove = true;
+
+					Changes.Report.RemovedCurvesCount += 1;
+					Changes.Report.RemovedKeysCount += Keys.Num();
+					Changes.Report.SavedBytes += sizeof(FFloatCurve) + Keys.Num() * sizeof(FRichCurveKey);
+				}
+				else if (Keys.Num() > 1)
+				{
+					auto& Change{Changes.Curves.Emplace_GetRef()};
+					Change.CurveName = Curve.Name.DisplayName;
+					Change.Keys.Emplace(0.0f, MinValue);
+
+					Changes.Report.ReducedCurvesCount += 1;
+					Changes.Report.RemovedKeysCount += Keys.Num() - 1;
+					Changes.Report.SavedBytes += (Keys.Num() - 1) * sizeof(FRichCurveKey);
+				}
+
+				continue;
+			}
+
+			auto ReducedKeys{ReduceKeys(Curve.FloatCurve, SampleTimes, Tolerance)};
+			if (ReducedKeys.Num() < Keys.Num())
+			{
+				Changes.Report.ReducedCurvesCount += 1;
+				Changes.Report.RemovedKeysCount += Keys.Num() - ReducedKeys.Num();
+				Changes.Report.SavedBytes += (Keys.Num() - ReducedKeys.Num()) * sizeof(FRichCurveKey);
+
+				auto& Change{Changes.Curves.Emplace_GetRef()};
+				Change.CurveName = Curve.Name.DisplayName;
+				Change.Keys = MoveTemp(ReducedKeys);
+			}
+		}
+	}
+}
+
+UAlsOptimizeAnimationCurvesCommandlet::UAlsOptimizeAnimationCurvesCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Strips constant ALS curves and removes redundant curve keys from animation sequences.");
+	HelpUsage = TEXT("-Run=AlsOptimizeAnimationCurves [-Paths=/Game[,<Path>...]] [-Tolerance=0.001] [-RemoveDefaultCurves] ")
+		TEXT("[-AllCurves] [-DryRun] [-Report=<FilePath>] [-BatchSize=64]");
+}
+
+int32 UAlsOptimizeAnimationCurvesCommandlet::Main(const FString& Parameters)
+{
+	const auto bRemoveDefaultCurves{FParse::Param(*Parameters, TEXT("RemoveDefaultCurves"))};
+	const auto bAllCurves{FParse::Param(*Parameters, TEXT("AllCurves"))};
+	const auto bDryRun{FParse::Param(*Parameters, TEXT("DryRun"))};
+
+	auto Tolerance{0.001f};
+	FParse::Value(*Parameters, TEXT("Tolerance="), Tolerance);
+	Tolerance = FMath::Max(0.0f, Tolerance);
+
+	auto BatchSize{64};
+	FParse::Value(*Parameters, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(1, BatchSize);
+
+	FString PackagePathsString{TEXT("/Game")};
+	FParse::Value(*Parameters, TEXT("Paths="), PackagePathsString, false);
+
+	TArray<FString> PackagePaths;
+	PackagePathsString.ParseIntoArray(PackagePaths, TEXT(","));
+
+	FString ReportFilePath{FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Als"), TEXT("AnimationCurvesOptimization.json"))};
+	FParse::Value(*Parameters, TEXT("Report="), ReportFilePath);
+
+	const auto CurveNames{GetDefault<UAlsAnimationValidator>()->GetKnownCurveNames()};
+
+	auto& AssetRegistry{IAssetRegistry::GetChecked()};
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UAnimSequence::StaticClass()->GetClassPathName());
+	Filter.bRecursivePaths = true;
+
+	for (const auto& PackagePath : PackagePaths)
+	{
+		Filter.PackagePaths.Emplace(*PackagePath);
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	UE_LOG(LogAls, Display, TEXT("%hs: Optimizing the curves of %d animation sequences%s."),
+	       __FUNCTION__, Assets.Num(), bDryRun ? TEXT(" (dry run)") : TEXT(""));
+
+	const auto StartTime{FPlatformTime::Seconds()};
+
+	FAlsCurvesOptimizationReports Reports;
+	Reports.SequencesCount = Assets.Num();
+
+	auto FailedCount{0};
+
+	TArray<UAnimSequence*> Sequences;
+	TArray<AlsOptimizeAnimationCurvesCommandlet::FSequenceChanges> Changes;
+
+	for (auto BatchStartIndex{0}; BatchStartIndex < Assets.Num(); BatchStartIndex += BatchSize)
+	{
+		const auto BatchEndIndex{FMath::Min(BatchStartIndex + BatchSize, Assets.Num())};
+
+		// Request the whole batch at once, so that the packages are read and deserialized by the async loading thread in parallel.
+
+		for (auto i{BatchStartIndex}; i < BatchEndIndex; i++)
+		{
+			LoadPackageAsync(Assets[i].PackageName.ToString());
+		}
+
+		FlushAsyncLoading();
+
+		Sequences.Reset();
+
+		for (auto i{BatchStartIndex}; i < BatchEndIndex; i++)
+		{
+			auto* Sequence{Cast<UAnimSequence>(Assets[i].GetAsset())};
+			if (IsValid(Sequence))
+			{
+				Sequences.Add(Sequence);
+			}
+			else
+			{
+				UE_LOG(LogAls, Warning, TEXT("%hs: Failed to load %s."), __FUNCTION__, *Assets[i].GetObjectPathString());
+				FailedCount += 1;
+			}
+		}
+
+		// The analysis only reads the sequences, so it is safe to do it in parallel. Modifying and saving
+		// the sequences goes through the animation data controller, which must be used on the game thread.
+
+		Changes.Reset();
+		Changes.SetNum(Sequences.Num());
+
+		ParallelFor(Sequences.Num(), [&](const int32 Index)
+		{
+			AlsOptimizeAnimationCurvesCommandlet::AnalyzeSequence(Sequences[Index], CurveNames, bAllCurves,
+			                                                      Tolerance, bRemoveDefaultCurves, Changes[Index]);
+		});
+
+		for (auto i{0}; i < Sequences.Num(); i++)
+		{
+			auto* Sequence{Sequences[i]};
+			auto& SequenceChanges{Changes[i]};
+
+			if (SequenceChanges.Curves.Num() <= 0)
+			{
+				continue;
+			}
+
+			UE_LOG(LogAls, Display, TEXT("%hs: %s: %d curves removed, %d curves reduced, %d keys removed, %lld bytes saved."),
+			       __FUNCTION__, *SequenceChanges.Report.AssetPath, SequenceChanges.Report.RemovedCurvesCount,
+			       SequenceChanges.Report.ReducedCurvesCount, SequenceChanges.Report.RemovedKeysCount, SequenceChanges.Report.SavedBytes);
+
+			if (!bDryRun)
+			{
+				auto* Package{Sequence->GetPackage()};
+
+				const auto FileName{FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension())};
+				if (IFileManager::Get().IsReadOnly(*FileName))
+				{
+					UE_LOG(LogAls, Warning, TEXT("%hs: %s is read only."), __FUNCTION__, *FileName);
+					FailedCount += 1;
+					continue;
+				}
+
+				{
+					IAnimationDataController::FScopedBracket Bracket{
+						Sequence->GetController(), LOCTEXT("OptimizeCurves", "Optimizing ALS animation curves"), false
+					};
+
+					for (const auto& Change : SequenceChanges.Curves)
+					{
+						if (Change.bRemove)
+						{
+							UAnimationBlueprintLibrary::RemoveCurve(Sequence, Change.CurveName);
+						}
+						else
+						{
+							AlsAnimationModifierUtility::SetFloatCurveKeys(Sequence, Change.CurveName, Change.Keys);
+						}
+					}
+				}
+
+				Package->MarkPackageDirty();
+
+				FSavePackageArgs SaveArguments;
+				SaveArguments.TopLevelFlags = RF_Public | RF_Standalone;
+				SaveArguments.Error = GWarn;
+
+				if (!UPackage::SavePackage(Package, nullptr, *FileName, SaveArguments))
+				{
+					UE_LOG(LogAls, Warning, TEXT("%hs: Failed to save %s."), __FUNCTION__, *FileName);
+					FailedCount += 1;
+					continue;
+				}
+			}
+
+			Reports.SavedBytes += SequenceChanges.Report.SavedBytes;
+			Reports.Sequences.Add(MoveTemp(SequenceChanges.Report));
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	FString ReportString;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(Reports, ReportString) ||
+	    !FFileHelper::SaveStringToFile(ReportString, *ReportFilePath))
+	{
+		UE_LOG(LogAls, Error, TEXT("%hs: Failed to write the report to %s."), __FUNCTION__, *ReportFilePath);
+		return 1;
+	}
+
+	UE_LOG(LogAls, Display, TEXT("%hs: Optimized %d of %d animation sequences in %.2f s, saving %lld bytes of raw curve data. ")
+	       TEXT("The report was written to %s."), __FUNCTION__, Reports.Sequences.Num(), Reports.SequencesCount,
+	       FPlatformTime::Seconds() - StartTime, Reports.SavedBytes, *ReportFilePath);
+
+	return FailedCount > 0 ? 1 : 0;
+}
+
+#undef LOCTEXT_NAMESPACE
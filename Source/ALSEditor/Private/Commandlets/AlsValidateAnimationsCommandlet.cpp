@@ -0,0 +1,147 @@
+#include "Commandlets/AlsValidateAnimationsCommandlet.h"
+
+#include "JsonObjectConverter.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Utility/AlsLog.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsValidateAnimationsCommandlet)
+
+UAlsValidateAnimationsCommandlet::UAlsValidateAnimationsCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Validates ALS curves, slots and virtual bones of skeletons, animation sequences and montages.");
+	HelpUsage = TEXT("-Run=AlsValidateAnimations [-Paths=/Game[,<Path>...]] [-Report=<FilePath>] [-BatchSize=256]");
+}
+
+int32 UAlsValidateAnimationsCommandlet::Main(const FString& Parameters)
+{
+	auto BatchSize{256};
+	FParse::Value(*Parameters, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(1, BatchSize);
+
+	FString PackagePathsString{TEXT("/Game")};
+	FParse::Value(*Parameters, TEXT("Paths="), PackagePathsString, false);
+
+	TArray<FString> PackagePaths;
+	PackagePathsString.ParseIntoArray(PackagePaths, TEXT(","));
+
+	FString ReportFilePath{FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Als"), TEXT("AnimationValidation.json"))};
+	FParse::Value(*Parameters, TEXT("Report="), ReportFilePath);
+
+	auto& AssetRegistry{IAssetRegistry::GetChecked()};
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(USkeleton::StaticClass()->GetClassPathName());
+	Filter.ClassPaths.Add(UAnimSequence::StaticClass()->GetClassPathName());
+	Filter.ClassPaths.Add(UAnimMontage::StaticClass()->GetClassPathName());
+	Filter.bRecursivePaths = true;
+
+	for (const auto& PackagePath : PackagePaths)
+	{
+		Filter.PackagePaths.Emplace(*PackagePath);
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	UE_LOG(LogAls, Display, TEXT("%hs: Validating %d animation assets."), __FUNCTION__, Assets.Num());
+
+	const auto StartTime{FPlatformTime::Seconds()};
+
+	const auto* Validator{GetDefault<UAlsAnimationValidator>()};
+
+	FAlsAnimationValidationReports Reports;
+	Reports.AssetsCount = Assets.Num();
+
+	TArray<UObject*> BatchAssets;
+	TArray<FAlsAnimationValidationReport> BatchReports;
+
+	for (auto BatchStartIndex{0}; BatchStartIndex < Assets.Num(); BatchStartIndex += BatchSize)
+	{
+		const auto BatchEndIndex{FMath::Min(BatchStartIndex + BatchSize, Assets.Num())};
+
+		// Request the whole batch at once, so that the packages are read and deserialized by the async loading thread in parallel.
+
+		for (auto i{BatchStartIndex}; i < BatchEndIndex; i++)
+		{
+			LoadPackageAsync(Assets[i].PackageName.ToString());
+		}
+
+		FlushAsyncLoading();
+
+		BatchAssets.Reset();
+
+		for (auto i{BatchStartIndex}; i < BatchEndIndex; i++)
+		{
+			auto* Asset{Assets[i].GetAsset()};
+			if (IsValid(Asset))
+			{
+				BatchAssets.Add(Asset);
+			}
+			else
+			{
+				UE_LOG(LogAls, Warning, TEXT("%hs: Failed to load %s."), __FUNCTION__, *Assets[i].GetObjectPathString());
+			}
+		}
+
+		BatchReports.Reset();
+		BatchReports.SetNum(BatchAssets.Num());
+
+		ParallelFor(BatchAssets.Num(), [Validator, &BatchAssets, &BatchReports](const int32 Index)
+		{
+			Validator->ValidateAnimationAsset(BatchAssets[Index], BatchReports[Index]);
+		});
+
+		for (auto& Report : BatchReports)
+		{
+			if (!Report.HasIssues())
+			{
+				continue;
+			}
+
+			if (Report.HasErrors())
+			{
+				Reports.InvalidAssetsCount += 1;
+
+				UE_LOG(LogAls, Warning, TEXT("%hs: %s: %d missing curves, %d missing slots, %d missing virtual bones."),
+				       __FUNCTION__, *Report.AssetPath, Report.MissingCurves.Num(), Report.MissingSlots.Num(),
+				       Report.MissingVirtualBones.Num());
+			}
+
+			if (Report.MisnamedCurves.Num() > 0)
+			{
+				UE_LOG(LogAls, Display, TEXT("%hs: %s: %d probably misnamed curves."),
+				       __FUNCTION__, *Report.AssetPath, Report.MisnamedCurves.Num());
+			}
+
+			Reports.Assets.Add(MoveTemp(Report));
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	FString ReportString;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(Reports, ReportString) ||
+	    !FFileHelper::SaveStringToFile(ReportString, *ReportFilePath))
+	{
+		UE_LOG(LogAls, Error, TEXT("%hs: Failed to write the report to %s."), __FUNCTION__, *ReportFilePath);
+		return 1;
+	}
+
+	UE_LOG(LogAls, Display, TEXT("%hs: Validated %d animation assets in %.2f s, %d of them are invalid. The report was written to %s."),
+	       __FUNCTION__, Reports.AssetsCount, FPlatformTime::Seconds() - StartTime, Reports.InvalidAssetsCount, *ReportFilePath);
+
+	return Reports.InvalidAssetsCount > 0 ? 1 : 0;
+}
@@ -0,0 +1,17 @@
+#include "Modifiers/AlsAnimationModifierUtility.h"
+
+#include "Animation/AnimSequence.h"
+#include "Animation/AnimData/CurveIdentifier.h"
+#include "Animation/AnimData/IAnimationDataController.h"
+
+void AlsAnimationModifierUtility::SetFloatCurveKeys(UAnimSequence* Sequence, const FName& CurveName, const TArray<FRichCurveKey>& Keys)
+{
+	const auto CurveIdentifier{
+		UAnimationCurveIdentifierExtensions::FindCurveIdentifier(Sequence->GetSkeleton(), CurveName, ERawCurveTrackTypes::RCT_Float)
+	};
+
+	if (CurveIdentifier.IsValid())
+	{
+		Sequence->GetController().SetCurveKeys(CurveIdentifier, Keys);
+	}
+}
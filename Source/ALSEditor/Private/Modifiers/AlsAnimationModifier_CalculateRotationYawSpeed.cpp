@@ -1,6 +1,7 @@
 ﻿#include "Modifiers/AlsAnimationModifier_CalculateRotationYawSpeed.h"
 
 #include "Animation/AnimSequence.h"
+#include "Modifiers/AlsAnimationModifierUtility.h"
 #include "Utility/AlsConstants.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimationModifier_CalculateRotationYawSpeed)
@@ -19,7 +20,10 @@ void UAlsAnimationModifier_CalculateRotationYawSpeed::OnApply_Implementation(UAn
 	const auto* DataModel{Sequence->GetDataModel()};
 	const auto FrameRate{Sequence->GetSamplingFrameRate().AsDecimal()};
 
-	UAnimationBlueprintLibrary::AddFloatCurveKey(Sequence, UAlsConstants::RotationYawSpeedCurveName(), 0.0f, 0.0f);
+	TArray<FRichCurveKey> Keys;
+	Keys.Reserve(Sequence->GetNumberOfSampledKeys());
+
+	Keys.Emplace(0.0f, 0.0f);
 
 	for (auto i{1}; i < Sequence->GetNumberOfSampledKeys(); i++)
 	{
@@ -31,9 +35,10 @@ void UAlsAnimationModifier_CalculateRotationYawSpeed::OnApply_Implementation(UAn
 			DataModel->GetBoneTrackTransform(UAlsConstants::RootBoneName(), i + (Sequence->RateScale >= 0.0f ? 0 : -1))
 		};
 
-		UAnimationBlueprintLibrary::AddFloatCurveKey(Sequence, UAlsConstants::RotationYawSpeedCurveName(), Sequence->GetTimeAtFrame(i),
-		                                             UE_REAL_TO_FLOAT(
-			                                             NextPoseTransform.Rotator().Yaw - CurrentPoseTransform.Rotator().Yaw) *
-		                                             FMath::Abs(Sequence->RateScale) * FrameRate);
+		Keys.Emplace(Sequence->GetTimeAtFrame(i),
+		             UE_REAL_TO_FLOAT(NextPoseTransform.Rotator().Yaw - CurrentPoseTransform.Rotator().Yaw) *
+		             FMath::Abs(Sequence->RateScale) * FrameRate);
 	}
+
+	AlsAnimationModifierUtility::SetFloatCurveKeys(Sequence, UAlsConstants::RotationYawSpeedCurveName(), Keys);
 }
@@ -1,6 +1,7 @@
 ﻿#include "Modifiers/AlsAnimationModifier_CopyCurves.h"
 
 #include "Animation/AnimSequence.h"
+#include "Modifiers/AlsAnimationModifierUtility.h"
 #include "Utility/AlsMacros.h"
 
 // ReSharper disable once CppUnusedIncludeDirective
@@ -37,17 +38,17 @@ void UAlsAnimationModifier_CopyCurves::OnApply_Implementation(UAnimSequence* Seq
 
 void UAlsAnimationModifier_CopyCurves::CopyCurve(UAnimSequence* SourceSequence, UAnimSequence* TargetSequence, const FName& CurveName)
 {
-	static TArray<float> CurveTimes;
-	check(CurveTimes.IsEmpty())
-
-	static TArray<float> CurveValues;
-	check(CurveValues.IsEmpty())
+	const auto* SourceCurve{
+		SourceSequence->GetCurveData().FloatCurves.FindByPredicate([&CurveName](const FFloatCurve& Curve)
+		{
+			return Curve.Name.DisplayName == CurveName;
+		})
+	};
 
-	ON_SCOPE_EXIT
+	if (SourceCurve == nullptr)
 	{
-		CurveTimes.Reset();
-		CurveValues.Reset();
-	};
+		return;
+	}
 
 	if (UAnimationBlueprintLibrary::DoesCurveExist(TargetSequence, CurveName, ERawCurveTrackTypes::RCT_Float))
 	{
@@ -56,6 +57,5 @@ void UAlsAnimationModifier_CopyCurves::CopyCurve(UAnimSequence* SourceSequence,
 
 	UAnimationBlueprintLibrary::AddCurve(TargetSequence, CurveName);
 
-	UAnimationBlueprintLibrary::GetFloatKeys(SourceSequence, CurveName, CurveTimes, CurveValues);
-	UAnimationBlueprintLibrary::AddFloatCurveKeys(TargetSequence, CurveName, CurveTimes, CurveValues);
+	AlsAnimationModifierUtility::SetFloatCurveKeys(TargetSequence, CurveName, SourceCurve->FloatCurve.GetConstRefOfKeys());
 }
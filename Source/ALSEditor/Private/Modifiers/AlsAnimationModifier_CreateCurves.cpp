@@ -1,6 +1,7 @@
 ﻿#include "Modifiers/AlsAnimationModifier_CreateCurves.h"
 
 #include "Animation/AnimSequence.h"
+#include "Modifiers/AlsAnimationModifierUtility.h"
 
 // ReSharper disable once CppUnusedIncludeDirective
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimationModifier_CreateCurves)
@@ -9,6 +10,8 @@ void UAlsAnimationModifier_CreateCurves::OnApply_Implementation(UAnimSequence* S
 {
 	Super::OnApply_Implementation(Sequence);
 
+	TArray<FRichCurveKey> Keys;
+
 	for (const auto& Curve : Curves)
 	{
 		if (UAnimationBlueprintLibrary::DoesCurveExist(Sequence, Curve.Name, ERawCurveTrackTypes::RCT_Float))
@@ -23,20 +26,30 @@ void UAlsAnimationModifier_CreateCurves::OnApply_Implementation(UAnimSequence* S
 
 		UAnimationBlueprintLibrary::AddCurve(Sequence, Curve.Name);
 
+		Keys.Reset();
+
 		if (Curve.bAddKeyOnEachFrame)
 		{
 			for (auto i{0}; i < Sequence->GetNumberOfSampledKeys(); i++)
 			{
-				UAnimationBlueprintLibrary::AddFloatCurveKey(Sequence, Curve.Name, Sequence->GetTimeAtFrame(i), 0);
+				Keys.Emplace(Sequence->GetTimeAtFrame(i), 0.0f);
 			}
 		}
 		else
 		{
 			for (const auto& CurveKey : Curve.Keys)
 			{
-				UAnimationBlueprintLibrary::AddFloatCurveKey(Sequence, Curve.Name, Sequence->GetTimeAtFrame(CurveKey.Frame),
-				                                             CurveKey.Value);
+				Keys.Emplace(Sequence->GetTimeAtFrame(CurveKey.Frame), CurveKey.Value);
 			}
+
+			// Curve keys must be sorted by time.
+
+			Keys.StableSort([](const FRichCurveKey& A, const FRichCurveKey& B)
+			{
+				return A.Time < B.Time;
+			});
 		}
+
+		AlsAnimationModifierUtility::SetFloatCurveKeys(Sequence, Curve.Name, Keys);
 	}
 }
@@ -1,6 +1,7 @@
 ﻿#include "Modifiers/AlsAnimationModifier_CreateLayeringCurves.h"
 
 #include "Animation/AnimSequence.h"
+#include "Modifiers/AlsAnimationModifierUtility.h"
 
 // ReSharper disable once CppUnusedIncludeDirective
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimationModifier_CreateLayeringCurves)
@@ -20,6 +21,8 @@ void UAlsAnimationModifier_CreateLayeringCurves::OnApply_Implementation(UAnimSeq
 void UAlsAnimationModifier_CreateLayeringCurves::CreateCurves(UAnimSequence* Sequence, const TArray<FName>& Names,
                                                               const float Value) const
 {
+	TArray<FRichCurveKey> Keys;
+
 	for (const auto& CurveName : Names)
 	{
 		if (UAnimationBlueprintLibrary::DoesCurveExist(Sequence, CurveName, ERawCurveTrackTypes::RCT_Float))
@@ -34,16 +37,20 @@ void UAlsAnimationModifier_CreateLayeringCurves::CreateCurves(UAnimSequence* Seq
 
 		UAnimationBlueprintLibrary::AddCurve(Sequence, CurveName);
 
+		Keys.Reset();
+
 		if (bAddKeyOnEachFrame)
 		{
 			for (auto i{0}; i < Sequence->GetNumberOfSampledKeys(); i++)
 			{
-				UAnimationBlueprintLibrary::AddFloatCurveKey(Sequence, CurveName, Sequence->GetTimeAtFrame(i), Value);
+				Keys.Emplace(Sequence->GetTimeAtFrame(i), Value);
 			}
 		}
 		else
 		{
-			UAnimationBlueprintLibrary::AddFloatCurveKey(Sequence, CurveName, Sequence->GetTimeAtFrame(0), Value);
+			Keys.Emplace(Sequence->GetTimeAtFrame(0), Value);
 		}
+
+		AlsAnimationModifierUtility::SetFloatCurveKeys(Sequence, CurveName, Keys);
 	}
 }
@@ -0,0 +1,32 @@
+#include "Nodes/AlsAnimGraphNode_FootIk.h"
+
+#define LOCTEXT_NAMESPACE "AlsFootIkAnimationGraphNode"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimGraphNode_FootIk)
+
+FText UAlsAnimGraphNode_FootIk::GetNodeTitle(const ENodeTitleType::Type TitleType) const
+{
+	return GetControllerDescription();
+}
+
+FText UAlsAnimGraphNode_FootIk::GetTooltipText() const
+{
+	return LOCTEXT("Tooltip", "Runs the same steps as the ALS control rig (diagonal scaling, pelvis offset, spine rotation, hand ik and foot ik) using the control rig input of the ALS animation instance");
+}
+
+FString UAlsAnimGraphNode_FootIk::GetNodeCategory() const
+{
+	return FString{TEXTVIEW("ALS")};
+}
+
+FText UAlsAnimGraphNode_FootIk::GetControllerDescription() const
+{
+	return LOCTEXT("Title", "Foot Ik");
+}
+
+const FAnimNode_SkeletalControlBase* UAlsAnimGraphNode_FootIk::GetNode() const
+{
+	return &Node;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,22 @@
+#include "Nodes/AlsAnimGraphNode_LayeringBlend.h"
+
+#define LOCTEXT_NAMESPACE "AlsLayeringBlendAnimationGraphNode"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimGraphNode_LayeringBlend)
+
+FText UAlsAnimGraphNode_LayeringBlend::GetNodeTitle(const ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("Title", "Blend Layers");
+}
+
+FText UAlsAnimGraphNode_LayeringBlend::GetTooltipText() const
+{
+	return LOCTEXT("Tooltip", "Blends the base, overlay and slot poses per body region using the layering state");
+}
+
+FString UAlsAnimGraphNode_LayeringBlend::GetNodeCategory() const
+{
+	return FString{TEXTVIEW("ALS")};
+}
+
+#undef LOCTEXT_NAMESPACE
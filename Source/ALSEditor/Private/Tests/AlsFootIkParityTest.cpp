@@ -0,0 +1,203 @@
+#include "AnimationRuntime.h"
+#include "ControlRig.h"
+#include "Engine/SkeletalMesh.h"
+#include "Misc/AutomationTest.h"
+#include "Nodes/AlsAnimNode_FootIk.h"
+#include "Rigs/RigHierarchy.h"
+#include "Utility/AlsConstants.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AlsFootIkParityTest
+{
+	static const TCHAR* SkeletalMeshPath{TEXT("/ALS/ALS/Character/SKM_Als.SKM_Als")};
+	static const TCHAR* ControlRigClassPath{TEXT("/ALS/ALS/Character/CR_Als.CR_Als_C")};
+
+	static constexpr auto FramesCount{120};
+	static constexpr auto DeltaTime{1.0f / 60.0f};
+
+	static constexpr auto LocationTolerance{0.05f};
+	static constexpr auto RotationTolerance{0.1f};
+	static constexpr auto ScaleTolerance{0.001f};
+
+	// Exposes the protected evaluation entry points of the node, so that it can run outside of an animation graph.
+	struct FFootIkNode : public FAlsAnimNode_FootIk
+	{
+		void Initialize(const FBoneContainer& RequiredBones)
+		{
+			ActualAlpha = 1.0f;
+			InitializeRig(RequiredBones);
+		}
+
+		void Evaluate(FCSPose<FCompactPose>& Pose, const FBlendedCurve& Curve, const float NewDeltaTime)
+		{
+			DeltaTime = NewDeltaTime;
+			EvaluateRig(Pose, Curve);
+		}
+	};
+
+	FAlsControlRigInput MakeInput(const int32 FrameIndex, const FVector& FootLeftLocation, const FVector& FootRightLocation)
+	{
+		// Sweeps every input of the control rig, so that each step of the rig is exercised, including pelvis offset
+		// clamping, spring interpolation, foot ik location clamping by leg length and switching between ik bones.
+
+		const auto Time{FrameIndex * DeltaTime};
+		const auto Wave{FMath::Sin(Time * UE_TWO_PI)};
+
+		FAlsControlRigInput Input;
+		Input.bUseHandIkBones = FrameIndex >= FramesCount / 2;
+		Input.bUseFootIkBones = FrameIndex >= FramesCount / 2;
+		Input.VelocityBlendForwardAmount = 0.25f + 0.25f * Wave;
+		Input.VelocityBlendBackwardAmount = 0.25f - 0.25f * Wave;
+		Input.SpineYawAngle = 40.0f * Wave;
+		Input.FootLeftIkRotation = FRotator{10.0f * Wave, 0.0f, 5.0f}.Quaternion();
+		Input.FootLeftIkLocation = FootLeftLocation + FVector{5.0f, 0.0f, 20.0f * Wave};
+		Input.FootLeftIkAmount = FMath::Clamp(0.5f + Wave, 0.0f, 1.0f);
+		Input.FootRightIkRotation = FRotator{-10.0f * Wave, 0.0f, -5.0f}.Quaternion();
+		Input.FootRightIkLocation = FootRightLocation + FVector{-5.0f, 0.0f, -30.0f * Wave};
+		Input.FootRightIkAmount = 1.0f;
+		Input.MinMaxPelvisOffsetZ = {-40.0f, 15.0f};
+
+		return Input;
+	}
+
+	TArray<TPair<FName, float>> MakeCurves(const int32 FrameIndex)
+	{
+		const auto Wave{FMath::Abs(FMath::Sin(FrameIndex * DeltaTime * UE_PI))};
+
+		return {
+			{UAlsConstants::PoseMovingCurveName(), Wave},
+			{UAlsConstants::LayerArmLeftCurveName(), 1.0f},
+			{UAlsConstants::LayerArmRightCurveName(), Wave},
+			{UAlsConstants::HandLeftIkCurveName(), Wave},
+			{UAlsConstants::HandRightIkCurveName(), 1.0f}
+		};
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsFootIkParityTest, "ALS.FootIk.ControlRigParity",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAlsFootIkParityTest::RunTest(const FString& Parameters)
+{
+	// Evaluates the ALS control rig and the native foot ik node on the reference pose of the ALS
+	// skeletal mesh with the same input, and compares the resulting component space pose on every frame.
+
+	auto* SkeletalMesh{LoadObject<USkeletalMesh>(nullptr, AlsFootIkParityTest::SkeletalMeshPath)};
+	auto* ControlRigClass{LoadClass<UControlRig>(nullptr, AlsFootIkParityTest::ControlRigClassPath)};
+
+	if (!TestNotNull(TEXT("Skeletal mesh"), SkeletalMesh) || !TestNotNull(TEXT("Control rig class"), ControlRigClass))
+	{
+		return false;
+	}
+
+	const auto* InputProperty{FindFProperty<FStructProperty>(ControlRigClass, TEXT("RigInput"))};
+	if (!TestNotNull(TEXT("Control rig input property"), InputProperty) ||
+	    !TestTrue(TEXT("Control rig input type"), InputProperty->Struct == FAlsControlRigInput::StaticStruct()))
+	{
+		return false;
+	}
+
+	auto* ControlRig{NewObject<UControlRig>(GetTransientPackage(), ControlRigClass)};
+	ControlRig->Initialize(true);
+	ControlRig->SetBoneInitialTransformsFromSkeletalMesh(SkeletalMesh);
+
+	auto* Hierarchy{ControlRig->GetHierarchy()};
+
+	const auto& ReferenceSkeleton{SkeletalMesh->GetRefSkeleton()};
+
+	TArray<FBoneIndexType> RequiredBoneIndices;
+	RequiredBoneIndices.SetNumUninitialized(ReferenceSkeleton.GetNum());
+
+	for (auto i{0}; i < RequiredBoneIndices.Num(); i++)
+	{
+		RequiredBoneIndices[i] = static_cast<FBoneIndexType>(i);
+	}
+
+	const FBoneContainer BoneContainer{RequiredBoneIndices, FCurveEvaluationOption{true}, *SkeletalMesh};
+
+	AlsFootIkParityTest::FFootIkNode Node;
+	Node.Initialize(BoneContainer);
+
+	const auto GetReferenceLocation{
+		[&ReferenceSkeleton](const FName& BoneName)
+		{
+			return FAnimationRuntime::GetComponentSpaceTransformRefPose(ReferenceSkeleton, ReferenceSkeleton.FindBoneIndex(BoneName))
+				.GetLocation();
+		}
+	};
+
+	const auto FootLeftLocation{GetReferenceLocation(UAlsConstants::FootLeftBoneName())};
+	const auto FootRightLocation{GetReferenceLocation(UAlsConstants::FootRightBoneName())};
+
+	const auto* Skeleton{SkeletalMesh->GetSkeleton()};
+
+	for (auto FrameIndex{0}; FrameIndex < AlsFootIkParityTest::FramesCount; FrameIndex++)
+	{
+		const auto Input{AlsFootIkParityTest::MakeInput(FrameIndex, FootLeftLocation, FootRightLocation)};
+		const auto Curves{AlsFootIkParityTest::MakeCurves(FrameIndex)};
+
+		// Control rig.
+
+		Hierarchy->ResetPoseToInitial(ERigElementType::Bone);
+
+		for (const auto& [CurveName, CurveValue] : Curves)
+		{
+			Hierarchy->SetCurveValue(FRigElementKey{CurveName, ERigElementType::Curve}, CurveValue);
+		}
+
+		*InputProperty->ContainerPtrToValuePtr<FAlsControlRigInput>(ControlRig) = Input;
+
+		ControlRig->SetDeltaTime(AlsFootIkParityTest::DeltaTime);
+		ControlRig->Evaluate_AnyThread();
+
+		// Native node.
+
+		FCompactPose Pose;
+		Pose.SetBoneContainer(&BoneContainer);
+		Pose.ResetToRefPose();
+
+		FCSPose<FCompactPose> ComponentSpacePose;
+		ComponentSpacePose.InitPose(Pose);
+
+		FBlendedCurve Curve;
+		Curve.InitFrom(BoneContainer);
+
+		for (const auto& [CurveName, CurveValue] : Curves)
+		{
+			Curve.Set(Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, CurveName), CurveValue);
+		}
+
+		Node.Input = Input;
+		Node.Evaluate(ComponentSpacePose, Curve, AlsFootIkParityTest::DeltaTime);
+
+		// Comparison.
+
+		for (const auto BoneIndex : Pose.ForEachBoneIndex())
+		{
+			const auto BoneName{ReferenceSkeleton.GetBoneName(BoneContainer.MakeMeshPoseIndex(BoneIndex).GetInt())};
+
+			const FRigElementKey BoneKey{BoneName, ERigElementType::Bone};
+			if (!Hierarchy->Contains(BoneKey))
+			{
+				continue;
+			}
+
+			const auto ControlRigTransform{Hierarchy->GetGlobalTransform(BoneKey)};
+			const auto& NativeTransform{ComponentSpacePose.GetComponentSpaceTransform(BoneIndex)};
+
+			if (!ControlRigTransform.GetLocation().Equals(NativeTransform.GetLocation(), AlsFootIkParityTest::LocationTolerance) ||
+			    FMath::RadiansToDegrees(ControlRigTransform.GetRotation().AngularDistance(NativeTransform.GetRotation())) >
+			    AlsFootIkParityTest::RotationTolerance ||
+			    !ControlRigTransform.GetScale3D().Equals(NativeTransform.GetScale3D(), AlsFootIkParityTest::ScaleTolerance))
+			{
+				AddError(FString::Printf(TEXT("Frame %d: %s: control rig: %s, native node: %s."), FrameIndex, *BoneName.ToString(),
+				                         *ControlRigTransform.ToHumanReadableString(), *NativeTransform.ToHumanReadableString()));
+			}
+		}
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif
@@ -0,0 +1,229 @@
+#include "Validation/AlsAnimationValidator.h"
+
+#include "AlsSkeletonUtility.h"
+#include "Algo/LevenshteinDistance.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequenceBase.h"
+#include "Utility/AlsCameraConstants.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimationValidator)
+
+#define LOCTEXT_NAMESPACE "AlsAnimationValidator"
+
+TSet<FName> UAlsAnimationValidator::GetKnownCurveNames() const
+{
+	TSet<FName> KnownCurveNames{SkeletonCurveNames};
+
+	for (const auto& Requirement : CurvesRequirements)
+	{
+		KnownCurveNames.Append(Requirement.CurveNames);
+	}
+
+	KnownCurveNames.Append({
+		UAlsCameraConstants::CameraOffsetXCurveName(),
+		UAlsCameraConstants::CameraOffsetYCurveName(),
+		UAlsCameraConstants::CameraOffsetZCurveName(),
+		UAlsCameraConstants::PivotOffsetXCurveName(),
+		UAlsCameraConstants::PivotOffsetYCurveName(),
+		UAlsCameraConstants::PivotOffsetZCurveName(),
+		UAlsCameraConstants::LocationLagXCurveName(),
+		UAlsCameraConstants::LocationLagYCurveName(),
+		UAlsCameraConstants::LocationLagZCurveName(),
+		UAlsCameraConstants::RotationLagCurveName(),
+		UAlsCameraConstants::FirstPersonOverrideCurveName(),
+		UAlsCameraConstants::TraceOverrideCurveName()
+	});
+
+	return KnownCurveNames;
+}
+
+void UAlsAnimationValidator::ValidateAnimationAsset(const UObject* Asset, FAlsAnimationValidationReport& Report) const
+{
+	Report.AssetPath = Asset->GetPathName();
+	Report.AssetClass = Asset->GetClass()->GetName();
+
+	const auto* Skeleton{Cast<USkeleton>(Asset)};
+	if (IsValid(Skeleton))
+	{
+		ValidateSkeleton(Skeleton, Report);
+		return;
+	}
+
+	const auto* Animation{Cast<UAnimSequenceBase>(Asset)};
+	if (IsValid(Animation))
+	{
+		ValidateAnimation(Animation, Report);
+	}
+}
+
+bool UAlsAnimationValidator::CanValidateAsset_Implementation(UObject* Asset) const
+{
+	return IsValid(Asset) && (Asset->IsA<USkeleton>() || Asset->IsA<UAnimSequenceBase>());
+}
+
+EDataValidationResult UAlsAnimationValidator::ValidateLoadedAsset_Implementation(UObject* Asset, TArray<FText>& ValidationErrors)
+{
+	FAlsAnimationValidationReport Report;
+	ValidateAnimationAsset(Asset, Report);
+
+	for (const auto& CurveName : Report.MissingCurves)
+	{
+		AssetFails(Asset, FText::Format(LOCTEXT("MissingCurve", "Curve {0} is missing."), FText::FromName(CurveName)), ValidationErrors);
+	}
+
+	for (const auto& SlotName : Report.MissingSlots)
+	{
+		AssetFails(Asset, FText::Format(LOCTEXT("MissingSlot", "Slot {0} is missing."), FText::FromName(SlotName)), ValidationErrors);
+	}
+
+	for (const auto& VirtualBoneName : Report.MissingVirtualBones)
+	{
+		AssetFails(Asset, FText::Format(LOCTEXT("MissingVirtualBone", "Virtual bone {0} is missing."),
+		                                FText::FromName(VirtualBoneName)), ValidationErrors);
+	}
+
+	for (const auto& Curve : Report.MisnamedCurves)
+	{
+		AssetWarning(Asset, FText::Format(LOCTEXT("MisnamedCurve", "Curve {0} is probably a misspelled {1} curve."),
+		                                  FText::FromName(Curve.Name), FText::FromName(Curve.ExpectedName)));
+	}
+
+	// Constant curves are not reported here, since they are often created intentionally, for example by
+	// the layering curves modifier. They are only listed by the AlsValidateAnimations commandlet.
+
+	if (GetValidationResult() != EDataValidationResult::Invalid)
+	{
+		AssetPasses(Asset);
+	}
+
+	return GetValidationResult();
+}
+
+void UAlsAnimationValidator::ValidateSkeleton(const USkeleton* Skeleton, FAlsAnimationValidationReport& Report) const
+{
+	auto MissingCurves{UAlsSkeletonUtility::GetMissingAnimationCurves(Skeleton, SkeletonCurveNames)};
+	auto MissingSlots{UAlsSkeletonUtility::GetMissingSlots(Skeleton, SkeletonSlotNames)};
+	auto MissingVirtualBones{UAlsSkeletonUtility::GetMissingVirtualBones(Skeleton, SkeletonVirtualBoneNames)};
+
+	if (MissingCurves.Num() >= SkeletonCurveNames.Num() &&
+	    MissingSlots.Num() >= SkeletonSlotNames.Num() &&
+	    MissingVirtualBones.Num() >= SkeletonVirtualBoneNames.Num())
+	{
+		return;
+	}
+
+	Report.MissingCurves = MoveTemp(MissingCurves);
+	Report.MissingSlots = MoveTemp(MissingSlots);
+	Report.MissingVirtualBones = MoveTemp(MissingVirtualBones);
+}
+
+void UAlsAnimationValidator::ValidateAnimation(const UAnimSequenceBase* Animation, FAlsAnimationValidationReport& Report) const
+{
+	const auto& Curves{Animation->GetCurveData().FloatCurves};
+
+	const auto ContainsCurve{
+		[&Curves](const FName& CurveName)
+		{
+			return Curves.ContainsByPredicate([&CurveName](const FFloatCurve& Curve)
+			{
+				return Curve.Name.DisplayName == CurveName;
+			});
+		}
+	};
+
+	const auto PackageName{Animation->GetPackage()->GetName()};
+
+	for (const auto& Requirement : CurvesRequirements)
+	{
+		if (Requirement.PackagePath.IsEmpty() || !PackageName.StartsWith(Requirement.PackagePath))
+		{
+			continue;
+		}
+
+		for (const auto& CurveName : Requirement.CurveNames)
+		{
+			if (!ContainsCurve(CurveName))
+			{
+				Report.MissingCurves.AddUnique(CurveName);
+			}
+		}
+	}
+
+	const auto KnownCurveNames{GetKnownCurveNames()};
+
+	for (const auto& Curve : Curves)
+	{
+		const auto& CurveName{Curve.Name.DisplayName};
+
+		if (!KnownCurveNames.Contains(CurveName))
+		{
+			// Curve names are case-insensitive, so they are compared in lower case.
+
+			const auto CurveString{CurveName.ToString().ToLower()};
+
+			auto ClosestDistance{MisnamedCurveMaxDistance + 1};
+			FName ClosestCurveName;
+
+			for (const auto& KnownCurveName : KnownCurveNames)
+			{
+				const auto Distance{Algo::LevenshteinDistance(CurveString, KnownCurveName.ToString().ToLower())};
+				if (Distance < ClosestDistance)
+				{
+					ClosestDistance = Distance;
+					ClosestCurveName = KnownCurveName;
+				}
+			}
+
+			if (!ClosestCurveName.IsNone())
+			{
+				auto& MisnamedCurve{Report.MisnamedCurves.Emplace_GetRef()};
+				MisnamedCurve.Name = CurveName;
+				MisnamedCurve.ExpectedName = ClosestCurveName;
+			}
+		}
+
+		const auto& Keys{Curve.FloatCurve.GetConstRefOfKeys()};
+
+		auto MinValue{Keys.Num() > 0 ? Keys[0].Value : Curve.FloatCurve.GetDefaultValue()};
+		auto MaxValue{MinValue};
+
+		for (const auto& Key : Keys)
+		{
+			MinValue = FMath::Min(MinValue, Key.Value);
+			MaxValue = FMath::Max(MaxValue, Key.Value);
+		}
+
+		// Cubic interpolation can overshoot between keys with different tangents, so only flat curves are considered constant.
+
+		const auto bFlat{
+			!Keys.ContainsByPredicate([this](const FRichCurveKey& Key)
+			{
+				return Key.InterpMode == RCIM_Cubic &&
+				       (FMath::Abs(Key.ArriveTangent) > ConstantCurveTolerance || FMath::Abs(Key.LeaveTangent) > ConstantCurveTolerance);
+			})
+		};
+
+		if (bFlat && MaxValue - MinValue <= ConstantCurveTolerance)
+		{
+			auto& ConstantCurve{Report.ConstantCurves.Emplace_GetRef()};
+			ConstantCurve.Name = CurveName;
+			ConstantCurve.Value = MinValue;
+		}
+	}
+
+	const auto* Montage{Cast<UAnimMontage>(Animation)};
+	const auto* Skeleton{Animation->GetSkeleton()};
+
+	if (IsValid(Montage) && IsValid(Skeleton))
+	{
+		for (const auto& SlotTrack : Montage->SlotAnimTracks)
+		{
+			if (!Skeleton->ContainsSlotName(SlotTrack.SlotName))
+			{
+				Report.MissingSlots.AddUnique(SlotTrack.SlotName);
+			}
+		}
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AlsCameraCurvesUtility.generated.h"
+
+class UAlsCameraAnimationInstance;
+class UAlsCameraCurvesSettings;
+class USkeletalMesh;
+
+UCLASS()
+class ALSEDITOR_API UAlsCameraCurvesUtility : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Converts the camera animation blueprint into a native camera curves table. The animation blueprint is sampled
+	// in every combination of view mode, locomotion mode, rotation mode, stance, gait, locomotion action and shoulder,
+	// and the resulting curves are written to the camera curves settings, replacing all of its existing entries.
+	// The sample duration must be greater than zero and long enough for all blends in the animation blueprint to complete.
+	UFUNCTION(BlueprintCallable, Category = "ALS|Als Camera Curves Utility")
+	static void BakeCameraCurvesFromAnimationBlueprint(UAlsCameraCurvesSettings* CurvesSettings, USkeletalMesh* CameraMesh,
+	                                                   TSubclassOf<UAlsCameraAnimationInstance> AnimationClass,
+	                                                   float SampleDuration = 2.0f, float BlendDuration = 0.3f);
+};
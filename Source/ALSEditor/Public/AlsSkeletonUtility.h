@@ -42,6 +42,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Als Skeleton Utility")
 	static void AddOrReplaceWeightBlendProfile(USkeleton* Skeleton, FName BlendProfileName, const TArray<FAlsBlendProfileEntry>& Entries);
 
+	UFUNCTION(BlueprintPure, Category = "ALS|Als Skeleton Utility", Meta = (ReturnDisplayName = "Missing Curve Names"))
+	static TArray<FName> GetMissingAnimationCurves(const USkeleton* Skeleton, const TArray<FName>& CurveNames);
+
+	UFUNCTION(BlueprintPure, Category = "ALS|Als Skeleton Utility", Meta = (ReturnDisplayName = "Missing Slot Names"))
+	static TArray<FName> GetMissingSlots(const USkeleton* Skeleton, const TArray<FName>& SlotNames);
+
+	UFUNCTION(BlueprintPure, Category = "ALS|Als Skeleton Utility", Meta = (ReturnDisplayName = "Missing Virtual Bone Names"))
+	static TArray<FName> GetMissingVirtualBones(const USkeleton* Skeleton, const TArray<FName>& VirtualBoneNames);
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Als Skeleton Utility", Meta = (AutoCreateRefTerm = "BoneName"))
 	static void SetBoneRetargetingMode(USkeleton* Skeleton, const FName& BoneName,
 	                                   EBoneTranslationRetargetingMode::Type RetargetingMode, bool bIncludeDescendants);
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "AlsApplyAnimationModifiersCommandlet.generated.h"
+
+class UAnimationModifier;
+class UAnimSequence;
+
+// Applies animation modifiers to all animation sequences matching the filter and saves the modified packages.
+//
+// UnrealEditor-Cmd.exe <Project> -Run=AlsApplyAnimationModifiers -Modifiers=<Class>[,<Class>...]
+//     [-Paths=/Game[,<Path>...]] [-Filter=<Substring>] [-Force] [-BatchSize=64] [-Shards=1 -Shard=0]
+//
+// Modifier classes can be specified either by their full path or by their name, e.g. AlsAnimationModifier_CreateCurves,
+// and are applied with their default settings. Sequences whose bone tracks, modifier settings and curves of the sequences
+// referenced by the modifiers have not changed since the last run are skipped unless -Force is specified, so -Force is
+// required only after changing other assets referenced by the modifiers.
+// Since modifiers can only be applied on the game thread, multiple commandlet processes can be run in parallel using
+// -Shards and -Shard, each processing its own subset of the sequences.
+UCLASS()
+class ALSEDITOR_API UAlsApplyAnimationModifiersCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAnimationModifier>> Modifiers;
+
+public:
+	UAlsApplyAnimationModifiersCommandlet();
+
+	virtual int32 Main(const FString& Parameters) override;
+
+private:
+	static FString CalculateSourceDataHash(const UAnimSequence* Sequence, const FString& ModifiersSettings);
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "AlsOptimizeAnimationCurvesCommandlet.generated.h"
+
+USTRUCT()
+struct ALSEDITOR_API FAlsCurvesOptimizationReport
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString AssetPath;
+
+	UPROPERTY()
+	int32 RemovedCurvesCount{0};
+
+	UPROPERTY()
+	int32 ReducedCurvesCount{0};
+
+	UPROPERTY()
+	int32 RemovedKeysCount{0};
+
+	// Estimated size of the removed raw curve data.
+	UPROPERTY()
+	int64 SavedBytes{0};
+};
+
+USTRUCT()
+struct ALSEDITOR_API FAlsCurvesOptimizationReports
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 SequencesCount{0};
+
+	UPROPERTY()
+	int64 SavedBytes{0};
+
+	// Only changed sequences are listed.
+	UPROPERTY()
+	TArray<FAlsCurvesOptimizationReport> Sequences;
+};
+
+// Optimizes the ALS curves of all animation sequences under the specified paths: constant curves are reduced to a
+// single key, and keys that can be removed without changing the curve by more than the tolerance are removed.
+// With -RemoveDefaultCurves, constant curves equal to zero are removed entirely, since a missing curve evaluates to zero.
+// This is not enabled by default, because the curves blend node in the Combine and CombinePreserved modes distinguishes
+// between missing curves and curves equal to zero. With -DryRun, nothing is saved and only the report is written.
+//
+// UnrealEditor-Cmd.exe <Project> -Run=AlsOptimizeAnimationCurves [-Paths=/Game[,<Path>...]] [-Tolerance=0.001]
+//     [-RemoveDefaultCurves] [-AllCurves] [-DryRun] [-Report=<FilePath>] [-BatchSize=64]
+UCLASS()
+class ALSEDITOR_API UAlsOptimizeAnimationCurvesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAlsOptimizeAnimationCurvesCommandlet();
+
+	virtual int32 Main(const FString& Parameters) override;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "Validation/AlsAnimationValidator.h"
+#include "AlsValidateAnimationsCommandlet.generated.h"
+
+USTRUCT()
+struct ALSEDITOR_API FAlsAnimationValidationReports
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 AssetsCount{0};
+
+	UPROPERTY()
+	int32 InvalidAssetsCount{0};
+
+	// Only assets with at least one issue are listed.
+	UPROPERTY()
+	TArray<FAlsAnimationValidationReport> Assets;
+};
+
+// Validates all skeletons, animation sequences and montages under the specified paths with UAlsAnimationValidator,
+// additionally lists the curves that have the same value on every frame, and writes the results to a JSON file.
+// Returns a non-zero exit code if any asset has missing curves, slots or virtual bones. Misnamed
+// and constant curves are only listed in the report and don't affect the exit code.
+//
+// UnrealEditor-Cmd.exe <Project> -Run=AlsValidateAnimations [-Paths=/Game[,<Path>...]] [-Report=<FilePath>] [-BatchSize=256]
+UCLASS()
+class ALSEDITOR_API UAlsValidateAnimationsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAlsValidateAnimationsCommandlet();
+
+	virtual int32 Main(const FString& Parameters) override;
+};
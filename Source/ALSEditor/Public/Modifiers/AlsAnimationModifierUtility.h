@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Curves/RichCurve.h"
+
+class UAnimSequence;
+
+namespace AlsAnimationModifierUtility
+{
+	// Replaces all keys of an existing float curve with a single data model change. Adding keys one by one goes
+	// through the animation data controller and notifies the sequence for every key, which is very slow for long sequences.
+	ALSEDITOR_API void SetFloatCurveKeys(UAnimSequence* Sequence, const FName& CurveName, const TArray<FRichCurveKey>& Keys);
+}
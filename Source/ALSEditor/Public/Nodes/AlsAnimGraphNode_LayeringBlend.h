@@ -0,0 +1,22 @@
+#pragma once
+
+#include "AnimGraphNode_Base.h"
+#include "Nodes/AlsAnimNode_LayeringBlend.h"
+#include "AlsAnimGraphNode_LayeringBlend.generated.h"
+
+UCLASS()
+class ALSEDITOR_API UAlsAnimGraphNode_LayeringBlend : public UAnimGraphNode_Base
+{
+	GENERATED_BODY()
+
+protected:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	FAlsAnimNode_LayeringBlend Node;
+
+public:
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+
+	virtual FText GetTooltipText() const override;
+
+	virtual FString GetNodeCategory() const override;
+};
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "EditorValidatorBase.h"
+#include "Utility/AlsConstants.h"
+#include "AlsAnimationValidator.generated.h"
+
+class UAnimSequenceBase;
+class USkeleton;
+
+USTRUCT()
+struct ALSEDITOR_API FAlsAnimationCurvesRequirement
+{
+	GENERATED_BODY()
+
+	// Animation sequences and montages whose package path starts with this path must contain all of the curves below.
+	UPROPERTY(Config)
+	FString PackagePath;
+
+	UPROPERTY(Config)
+	TArray<FName> CurveNames;
+};
+
+USTRUCT()
+struct ALSEDITOR_API FAlsAnimationValidationMisnamedCurve
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName Name;
+
+	UPROPERTY()
+	FName ExpectedName;
+};
+
+USTRUCT()
+struct ALSEDITOR_API FAlsAnimationValidationConstantCurve
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName Name;
+
+	UPROPERTY()
+	float Value{0.0f};
+};
+
+USTRUCT()
+struct ALSEDITOR_API FAlsAnimationValidationReport
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString AssetPath;
+
+	UPROPERTY()
+	FString AssetClass;
+
+	UPROPERTY()
+	TArray<FName> MissingCurves;
+
+	UPROPERTY()
+	TArray<FName> MissingSlots;
+
+	UPROPERTY()
+	TArray<FName> MissingVirtualBones;
+
+	// Reported as warnings rather than errors, since a curve with a similar name may also be an intentional custom curve.
+	UPROPERTY()
+	TArray<FAlsAnimationValidationMisnamedCurve> MisnamedCurves;
+
+	// Curves that have the same value on every frame and can be stripped.
+	UPROPERTY()
+	TArray<FAlsAnimationValidationConstantCurve> ConstantCurves;
+
+public:
+	bool HasErrors() const;
+
+	bool HasIssues() const;
+};
+
+inline bool FAlsAnimationValidationReport::HasErrors() const
+{
+	return MissingCurves.Num() > 0 || MissingSlots.Num() > 0 || MissingVirtualBones.Num() > 0;
+}
+
+inline bool FAlsAnimationValidationReport::HasIssues() const
+{
+	return HasErrors() || MisnamedCurves.Num() > 0 || ConstantCurves.Num() > 0;
+}
+
+// Checks that skeletons contain the curves, slots and virtual bones required by ALS, that animation sequences
+// and montages contain the curves required by their location, and that none of their curves is a misspelled ALS
+// curve, since a missing or misspelled curve silently evaluates to zero. Configured in the DefaultEditor.ini file.
+UCLASS(Config = Editor, DefaultConfig, DisplayName = "Als Animation Validator")
+class ALSEDITOR_API UAlsAnimationValidator : public UEditorValidatorBase
+{
+	GENERATED_BODY()
+
+protected:
+	// A skeleton is only validated if it already contains at least one of these curves, slots or
+	// virtual bones, so that skeletons that are not used with ALS are not reported.
+	UPROPERTY(Config)
+	TArray<FName> SkeletonCurveNames
+	{
+		UAlsConstants::LayerHeadCurveName(),
+		UAlsConstants::LayerHeadAdditiveCurveName(),
+		UAlsConstants::LayerHeadSlotCurveName(),
+		UAlsConstants::LayerArmLeftCurveName(),
+		UAlsConstants::LayerArmLeftAdditiveCurveName(),
+		UAlsConstants::LayerArmLeftLocalSpaceCurveName(),
+		UAlsConstants::LayerArmLeftSlotCurveName(),
+		UAlsConstants::LayerArmRightCurveName(),
+		UAlsConstants::LayerArmRightAdditiveCurveName(),
+		UAlsConstants::LayerArmRightLocalSpaceCurveName(),
+		UAlsConstants::LayerArmRightSlotCurveName(),
+		UAlsConstants::LayerHandLeftCurveName(),
+		UAlsConstants::LayerHandRightCurveName(),
+		UAlsConstants::LayerSpineCurveName(),
+		UAlsConstants::LayerSpineAdditiveCurveName(),
+		UAlsConstants::LayerSpineSlotCurveName(),
+		UAlsConstants::LayerPelvisCurveName(),
+		UAlsConstants::LayerPelvisSlotCurveName(),
+		UAlsConstants::LayerLegsCurveName(),
+		UAlsConstants::LayerLegsSlotCurveName(),
+
+		UAlsConstants::HandLeftIkCurveName(),
+		UAlsConstants::HandRightIkCurveName(),
+
+		UAlsConstants::ViewBlockCurveName(),
+		UAlsConstants::AllowAimingCurveName(),
+
+		UAlsConstants::HipsDirectionLockCurveName(),
+
+		UAlsConstants::PoseGaitCurveName(),
+		UAlsConstants::PoseMovingCurveName(),
+		UAlsConstants::PoseStandingCurveName(),
+		UAlsConstants::PoseCrouchingCurveName(),
+		UAlsConstants::PoseInAirCurveName(),
+		UAlsConstants::PoseGroundedCurveName(),
+
+		UAlsConstants::FootLeftIkCurveName(),
+		UAlsConstants::FootLeftLockCurveName(),
+		UAlsConstants::FootRightIkCurveName(),
+		UAlsConstants::FootRightLockCurveName(),
+		UAlsConstants::FootPlantedCurveName(),
+		UAlsConstants::FeetCrossingCurveName(),
+
+		UAlsConstants::RotationYawSpeedCurveName(),
+		UAlsConstants::RotationYawOffsetCurveName(),
+		UAlsConstants::AllowTransitionsCurveName(),
+		UAlsConstants::SprintBlockCurveName(),
+		UAlsConstants::GroundPredictionBlockCurveName(),
+		UAlsConstants::FootstepSoundBlockCurveName()
+	};
+
+	UPROPERTY(Config)
+	TArray<FName> SkeletonSlotNames
+	{
+		UAlsConstants::TransitionSlotName(),
+		UAlsConstants::TurnInPlaceStandingSlotName(),
+		UAlsConstants::TurnInPlaceCrouchingSlotName()
+	};
+
+	UPROPERTY(Config)
+	TArray<FName> SkeletonVirtualBoneNames
+	{
+		UAlsConstants::FootLeftVirtualBoneName(),
+		UAlsConstants::FootRightVirtualBoneName(),
+		UAlsConstants::HandLeftGunVirtualBoneName(),
+		UAlsConstants::HandRightGunVirtualBoneName()
+	};
+
+	UPROPERTY(Config)
+	TArray<FAlsAnimationCurvesRequirement> CurvesRequirements;
+
+	// Curves whose name differs from the name of a known ALS curve by no more than this number of characters are reported as misnamed.
+	UPROPERTY(Config, Meta = (ClampMin = 0))
+	int32 MisnamedCurveMaxDistance{2};
+
+	// Curves whose values differ by no more than this tolerance are reported as constant.
+	UPROPERTY(Config, Meta = (ClampMin = 0))
+	float ConstantCurveTolerance{UE_KINDA_SMALL_NUMBER};
+
+public:
+	// Names of all curves used by ALS and the ALS camera, plus any additionally required curves.
+	TSet<FName> GetKnownCurveNames() const;
+
+	// Only reads the asset, so it is safe to call for multiple assets in parallel.
+	void ValidateAnimationAsset(const UObject* Asset, FAlsAnimationValidationReport& Report) const;
+
+protected:
+	virtual bool CanValidateAsset_Implementation(UObject* Asset) const override;
+
+	virtual EDataValidationResult ValidateLoadedAsset_Implementation(UObject* Asset, TArray<FText>& ValidationErrors) override;
+
+private:
+	void ValidateSkeleton(const USkeleton* Skeleton, FAlsAnimationValidationReport& Report) const;
+
+	void ValidateAnimation(const UAnimSequenceBase* Animation, FAlsAnimationValidationReport& Report) const;
+};
@@ -0,0 +1,588 @@
+#include "AlsCrowdBenchmarkSubsystem.h"
+
+#include "AlsCameraComponent.h"
+#include "AlsCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Utility/AlsBenchmark.h"
+#include "Utility/AlsGameplayTags.h"
+#include "Utility/AlsLog.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsCrowdBenchmarkSubsystem)
+
+namespace AlsCrowdBenchmarkSubsystem
+{
+	enum class EPhase : uint8
+	{
+		Walk,
+		Run,
+		Sprint,
+		Crouch,
+		Jump,
+		Mantle,
+		Roll,
+		Ragdoll,
+		Count
+	};
+
+	// Number of frames each scripted input phase lasts.
+	constexpr auto PhaseFramesCount{60};
+
+	// Distance between spawned characters.
+	constexpr auto CharacterSpacing{300.0f};
+
+	// Distance by which the floor extends beyond the spawn grid, so that characters don't walk off it during the benchmark.
+	constexpr auto FloorMargin{5000.0f};
+
+	// Height must be within the ledge height range of the grounded mantling trace settings.
+	static const FVector MantlingObstacleExtent{25.0f, 100.0f, 50.0f};
+
+	// Distance between the capsule of a character and its obstacle when the mantling phase starts.
+	constexpr auto MantlingObstacleDistance{30.0f};
+
+	static const TCHAR* BoxMeshPath{TEXT("/Engine/BasicShapes/Cube.Cube")};
+
+	// Size of the box static mesh.
+	constexpr auto BoxMeshSize{100.0f};
+
+	EPhase GetPhase(const int32 FrameIndex)
+	{
+		return static_cast<EPhase>(FrameIndex / PhaseFramesCount % static_cast<int32>(EPhase::Count));
+	}
+
+	AStaticMeshActor* SpawnBox(UWorld* World, UStaticMesh* Mesh, const FVector& Location, const FVector& Extent)
+	{
+		auto* Box{World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator)};
+		if (!IsValid(Box))
+		{
+			return nullptr;
+		}
+
+		// The mobility must be changed before the mesh, because the mesh of a registered static component can't be changed.
+
+		Box->SetMobility(EComponentMobility::Movable);
+		Box->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+		Box->SetActorScale3D(Extent * 2.0f / BoxMeshSize);
+
+		return Box;
+	}
+
+	UAlsCrowdBenchmarkSubsystem* GetSubsystem(const UWorld* World)
+	{
+		auto* Subsystem{IsValid(World) ? World->GetSubsystem<UAlsCrowdBenchmarkSubsystem>() : nullptr};
+		if (!IsValid(Subsystem))
+		{
+			UE_LOG(LogAls, Warning, TEXT("%hs: The crowd benchmark is not supported in this world."), __FUNCTION__);
+		}
+
+		return Subsystem;
+	}
+
+	TSubclassOf<AAlsCharacter> GetCharacterClass(const TArray<FString>& Arguments, const int32 ArgumentIndex)
+	{
+		const TSubclassOf<AAlsCharacter> CharacterClass{
+			LoadClass<AAlsCharacter>(nullptr, Arguments.IsValidIndex(ArgumentIndex)
+				                                  ? *Arguments[ArgumentIndex]
+				                                  : UAlsCrowdBenchmarkSubsystem::DefaultCharacterClassPath)
+		};
+
+		if (!IsValid(CharacterClass))
+		{
+			UE_LOG(LogAls, Warning, TEXT("%hs: No valid ALS character class specified."), __FUNCTION__);
+		}
+
+		return CharacterClass;
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs StartCommand{
+		TEXT("als.Benchmark.Crowd"),
+		TEXT("Spawns a crowd of ALS characters with scripted inputs and measures the ALS hot paths over a fixed number of frames. ")
+		TEXT("Arguments: [CharactersCount = 50] [FramesCount = 600] [CharacterClassPath = /ALS/ALS/Character/B_Als_Character]."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Arguments, UWorld* World)
+		{
+			auto* Subsystem{GetSubsystem(World)};
+			if (!IsValid(Subsystem))
+			{
+				return;
+			}
+
+			const auto CharactersCount{Arguments.IsValidIndex(0) ? FCString::Atoi(*Arguments[0]) : 50};
+			const auto FramesCount{Arguments.IsValidIndex(1) ? FCString::Atoi(*Arguments[1]) : 600};
+
+			const auto CharacterClass{GetCharacterClass(Arguments, 2)};
+			if (IsValid(CharacterClass))
+			{
+				Subsystem->Start(CharacterClass, CharactersCount, FramesCount);
+			}
+		})
+	};
+
+	FAutoConsoleCommandWithWorldAndArgs StartSpectatorCamerasCommand{
+		TEXT("als.Benchmark.SpectatorCameras"),
+		TEXT("Spawns ALS characters with scripted inputs, activates their cameras as spectator cameras, ticks these cameras in ")
+		TEXT("parallel and measures the ALS hot paths over a fixed number of frames. ")
+		TEXT("Arguments: [CamerasCount = 8] [FramesCount = 600] [CharacterClassPath = /ALS/ALS/Character/B_Als_Character]."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Arguments, UWorld* World)
+		{
+			auto* Subsystem{GetSubsystem(World)};
+			if (!IsValid(Subsystem))
+			{
+				return;
+			}
+
+			const auto CamerasCount{Arguments.IsValidIndex(0) ? FCString::Atoi(*Arguments[0]) : 8};
+			const auto FramesCount{Arguments.IsValidIndex(1) ? FCString::Atoi(*Arguments[1]) : 600};
+
+			const auto CharacterClass{GetCharacterClass(Arguments, 2)};
+			if (IsValid(CharacterClass))
+			{
+				Subsystem->Start(CharacterClass, CamerasCount, FramesCount, true);
+			}
+		})
+	};
+}
+
+const TCHAR* UAlsCrowdBenchmarkSubsystem::DefaultCharacterClassPath{TEXT("/ALS/ALS/Character/B_Als_Character.B_Als_Character_C")};
+
+void UAlsCrowdBenchmarkSubsystem::Deinitialize()
+{
+	Stop();
+
+	Super::Deinitialize();
+}
+
+TStatId UAlsCrowdBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsCrowdBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+bool UAlsCrowdBenchmarkSubsystem::IsTickable() const
+{
+	return Super::IsTickable() && IsRunning();
+}
+
+void UAlsCrowdBenchmarkSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (FrameIndex >= FramesCount)
+	{
+		WriteResults();
+		Stop();
+
+		if (FParse::Param(FCommandLine::Get(), TEXT("AlsBenchmarkExit")))
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+
+		return;
+	}
+
+	for (auto i{0}; i < Characters.Num(); i++)
+	{
+		if (IsValid(Characters[i]))
+		{
+			RefreshInputs(Characters[i], i);
+		}
+	}
+
+	if (!SpectatorCameras.IsEmpty())
+	{
+		// Tickable objects are ticked after the post physics tick group, so the animation
+		// evaluation of the cameras and their characters has already been completed.
+
+		UAlsCameraComponent::TickCamerasParallel(ToRawPtrTArrayUnsafe(SpectatorCameras), DeltaTime);
+	}
+
+	FrameIndex += 1;
+}
+
+bool UAlsCrowdBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UAlsCrowdBenchmarkSubsystem::IsRunning() const
+{
+	return FramesCount > 0;
+}
+
+void UAlsCrowdBenchmarkSubsystem::Start(const TSubclassOf<AAlsCharacter> CharacterClass, const int32 CharactersCount,
+                                        const int32 NewFramesCount, const bool bTickSpectatorCameras)
+{
+	Stop();
+
+	if (!IsValid(CharacterClass) || CharactersCount <= 0 || NewFramesCount <= 0)
+	{
+		return;
+	}
+
+	auto* World{GetWorld()};
+
+	PauseOtherCharacters();
+
+	// Characters are spawned on a square grid around the world origin.
+
+	const auto GridSize{FMath::CeilToInt(FMath::Sqrt(static_cast<float>(CharactersCount)))};
+	const auto GridOffset{(GridSize - 1) * AlsCrowdBenchmarkSubsystem::CharacterSpacing * 0.5f};
+
+	SpawnEnvironment(GridSize);
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	Characters.Reserve(CharactersCount);
+
+	for (auto i{0}; i < CharactersCount; i++)
+	{
+		const FVector Location{
+			i % GridSize * AlsCrowdBenchmarkSubsystem::CharacterSpacing - GridOffset,
+			i / GridSize * AlsCrowdBenchmarkSubsystem::CharacterSpacing - GridOffset,
+			100.0f
+		};
+
+		auto* Character{World->SpawnActor<AAlsCharacter>(CharacterClass, Location, FRotator::ZeroRotator, SpawnParameters)};
+		if (IsValid(Character))
+		{
+			Character->SpawnDefaultController();
+			Characters.Add(Character);
+		}
+	}
+
+	if (bTickSpectatorCameras)
+	{
+		for (const auto& Character : Characters)
+		{
+			auto* Camera{Character->FindComponentByClass<UAlsCameraComponent>()};
+			if (IsValid(Camera))
+			{
+				Camera->SetBatchedTick(true);
+				Camera->Activate(true);
+
+				SpectatorCameras.Add(Camera);
+			}
+		}
+
+		if (SpectatorCameras.IsEmpty())
+		{
+			UE_LOG(LogAls, Warning, TEXT("%hs: %s doesn't have an ALS camera component."), __FUNCTION__, *CharacterClass->GetName());
+		}
+	}
+
+	FramesCount = NewFramesCount;
+	FrameIndex = 0;
+	StartTime = FPlatformTime::Seconds();
+
+	FAlsBenchmark::Start();
+
+	UE_LOG(LogAls, Log, TEXT("%hs: Started the crowd benchmark with %d characters and %d spectator cameras for %d frames."),
+	       __FUNCTION__, Characters.Num(), SpectatorCameras.Num(), FramesCount);
+}
+
+void UAlsCrowdBenchmarkSubsystem::Stop()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	FAlsBenchmark::Stop();
+
+	FramesCount = 0;
+	FrameIndex = 0;
+
+	DestroyCharacters();
+	DestroyEnvironment();
+	ResumeOtherCharacters();
+}
+
+void UAlsCrowdBenchmarkSubsystem::PauseOtherCharacters()
+{
+	// The benchmark timers are global, so any other ALS character that keeps ticking during the
+	// benchmark, such as the player, would be included in the results. Ticking of these characters is
+	// disabled until the benchmark stops. Only tick functions that are currently enabled are recorded,
+	// so that tick functions that were already disabled are not enabled again when the benchmark stops.
+
+	for (TActorIterator<AAlsCharacter> Iterator{GetWorld()}; Iterator; ++Iterator)
+	{
+		auto* Character{*Iterator};
+
+		if (Character->IsActorTickEnabled())
+		{
+			Character->SetActorTickEnabled(false);
+			PausedActors.Add(Character);
+		}
+
+		for (auto* Component : Character->GetComponents())
+		{
+			if (!IsValid(Component))
+			{
+				continue;
+			}
+
+			if (Component->IsComponentTickEnabled())
+			{
+				Component->SetComponentTickEnabled(false);
+				PausedComponents.Add(Component);
+			}
+
+			// The ALS camera is ticked by its own tick function, which is disabled while the camera is batched.
+
+			auto* Camera{Cast<UAlsCameraComponent>(Component)};
+			if (IsValid(Camera) && !Camera->IsBatchedTick())
+			{
+				Camera->SetBatchedTick(true);
+				PausedCameras.Add(Camera);
+			}
+		}
+	}
+
+	if (!PausedActors.IsEmpty() || !PausedComponents.IsEmpty())
+	{
+		UE_LOG(LogAls, Log, TEXT("%hs: Paused %d actors and %d components that are not part of the crowd."),
+		       __FUNCTION__, PausedActors.Num(), PausedComponents.Num());
+	}
+}
+
+void UAlsCrowdBenchmarkSubsystem::ResumeOtherCharacters()
+{
+	for (const auto& Actor : PausedActors)
+	{
+		if (Actor.IsValid())
+		{
+			Actor->SetActorTickEnabled(true);
+		}
+	}
+
+	for (const auto& Component : PausedComponents)
+	{
+		if (Component.IsValid())
+		{
+			Component->SetComponentTickEnabled(true);
+		}
+	}
+
+	for (const auto& Camera : PausedCameras)
+	{
+		if (Camera.IsValid())
+		{
+			Camera->SetBatchedTick(false);
+		}
+	}
+
+	PausedActors.Reset();
+	PausedComponents.Reset();
+	PausedCameras.Reset();
+}
+
+void UAlsCrowdBenchmarkSubsystem::SpawnEnvironment(const int32 GridSize)
+{
+	using namespace AlsCrowdBenchmarkSubsystem;
+
+	auto* World{GetWorld()};
+
+	auto* BoxMesh{LoadObject<UStaticMesh>(nullptr, BoxMeshPath)};
+	if (!IsValid(BoxMesh))
+	{
+		UE_LOG(LogAls, Warning, TEXT("%hs: Failed to load %s, the crowd will be spawned without a floor and obstacles."),
+		       __FUNCTION__, BoxMeshPath);
+		return;
+	}
+
+	// The top of the floor is at zero height, below the spawn locations of the characters.
+
+	const auto FloorExtentXY{GridSize * CharacterSpacing * 0.5f + FloorMargin};
+
+	Floor = SpawnBox(World, BoxMesh, {0.0f, 0.0f, -BoxMeshSize * 0.5f}, {FloorExtentXY, FloorExtentXY, BoxMeshSize * 0.5f});
+
+	// Obstacles are kept below the floor until the mantling phase starts.
+
+	const auto HiddenLocation{FVector::DownVector * (BoxMeshSize + MantlingObstacleExtent.Z)};
+
+	MantlingObstacles.Reserve(GridSize * GridSize);
+
+	for (auto i{0}; i < GridSize * GridSize; i++)
+	{
+		MantlingObstacles.Add(SpawnBox(World, BoxMesh, HiddenLocation, MantlingObstacleExtent));
+	}
+}
+
+void UAlsCrowdBenchmarkSubsystem::RefreshInputs(AAlsCharacter* Character, const int32 CharacterIndex) const
+{
+	using namespace AlsCrowdBenchmarkSubsystem;
+
+	const auto Phase{GetPhase(FrameIndex)};
+	const auto bPhaseStarted{FrameIndex % PhaseFramesCount == 0};
+
+	// Each character walks in its own direction, which slowly rotates over time.
+
+	const auto MovementYawAngle{CharacterIndex * 137.5f + FrameIndex * 0.5f};
+	Character->AddMovementInput(FRotator{0.0f, MovementYawAngle, 0.0f}.Vector());
+
+	if (!bPhaseStarted)
+	{
+		return;
+	}
+
+	if (Phase == EPhase::Walk && Character->GetLocomotionAction() == AlsLocomotionActionTags::Ragdolling)
+	{
+		Character->TryStopRagdolling();
+	}
+
+	Character->SetDesiredStance(Phase == EPhase::Crouch ? AlsStanceTags::Crouching : AlsStanceTags::Standing);
+
+	switch (Phase)
+	{
+		case EPhase::Walk:
+			Character->SetDesiredGait(AlsGaitTags::Walking);
+			break;
+
+		case EPhase::Run:
+			Character->SetDesiredGait(AlsGaitTags::Running);
+			break;
+
+		case EPhase::Sprint:
+			Character->SetDesiredGait(AlsGaitTags::Sprinting);
+			break;
+
+		case EPhase::Jump:
+			Character->Jump();
+			break;
+
+		case EPhase::Mantle:
+			PlaceMantlingObstacle(Character, CharacterIndex, MovementYawAngle);
+			Character->TryStartMantlingGrounded();
+			break;
+
+		case EPhase::Roll:
+			Character->TryStartRolling(1.3f);
+			break;
+
+		case EPhase::Ragdoll:
+			Character->StartRagdolling();
+			break;
+
+		default:
+			break;
+	}
+}
+
+void UAlsCrowdBenchmarkSubsystem::PlaceMantlingObstacle(const AAlsCharacter* Character, const int32 CharacterIndex,
+                                                        const float MovementYawAngle) const
+{
+	using namespace AlsCrowdBenchmarkSubsystem;
+
+	auto* Obstacle{MantlingObstacles.IsValidIndex(CharacterIndex) ? MantlingObstacles[CharacterIndex].Get() : nullptr};
+	if (!IsValid(Obstacle))
+	{
+		return;
+	}
+
+	// The obstacle stands on the floor right in front of the character, facing the movement direction, so that it's
+	// within the reach of the grounded mantling trace. Mantling doesn't start if the character isn't on the floor.
+
+	const FRotator Rotation{0.0f, MovementYawAngle, 0.0f};
+
+	auto Location{
+		Character->GetActorLocation() + Rotation.Vector() *
+		(Character->GetCapsuleComponent()->GetScaledCapsuleRadius() + MantlingObstacleDistance + MantlingObstacleExtent.X)
+	};
+
+	Location.Z = MantlingObstacleExtent.Z;
+
+	Obstacle->SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+}
+
+void UAlsCrowdBenchmarkSubsystem::WriteResults() const
+{
+	const auto Duration{FPlatformTime::Seconds() - StartTime};
+	const auto Timers{FAlsBenchmark::GetTimers()};
+
+	TStringBuilder<2048> Json;
+	TStringBuilder<1024> Csv;
+
+	Json.Appendf(TEXT("{\n\t\"Characters\": %d,\n\t\"SpectatorCameras\": %d,\n\t\"Frames\": %d,\n\t\"DurationSeconds\": %.3f,\n\t\"Timers\": [\n"),
+	             Characters.Num(), SpectatorCameras.Num(), FramesCount, Duration);
+
+	Csv << TEXTVIEW("Timer,Calls,TotalMs,MsPerFrame,UsPerCall\n");
+
+	for (auto i{0}; i < Timers.Num(); i++)
+	{
+		const auto* Timer{Timers[i]};
+
+		const auto Calls{Timer->Calls.load(std::memory_order_relaxed)};
+		const auto Milliseconds{Timer->GetMilliseconds()};
+		const auto MillisecondsPerFrame{Milliseconds / FramesCount};
+		const auto MicrosecondsPerCall{Calls > 0 ? Milliseconds * 1000.0 / Calls : 0.0};
+
+		Json.Appendf(TEXT("\t\t{\"Name\": \"%s\", \"Calls\": %u, \"TotalMs\": %.4f, \"MsPerFrame\": %.4f, \"UsPerCall\": %.4f}%s\n"),
+		             Timer->Name, Calls, Milliseconds, MillisecondsPerFrame, MicrosecondsPerCall, i < Timers.Num() - 1 ? TEXT(",") : TEXT(""));
+
+		Csv.Appendf(TEXT("%s,%u,%.4f,%.4f,%.4f\n"), Timer->Name, Calls, Milliseconds, MillisecondsPerFrame, MicrosecondsPerCall);
+
+		UE_LOG(LogAls, Display, TEXT("%hs: %s: %u calls, %.4f ms per frame, %.4f us per call."),
+		       __FUNCTION__, Timer->Name, Calls, MillisecondsPerFrame, MicrosecondsPerCall);
+	}
+
+	Json << TEXTVIEW("\t]\n}\n");
+
+	const auto BasePath{
+		FPaths::Combine(FPaths::ProfilingDir(), TEXT("Als"),
+		                FString::Printf(TEXT("CrowdBenchmark-%s"), *FDateTime::Now().ToString()))
+	};
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(BasePath), true);
+
+	FFileHelper::SaveStringToFile(Json.ToView(), *(BasePath + TEXT(".json")));
+	FFileHelper::SaveStringToFile(Csv.ToView(), *(BasePath + TEXT(".csv")));
+
+	UE_LOG(LogAls, Log, TEXT("%hs: Crowd benchmark results saved to %s.json and .csv."), __FUNCTION__, *BasePath);
+}
+
+void UAlsCrowdBenchmarkSubsystem::DestroyCharacters()
+{
+	for (const auto& Character : Characters)
+	{
+		if (IsValid(Character))
+		{
+			if (IsValid(Character->GetController()))
+			{
+				Character->GetController()->Destroy();
+			}
+
+			Character->Destroy();
+		}
+	}
+
+	Characters.Reset();
+	SpectatorCameras.Reset();
+}
+
+void UAlsCrowdBenchmarkSubsystem::DestroyEnvironment()
+{
+	for (const auto& Obstacle : MantlingObstacles)
+	{
+		if (IsValid(Obstacle))
+		{
+			Obstacle->Destroy();
+		}
+	}
+
+	MantlingObstacles.Reset();
+
+	if (IsValid(Floor))
+	{
+		Floor->Destroy();
+	}
+
+	Floor = nullptr;
+}
@@ -0,0 +1,140 @@
+#include "AlsCharacter.h"
+#include "AlsCrowdBenchmarkSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeExit.h"
+#include "Utility/AlsBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AlsCrowdBenchmarkTest
+{
+	static const TCHAR* CrowdTestName{TEXT("Crowd")};
+	static const TCHAR* SpectatorCamerasTestName{TEXT("SpectatorCameras")};
+
+	static constexpr auto DefaultCharactersCount{50};
+	static constexpr auto DefaultSpectatorCamerasCount{8};
+	static constexpr auto DefaultFramesCount{600};
+
+	static constexpr auto DeltaTime{1.0f / 30.0f};
+
+	// Creates a game world without loading a map, so that the benchmark doesn't depend on any level or player.
+	UWorld* CreateWorld()
+	{
+		auto* World{UWorld::CreateWorld(EWorldType::Game, false, TEXT("AlsCrowdBenchmark"))};
+
+		auto& WorldContext{GEngine->CreateNewWorldContext(EWorldType::Game)};
+		WorldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL{});
+
+		// The world has no game mode that would start play, so begin play is dispatched directly.
+
+		World->GetWorldSettings()->NotifyBeginPlay();
+
+		return World;
+	}
+
+	void DestroyWorld(UWorld* World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FAlsCrowdBenchmarkTest, "ALS.Benchmark.Crowd",
+                                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                  EAutomationTestFlags::PerfFilter)
+
+void FAlsCrowdBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	OutBeautifiedNames.Add(AlsCrowdBenchmarkTest::CrowdTestName);
+	OutTestCommands.Add(AlsCrowdBenchmarkTest::CrowdTestName);
+
+	OutBeautifiedNames.Add(AlsCrowdBenchmarkTest::SpectatorCamerasTestName);
+	OutTestCommands.Add(AlsCrowdBenchmarkTest::SpectatorCamerasTestName);
+}
+
+bool FAlsCrowdBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// Spawns the crowd in a new game world, ticks the world for a fixed number of frames with a fixed delta time and checks
+	// that the ALS hot paths were measured. The results are written by the crowd benchmark subsystem when the run finishes.
+	// The crowd can be configured on the command line with -AlsBenchmarkCharacters=, -AlsBenchmarkFrames= and -AlsBenchmarkCharacterClass=.
+
+	const auto bTickSpectatorCameras{Parameters == AlsCrowdBenchmarkTest::SpectatorCamerasTestName};
+
+	auto CharactersCount{
+		bTickSpectatorCameras ? AlsCrowdBenchmarkTest::DefaultSpectatorCamerasCount : AlsCrowdBenchmarkTest::DefaultCharactersCount
+	};
+
+	auto FramesCount{AlsCrowdBenchmarkTest::DefaultFramesCount};
+	FString CharacterClassPath{UAlsCrowdBenchmarkSubsystem::DefaultCharacterClassPath};
+
+	FParse::Value(FCommandLine::Get(), TEXT("AlsBenchmarkCharacters="), CharactersCount);
+	FParse::Value(FCommandLine::Get(), TEXT("AlsBenchmarkFrames="), FramesCount);
+	FParse::Value(FCommandLine::Get(), TEXT("AlsBenchmarkCharacterClass="), CharacterClassPath);
+
+	const TSubclassOf<AAlsCharacter> CharacterClass{LoadClass<AAlsCharacter>(nullptr, *CharacterClassPath)};
+
+	if (!TestNotNull(TEXT("Character class"), CharacterClass.Get()) ||
+	    !TestTrue(TEXT("Characters count"), CharactersCount > 0) || !TestTrue(TEXT("Frames count"), FramesCount > 0))
+	{
+		return false;
+	}
+
+	auto* World{AlsCrowdBenchmarkTest::CreateWorld()};
+
+	ON_SCOPE_EXIT
+	{
+		AlsCrowdBenchmarkTest::DestroyWorld(World);
+	};
+
+	auto* Subsystem{World->GetSubsystem<UAlsCrowdBenchmarkSubsystem>()};
+	if (!TestNotNull(TEXT("Crowd benchmark subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	Subsystem->Start(CharacterClass, CharactersCount, FramesCount, bTickSpectatorCameras);
+
+	if (!TestTrue(TEXT("Benchmark started"), Subsystem->IsRunning()))
+	{
+		return false;
+	}
+
+	// Action assets, such as mantling montages, are loaded asynchronously when characters are spawned, and the
+	// engine loop that would otherwise finish these loads is not running, so they are finished before the first frame.
+
+	FlushAsyncLoading();
+
+	// The subsystem ticks with the world and stops itself after the last frame, so one
+	// additional frame is ticked to let it write the results. The limit is just a safeguard.
+
+	for (auto FrameIndex{0}; FrameIndex <= FramesCount && Subsystem->IsRunning(); FrameIndex++)
+	{
+		World->Tick(LEVELTICK_All, AlsCrowdBenchmarkTest::DeltaTime);
+
+		// The engine loop is not running, so the frame counter is advanced manually.
+
+		GFrameCounter += 1;
+	}
+
+	TestFalse(TEXT("Benchmark finished"), Subsystem->IsRunning());
+
+	TestTrue(TEXT("AAlsCharacter::Tick measured"), FAlsBenchmark::CharacterTick.Calls.load() > 0);
+	TestTrue(TEXT("NativeUpdateAnimation measured"), FAlsBenchmark::NativeUpdateAnimation.Calls.load() > 0);
+	TestTrue(TEXT("NativeThreadSafeUpdateAnimation measured"), FAlsBenchmark::NativeThreadSafeUpdateAnimation.Calls.load() > 0);
+
+	if (bTickSpectatorCameras)
+	{
+		TestTrue(TEXT("TickCamerasParallel measured"), FAlsBenchmark::CameraBatchTick.Calls.load() > 0);
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif
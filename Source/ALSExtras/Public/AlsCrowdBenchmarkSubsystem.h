@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsCrowdBenchmarkSubsystem.generated.h"
+
+class AAlsCharacter;
+class AStaticMeshActor;
+class UAlsCameraComponent;
+
+// Spawns a crowd of ALS characters driven by scripted inputs that cycle through walking, running, sprinting, crouching,
+// jumping, mantling, rolling and ragdolling, ticks it for a fixed number of frames and writes the time spent in the ALS
+// hot paths to JSON and CSV files in the profiling directory. Run by the ALS.Benchmark.Crowd automation test, which
+// creates its own game world, or started in an already running game with the als.Benchmark.Crowd console command.
+//
+// The crowd is spawned on its own floor, and an obstacle is placed in front of each character when the mantling phase starts.
+// Other ALS characters in the world, such as the player, are paused for the duration of the benchmark, since the timers are
+// global and would otherwise include them.
+//
+// Example of a headless run on a build agent:
+// UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests ALS.Benchmark.Crowd; Quit" -AlsBenchmarkCharacters=100 -AlsBenchmarkFrames=900
+//
+// The ALS.Benchmark.Crowd.SpectatorCameras automation test and the als.Benchmark.SpectatorCameras console command run the same
+// benchmark as a stress test of parallel camera ticking: the cameras of all spawned characters are activated as spectator
+// cameras and ticked together by UAlsCameraComponent::TickCamerasParallel().
+UCLASS()
+class ALSEXTRAS_API UAlsCrowdBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AAlsCharacter>> Characters;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAlsCameraComponent>> SpectatorCameras;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AStaticMeshActor> Floor;
+
+	// Indices match the indices of the characters.
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AStaticMeshActor>> MantlingObstacles;
+
+	TArray<TWeakObjectPtr<AActor>> PausedActors;
+
+	TArray<TWeakObjectPtr<UActorComponent>> PausedComponents;
+
+	TArray<TWeakObjectPtr<UAlsCameraComponent>> PausedCameras;
+
+	int32 FramesCount{0};
+
+	int32 FrameIndex{0};
+
+	double StartTime{0.0};
+
+public:
+	// Character class used when no other class is specified.
+	static const TCHAR* DefaultCharacterClassPath;
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual bool IsTickable() const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	bool IsRunning() const;
+
+	void Start(TSubclassOf<AAlsCharacter> CharacterClass, int32 CharactersCount, int32 NewFramesCount, bool bTickSpectatorCameras = false);
+
+	void Stop();
+
+private:
+	void PauseOtherCharacters();
+
+	void ResumeOtherCharacters();
+
+	void SpawnEnvironment(int32 GridSize);
+
+	void RefreshInputs(AAlsCharacter* Character, int32 CharacterIndex) const;
+
+	void PlaceMantlingObstacle(const AAlsCharacter* Character, int32 CharacterIndex, float MovementYawAngle) const;
+
+	void WriteResults() const;
+
+	void DestroyCharacters();
+
+	void DestroyEnvironment();
+};